@@ -36,6 +36,14 @@ void tone_gen(uint32_t freq, uint32_t duration) {
 #endif
 }
 
+/* 不管 tone_gen() 停在哪裡，直接把 buzzer 關掉 */
+void tone_stop(void) {
+#ifdef BUZZER_SUPPORT
+  if (!pwm_is_ready_dt(&buzzer)) return;
+  pwm_set_dt(&buzzer, buzzer.period, 0);
+#endif
+}
+
 void tone_powerup(void) {
   tone_gen(262 * 10, 200);
   tone_gen(330 * 10, 200);
@@ -16,6 +16,7 @@ static const struct pwm_dt_spec buzzer = PWM_DT_SPEC_GET(DT_ALIAS(pwmbuzzer));
 static volatile bool ready_flag;
 
 void tone_gen(uint32_t freq, uint32_t duration);
+void tone_stop(void);
 void tone_powerup(void);
 void tone_pn7150_detected(void);
 void tone_pn7150_remove(void);
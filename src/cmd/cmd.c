@@ -15,6 +15,9 @@ LOG_MODULE_REGISTER(cmd);
 /* Prevent UWB API from declaring its own LOG module in this file */
 #define UWB_API_MAIN_FILE
 #include "AppInternal.h"
+#include "Nfc.h"
+#include "UWBIOT_APP_BUILD.h"
+#include "UwbAdaptation.h"
 #include "demo_test_rx.h"
 #include "demo_test_rx_sem.h"
 #include "demo_test_tx.h"
@@ -25,7 +28,16 @@ LOG_MODULE_REGISTER(cmd);
 #include "em4095.h"
 #include "em4095_sem.h"
 #include "nfc_thread.h"
+#include "phNxpUciHal_Adaptation.h"
+#include "phNxpUciHal_Trace.h"
+#include "phOsalUwb.h"
+#include "phTmlUwb.h"
 #include "radio_sem.h"
+#include "tml.h"
+#include "uwb_uwbs_tml_interface.h"
+#ifdef UWBIOT_APP_BUILD__DEMO_NEARBY_INTERACTION
+#include "TLV_Types_i.h"
+#endif
 
 /* PCA9955B I2C 地址 (AD0-AD2 都接地 = 0x40) */
 #define PCA9955B_I2C_ADDR 0x40
@@ -367,13 +379,51 @@ static int cmd_pn7160_test(const struct shell* sh, size_t argc, char** argv) {
 
     } else if (strcmp(argv[0], "stop") == 0) {
         nfc_run_flag = false;
+        /* 卡片還在場時 presence check 不用等到移除才結束 */
+        NxpNci_AbortPresenceCheck();
         shell_print(sh, "[PN7150] Stopping...");
         return 0;
+    } else if (strcmp(argv[0], "stats") == 0) {
+        tml_rtt_stats_t rtt;
+        NxpNci_ReadStats_t rd;
+
+        if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+            tml_ResetRttStats();
+            NxpNci_ResetReadStats();
+            shell_print(sh, "NCI RTT statistics cleared");
+            return 0;
+        }
+        tml_GetRttStats(&rtt);
+        shell_print(sh, "NCI round trips : %u (timeouts %u)", rtt.count,
+                    rtt.timeouts);
+        if (rtt.count != 0) {
+            shell_print(sh, "  RTT us        : min %u avg %u max %u",
+                        rtt.min_us, (uint32_t)(rtt.total_us / rtt.count),
+                        rtt.max_us);
+        }
+        NxpNci_GetReadStats(&rd);
+        shell_print(sh, "NDEF reads      : %u", rd.count);
+        if (rd.count != 0) {
+            shell_print(sh, "  read us       : min %u avg %u max %u",
+                        rd.min_us, (uint32_t)(rd.total_us / rd.count),
+                        rd.max_us);
+            shell_print(sh, "  last          : %u us, %u cmds%s", rd.last_us,
+                        rd.last_exchanges,
+                        rd.last_fast_read ? " (FAST_READ)" : "");
+            shell_print(sh, "  last rx       : %u bytes, %u B/s",
+                        rd.last_bytes,
+                        (rd.last_us != 0)
+                            ? (uint32_t)(((uint64_t)rd.last_bytes *
+                                          1000000U) / rd.last_us)
+                            : 0);
+        }
+        return 0;
     } else {
         shell_error(sh, "Usage: pn7160_test <cmd>");
         shell_print(sh, "Commands:");
         shell_print(sh, "  start          - Start PN7160 test");
         shell_print(sh, "  stop          - Stop PN7160 test");
+        shell_print(sh, "  stats [reset]  - Show NCI latency and NDEF read time");
         return -EINVAL;
     }
 }
@@ -382,6 +432,9 @@ static int cmd_pn7160_test(const struct shell* sh, size_t argc, char** argv) {
 static struct k_thread dtm_thread_data;
 static K_THREAD_STACK_DEFINE(dtm_thread_stack, 2048);
 static const struct shell* dtm_shell_ptr = NULL;
+/* transport thread 處理一個 2-wire 指令時持有；plan 執行期間整段持有，
+ * tester 在 plan 期間送來的指令等 plan 結束才處理，不會跟 plan 搶 dtm_inst */
+static K_SEM_DEFINE(dtm_cmd_lock, 1, 1);
 
 static void dtm_thread_entry(void* p1, void* p2, void* p3) {
     ARG_UNUSED(p1);
@@ -418,7 +471,9 @@ static void dtm_thread_entry(void* p1, void* p2, void* p3) {
 
     for (;;) {
         cmd = dtm_tr_get();
+        k_sem_take(&dtm_cmd_lock, K_FOREVER);
         err = dtm_tr_process(cmd);
+        k_sem_give(&dtm_cmd_lock);
         if (err) {
             if (sh != NULL) {
                 shell_print(sh, "Error processing command: %d\n", err);
@@ -426,10 +481,231 @@ static void dtm_thread_entry(void* p1, void* p2, void* p3) {
             }
             /* Continue processing instead of returning to allow recovery */
         }
-        k_msleep(10);
     }
 }
 
+/* dtm_test plan：一次上傳整個測試計畫，由 plan thread 在板子上依序執行，
+ * shell 不會被卡住，可以用 "dtm_test plan stop" 中途停止。 */
+#define DTM_PLAN_MAX_STEPS 120
+/* 整個 plan 的時間上限 */
+#define DTM_PLAN_MAX_MS (10U * 60U * 1000U)
+/* stop 時每隔多久重送一次 abort，以及最多等多久 */
+#define DTM_PLAN_STOP_POLL_MS 100
+#define DTM_PLAN_STOP_TIMEOUT_MS 2000
+
+static struct dtm_plan_step dtm_plan_steps[DTM_PLAN_MAX_STEPS];
+static struct dtm_plan_result dtm_plan_results[DTM_PLAN_MAX_STEPS];
+static size_t dtm_plan_count;
+
+/* plan thread；dtm_plan_sem 為 0 表示 plan 正在跑，steps/results 不能動 */
+static struct k_thread dtm_plan_thread_data;
+static K_THREAD_STACK_DEFINE(dtm_plan_thread_stack, 2048);
+static K_SEM_DEFINE(dtm_plan_sem, 1, 1);
+static const struct shell* dtm_plan_shell_ptr = NULL;
+
+/* 解析 "mode:ch[-last[/inc]]:phy:dBm:len:ms"，展開 channel sweep */
+static int dtm_plan_parse(const char* arg, struct dtm_plan_step* steps,
+                          size_t max) {
+    static const char* const phys[] = {"1m", "2m", "s8", "s2"};
+    static const char* const modes[] = {"tx", "rx", "cw"};
+    char buf[48];
+    char* field[6];
+    char* save = NULL;
+    char* end;
+    struct dtm_plan_step step = {.pkt = DTM_PACKET_PRBS9};
+    long first, last, inc = 1, val;
+    size_t n = 0;
+    size_t i;
+
+    if (strlen(arg) >= sizeof(buf)) {
+        return -EINVAL;
+    }
+    strcpy(buf, arg);
+    for (i = 0; i < ARRAY_SIZE(field); i++) {
+        field[i] = strtok_r((i == 0) ? buf : NULL, ":", &save);
+        if (field[i] == NULL) {
+            return -EINVAL;
+        }
+    }
+
+    for (i = 0; i < ARRAY_SIZE(modes); i++) {
+        if (strcmp(field[0], modes[i]) == 0) {
+            step.mode = (enum dtm_plan_mode)i;
+            break;
+        }
+    }
+    if (i == ARRAY_SIZE(modes)) {
+        return -EINVAL;
+    }
+
+    first = strtol(field[1], &end, 0);
+    last = first;
+    if (*end == '-') {
+        last = strtol(end + 1, &end, 0);
+    }
+    if (*end == '/') {
+        inc = strtol(end + 1, &end, 0);
+    }
+    if ((*end != '\0') || (first < 0) || (last > 39) || (first > last) ||
+        (inc <= 0)) {
+        return -EINVAL;
+    }
+
+    for (i = 0; i < ARRAY_SIZE(phys); i++) {
+        if (strcmp(field[2], phys[i]) == 0) {
+            step.phy = (enum dtm_phy)i;
+            break;
+        }
+    }
+    if (i == ARRAY_SIZE(phys)) {
+        return -EINVAL;
+    }
+
+    val = strtol(field[3], &end, 0);
+    if ((*end != '\0') || (val < INT8_MIN) || (val > INT8_MAX)) {
+        return -EINVAL;
+    }
+    step.tx_power = (int8_t)val;
+
+    val = strtol(field[4], &end, 0);
+    if ((*end != '\0') || (val < 0) || (val > 255)) {
+        return -EINVAL;
+    }
+    step.length = (uint8_t)val;
+
+    val = strtol(field[5], &end, 0);
+    if ((*end != '\0') || (val <= 0) || (val > UINT16_MAX)) {
+        return -EINVAL;
+    }
+    step.duration_ms = (uint16_t)val;
+
+    for (long ch = first; ch <= last; ch += inc) {
+        if (n == max) {
+            return -ENOMEM;
+        }
+        step.channel = (uint8_t)ch;
+        steps[n++] = step;
+    }
+    return (int)n;
+}
+
+static void dtm_plan_thread_entry(void* p1, void* p2, void* p3) {
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    static const char* const modes[] = {"tx", "rx", "cw"};
+    static const char* const phys[] = {"1m", "2m", "s8", "s2"};
+    const struct shell* sh = dtm_plan_shell_ptr;
+    int64_t start;
+    int ret;
+
+    k_sem_take(&dtm_cmd_lock, K_FOREVER);
+    start = k_uptime_get();
+    ret = dtm_plan_run(dtm_plan_steps, dtm_plan_count, dtm_plan_results);
+    k_sem_give(&dtm_cmd_lock);
+
+    if (sh == NULL) {
+        k_sem_give(&dtm_plan_sem);
+        return;
+    }
+    if (ret < 0) {
+        shell_error(sh, "DTM plan failed: %d", ret);
+        k_sem_give(&dtm_plan_sem);
+        return;
+    }
+
+    shell_print(sh, "step mode ch phy dBm len      us packets err");
+    for (size_t i = 0; i < (size_t)ret; i++) {
+        const struct dtm_plan_step* st = &dtm_plan_steps[i];
+        const struct dtm_plan_result* res = &dtm_plan_results[i];
+
+        shell_print(sh, "%4u %-4s %2u %-3s %3d %3u %7u %7u %d", (uint32_t)i,
+                    modes[st->mode], st->channel, phys[st->phy],
+                    res->tx_power, st->length, res->elapsed_us, res->packets,
+                    res->err);
+    }
+    if ((size_t)ret < dtm_plan_count) {
+        shell_warn(sh, "Plan stopped after %d of %u steps", ret,
+                   (uint32_t)dtm_plan_count);
+    }
+    shell_print(sh, "Plan done in %u ms",
+                (uint32_t)(k_uptime_get() - start));
+    k_sem_give(&dtm_plan_sem);
+}
+
+/* 叫 plan thread 結束目前的 step 並等它離開。plan thread 還沒進
+ * dtm_plan_run() 時送的 abort 會被清掉，所以每次等待逾時就重送 */
+static int dtm_plan_stop(void) {
+    for (int waited = 0; waited < DTM_PLAN_STOP_TIMEOUT_MS;
+         waited += DTM_PLAN_STOP_POLL_MS) {
+        dtm_plan_abort();
+        if (k_thread_join(&dtm_plan_thread_data,
+                          K_MSEC(DTM_PLAN_STOP_POLL_MS)) == 0) {
+            return 0;
+        }
+    }
+    return -ETIMEDOUT;
+}
+
+static int dtm_plan_cmd(const struct shell* sh, size_t argc, char** argv) {
+    uint32_t total_ms = 0;
+    size_t count = 0;
+    int ret;
+
+    if ((argc == 2) && (strcmp(argv[1], "stop") == 0)) {
+        if (k_sem_count_get(&dtm_plan_sem) != 0) {
+            shell_warn(sh, "No DTM plan is running");
+            return 0;
+        }
+        ret = dtm_plan_stop();
+        if (ret) {
+            shell_error(sh, "DTM plan did not stop: %d", ret);
+        }
+        return ret;
+    }
+
+    if (k_sem_count_get(&dtm_sem) != 0) {
+        shell_error(sh, "DTM is not running, run dtm_test start first");
+        return -EACCES;
+    }
+
+    if (k_sem_take(&dtm_plan_sem, K_NO_WAIT) != 0) {
+        shell_error(sh, "A DTM plan is already running");
+        return -EBUSY;
+    }
+
+    for (size_t i = 1; i < argc; i++) {
+        ret = dtm_plan_parse(argv[i], &dtm_plan_steps[count],
+                             ARRAY_SIZE(dtm_plan_steps) - count);
+        if (ret < 0) {
+            shell_error(sh, "Bad plan step '%s' (%d)", argv[i], ret);
+            k_sem_give(&dtm_plan_sem);
+            return ret;
+        }
+        count += ret;
+    }
+    for (size_t i = 0; i < count; i++) {
+        total_ms += dtm_plan_steps[i].duration_ms;
+    }
+    if (total_ms > DTM_PLAN_MAX_MS) {
+        shell_error(sh, "Plan takes %u ms, limit is %u ms", total_ms,
+                    DTM_PLAN_MAX_MS);
+        k_sem_give(&dtm_plan_sem);
+        return -E2BIG;
+    }
+
+    shell_print(sh, "Running %u steps, %u ms", (uint32_t)count, total_ms);
+    dtm_plan_count = count;
+    dtm_plan_shell_ptr = sh;
+    k_thread_create(&dtm_plan_thread_data, dtm_plan_thread_stack,
+                    K_THREAD_STACK_SIZEOF(dtm_plan_thread_stack),
+                    dtm_plan_thread_entry, NULL, NULL, NULL,
+                    K_PRIO_PREEMPT(7), 0, K_NO_WAIT);
+    k_thread_name_set(&dtm_plan_thread_data, "dtm_plan");
+    return 0;
+}
+
 static int cmd_dtm_test(const struct shell* sh, size_t argc, char** argv) {
     if (strcmp(argv[0], "start") == 0) {
         if (k_sem_count_get(&uwb_test_tx) == 0) {
@@ -454,6 +730,15 @@ static int cmd_dtm_test(const struct shell* sh, size_t argc, char** argv) {
             return 0;
         }
 
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) && !defined(CONFIG_DTM_TRANSPORT_HCI)
+        /* DTM 接收改由 UART RX 中斷處理，會接管該 UART 的 callback */
+        if (((struct shell_uart_common*)sh->iface->ctx)->dev ==
+            DEVICE_DT_GET(DT_CHOSEN(ncs_dtm_uart))) {
+            shell_error(sh, "Shell is on the DTM UART, run switch_uart first");
+            return 0;
+        }
+#endif
+
         if (k_sem_take(&dtm_sem, K_NO_WAIT) != 0) {
             shell_error(sh, "DTM transport thread already running.");
             return 0;
@@ -472,6 +757,8 @@ static int cmd_dtm_test(const struct shell* sh, size_t argc, char** argv) {
                         dtm_thread_entry, NULL, NULL, NULL, K_PRIO_COOP(7), 0,
                         K_NO_WAIT);
         k_thread_name_set(&dtm_thread_data, "dtm_transport");
+    } else if (strcmp(argv[0], "plan") == 0) {
+        return dtm_plan_cmd(sh, argc, argv);
     } else if (strcmp(argv[0], "stop") == 0) {
         if (k_sem_count_get(&dtm_sem) != 0) {
             shell_warn(sh, "DTM transport thread is not running");
@@ -480,6 +767,15 @@ static int cmd_dtm_test(const struct shell* sh, size_t argc, char** argv) {
 
         shell_print(sh, "Stopping DTM transport...");
 
+        /* plan 要先停，dtm_stop() 之後不能再動 radio */
+        if (k_sem_count_get(&dtm_plan_sem) == 0) {
+            if (dtm_plan_stop() != 0) {
+                shell_warn(sh, "DTM plan did not stop, aborting it");
+                k_thread_abort(&dtm_plan_thread_data);
+                k_sem_give(&dtm_plan_sem);
+            }
+        }
+
         /* Stop DTM */
         int err = dtm_stop();
         if (err) {
@@ -492,7 +788,9 @@ static int cmd_dtm_test(const struct shell* sh, size_t argc, char** argv) {
         /* Wait a bit for thread to finish */
         k_msleep(100);
 
-        /* Reset thread state */
+        /* Reset thread state; 被 abort 的 thread 可能還持有 dtm_cmd_lock，
+         * limit 是 1，多 give 一次沒關係 */
+        k_sem_give(&dtm_cmd_lock);
         k_sem_give(&dtm_sem);
         dtm_shell_ptr = NULL;
 
@@ -513,6 +811,58 @@ static struct k_thread em4095_thread_data;
 static K_THREAD_STACK_DEFINE(em4095_thread_stack, 2048);
 static const struct shell* em4095_shell_ptr = NULL;
 
+/* EM4095 card event thread: console 與 buzzer 都在這裡，reader 不會被卡住 */
+static struct k_thread em4095_event_thread_data;
+static K_THREAD_STACK_DEFINE(em4095_event_thread_stack, 1024);
+
+/* reader 每個採樣視窗 (最多 130ms) 檢查一次 */
+static volatile bool em4095_stop_requested;
+/* 放進 em4095_card_msgq 叫 consumer 結束的事件 */
+#define EM4095_EVENT_STOP 0xFF
+/* reader 收完一個視窗、consumer 響完 buzzer 所需的最長時間 */
+#define EM4095_STOP_TIMEOUT_MS 500
+
+/* 等 consumer 處理完手上的事件再結束，不會停在 buzzer 響到一半或
+ * console 印到一半；呼叫前 reader 必須已經停止 */
+static void em4095_event_thread_stop(void) {
+    const em4095_card_event_t stop = {.type = EM4095_EVENT_STOP};
+
+    k_msgq_purge(&em4095_card_msgq);
+    (void)k_msgq_put(&em4095_card_msgq, &stop, K_NO_WAIT);
+    if (k_thread_join(&em4095_event_thread_data,
+                      K_MSEC(EM4095_STOP_TIMEOUT_MS)) != 0) {
+        k_thread_abort(&em4095_event_thread_data);
+    }
+    tone_stop();
+}
+
+static void em4095_event_thread_entry(void* p1, void* p2, void* p3) {
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    em4095_card_event_t event;
+
+    for (;;) {
+        k_msgq_get(&em4095_card_msgq, &event, K_FOREVER);
+        if (event.type == EM4095_EVENT_STOP) {
+            return;
+        }
+        if (event.type == EM4095_CARD_HID) {
+            NRF_LOG_INFO("[em4095] HID(%d bits) Card NO: (%u)", event.bits,
+                         (uint32_t)event.code);
+            if (event.bits == 26) {
+                tone_em4095_detected();
+            }
+        } else {
+            /* 保留最後 32 bits，過濾掉前面的 Customer ID */
+            NRF_LOG_INFO("[em4095] Card Found: (%010llu)",
+                         (unsigned long long)(event.code & 0xFFFFFFFF));
+            tone_em4095_detected();
+        }
+    }
+}
+
 static void em4095_thread_entry(void* p1, void* p2, void* p3) {
     ARG_UNUSED(p1);
     ARG_UNUSED(p2);
@@ -527,6 +877,7 @@ static void em4095_thread_entry(void* p1, void* p2, void* p3) {
         if (sh != NULL) {
             shell_error(sh, "Failed to initialize EM4095 GPIO: %d", err);
         }
+        em4095_event_thread_stop();
         k_sem_give(&em4095_sem);
         return;
     }
@@ -537,12 +888,15 @@ static void em4095_thread_entry(void* p1, void* p2, void* p3) {
         if (sh != NULL) {
             shell_error(sh, "Failed to enable EM4095: %d", err);
         }
+        em4095_event_thread_stop();
         k_sem_give(&em4095_sem);
         return;
     }
 
-    /* Main loop - only execute if initialization succeeded */
-    for (;;) {
+    /* Main loop - only execute if initialization succeeded.
+     * 每個採樣視窗都睡在 semaphore 上等 TIMER3/PPI 收完，CPU 留給
+     * shell、NFC、UWB */
+    while (!em4095_stop_requested) {
         em4095_receiver();
         k_msleep(10);
     }
@@ -581,12 +935,21 @@ static int cmd_em4095_test(const struct shell* sh, size_t argc, char** argv) {
 
         /* Save shell pointer for thread */
         em4095_shell_ptr = sh;
+        em4095_stop_requested = false;
+
+        /* Start card event consumer before the reader */
+        k_msgq_purge(&em4095_card_msgq);
+        k_thread_create(&em4095_event_thread_data, em4095_event_thread_stack,
+                        K_THREAD_STACK_SIZEOF(em4095_event_thread_stack),
+                        em4095_event_thread_entry, NULL, NULL, NULL,
+                        K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+        k_thread_name_set(&em4095_event_thread_data, "em4095_card_event");
 
         /* Start EM4095 thread */
         k_thread_create(&em4095_thread_data, em4095_thread_stack,
                         K_THREAD_STACK_SIZEOF(em4095_thread_stack),
-                        em4095_thread_entry, NULL, NULL, NULL, K_PRIO_COOP(7),
-                        0, K_NO_WAIT);
+                        em4095_thread_entry, NULL, NULL, NULL,
+                        K_PRIO_PREEMPT(7), 0, K_NO_WAIT);
         k_thread_name_set(&em4095_thread_data, "em4095_card_reader");
     } else if (strcmp(argv[0], "stop") == 0) {
         /* Check if thread is running */
@@ -595,10 +958,14 @@ static int cmd_em4095_test(const struct shell* sh, size_t argc, char** argv) {
             return 0;
         }
 
-        k_thread_abort(&em4095_thread_data);
-
-        /* Wait a bit for thread to finish */
-        k_msleep(100);
+        /* reader 收完目前的採樣視窗就會離開迴圈 */
+        em4095_stop_requested = true;
+        if (k_thread_join(&em4095_thread_data,
+                          K_MSEC(EM4095_STOP_TIMEOUT_MS)) != 0) {
+            shell_warn(sh, "EM4095 reader did not stop, aborting it");
+            k_thread_abort(&em4095_thread_data);
+        }
+        em4095_event_thread_stop();
 
         /*em4095 sleep mode*/
         em4095_shd_sleep();
@@ -607,11 +974,73 @@ static int cmd_em4095_test(const struct shell* sh, size_t argc, char** argv) {
         em4095_timer3_deinit();
         k_sem_give(&em4095_sem);
         shell_print(sh, "EM4095 Set Sleep mode");
+    } else if (strcmp(argv[0], "stats") == 0) {
+        em4095_stats_t st;
+
+        if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+            em4095_reset_stats();
+            shell_print(sh, "EM4095 statistics cleared");
+            return 0;
+        }
+        em4095_get_stats(&st);
+        shell_print(sh, "capture windows : %u (FSK %u, ASK %u, none %u)",
+                    st.windows, st.fsk, st.ask, st.none);
+        shell_print(sh, "  overruns      : %u", st.overruns);
+        shell_print(sh, "card reads      : HID %u, EM4100 %u", st.hid_reads,
+                    st.em_reads);
+        shell_print(sh, "  queued        : %u (duplicates %u, dropped %u)",
+                    st.hid_reads + st.em_reads - st.duplicates - st.dropped,
+                    st.duplicates, st.dropped);
+        if (st.windows != 0) {
+            shell_print(sh, "  window us     : avg %u",
+                        st.window_us_total / st.windows);
+            shell_print(sh, "  decode us     : avg %u max %u",
+                        st.decode_us_total / st.windows, st.decode_us_max);
+        }
+    } else if (strcmp(argv[0], "bench") == 0) {
+        em4095_replay_t rp;
+        uint32_t iterations = 100;
+
+        /* 重播會讀 tick_buffer，不能和 reader thread 同時跑 */
+        if (k_sem_count_get(&em4095_sem) == 0) {
+            shell_error(sh, "Stop the EM4095 reader first.");
+            return 0;
+        }
+        if (argc > 1) {
+            iterations = strtoul(argv[1], NULL, 0);
+        }
+        if (em4095_replay(iterations, &rp) != 0) {
+            shell_error(sh, "No EM4095 capture to replay");
+            return -ENODATA;
+        }
+        shell_print(sh, "capture         : %u edges, classified %s",
+                    rp.edges,
+                    (rp.modulation == EM4095_MOD_FSK)   ? "FSK"
+                    : (rp.modulation == EM4095_MOD_ASK) ? "ASK"
+                                                        : "none");
+        shell_print(sh, "HID decode      : %u/%u ok, %u cycles (%u us)",
+                    rp.hid_reads, rp.iterations, rp.hid_cycles,
+                    rp.hid_ns / NSEC_PER_USEC);
+        if (rp.hid_reads != 0) {
+            shell_print(sh, "  card          : HID(%u bits) %u",
+                        rp.hid_card.bits, rp.hid_card.card_number);
+        }
+        shell_print(sh, "EM4100 decode   : %u/%u ok, %u cycles (%u us)",
+                    rp.em_reads, rp.iterations, rp.em_cycles,
+                    rp.em_ns / NSEC_PER_USEC);
+        if (rp.em_reads != 0) {
+            shell_print(sh, "  card          : %010llu",
+                        (unsigned long long)(rp.em_code & 0xFFFFFFFF));
+        }
+        shell_print(sh, "classify        : %u cycles (%u us)",
+                    rp.classify_cycles, rp.classify_ns / NSEC_PER_USEC);
     } else {
         shell_error(sh, "Usage: em4095_test <cmd>");
         shell_print(sh, "Commands:");
         shell_print(sh, "  start          - Start PN7160 test");
         shell_print(sh, "  stop          - Stop PN7160 test");
+        shell_print(sh, "  stats [reset]  - Show capture and decode counters");
+        shell_print(sh, "  bench [n]      - Replay the last capture n times");
         return -EINVAL;
     }
     return 0;
@@ -849,6 +1278,284 @@ static int cmd_uwb_rx(const struct shell* sh, size_t argc, char** argv) {
     return 0;
 }
 
+/* uwb_stats cpu 的起點，uwb_stats reset 時重新取樣 */
+static struct {
+    int64_t uptimeMs;
+    uint64_t allCycles;
+    uint64_t idleCycles;
+    uint64_t taskCycles;
+} uwb_cpu_base;
+
+static uint64_t uwb_task_cycles(const phUwbtask_Stats_t* task) {
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+    k_thread_runtime_stats_t rt;
+
+    if ((task->pThread != NULL) &&
+        (k_thread_runtime_stats_get((k_tid_t)task->pThread, &rt) == 0)) {
+        return rt.execution_cycles;
+    }
+#endif
+    return 0;
+}
+
+static void uwb_cpu_snapshot(void) {
+    phUwbtask_Stats_t task;
+
+    uwb_task_get_stats(&task);
+    uwb_cpu_base.uptimeMs = k_uptime_get();
+    uwb_cpu_base.taskCycles = uwb_task_cycles(&task);
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+    k_thread_runtime_stats_t all;
+
+    k_thread_runtime_stats_all_get(&all);
+    uwb_cpu_base.allCycles = all.execution_cycles;
+    uwb_cpu_base.idleCycles = all.idle_cycles;
+#endif
+}
+
+static void uwb_print_latency(const struct shell* sh,
+                              const phOsalUwb_LatencyStats_t* lat) {
+    static const uint32_t bounds[] = PH_OSALUWB_LAT_BUCKETS_US;
+    uint32_t lower = 0;
+
+    if (lat->dwSamples == 0) {
+        return;
+    }
+    shell_print(sh, "  latency us    : min %u / avg %u / max %u", lat->dwMinUs,
+                (uint32_t)(lat->qwTotalUs / lat->dwSamples), lat->dwMaxUs);
+    for (size_t i = 0; i < ARRAY_SIZE(bounds); i++) {
+        shell_print(sh, "  %5u-%5u us : %u", lower, bounds[i],
+                    lat->adwHistogram[i]);
+        lower = bounds[i];
+    }
+    shell_print(sh, "  > %9u us : %u", lower,
+                lat->adwHistogram[ARRAY_SIZE(bounds)]);
+}
+
+static void uwb_print_dispatch(const struct shell* sh, const char* name,
+                               const phOsalUwb_DispatchStats_t* st) {
+    shell_print(sh, "%-16s: %u messages in %u wakeups (max batch %u)", name,
+                st->stLatency.dwSamples, st->dwBatches, st->dwMaxBatch);
+    uwb_print_latency(sh, &st->stLatency);
+}
+
+static int cmd_uwb_stats(const struct shell* sh, size_t argc, char** argv) {
+    if (strcmp(argv[0], "tml") == 0) {
+        uwb_uwbs_tml_tx_stats_t tx;
+
+        uwb_uwbs_tml_get_tx_stats(&tx);
+        shell_print(sh, "UCI TX commands : %u (failed %u)", tx.commands,
+                    tx.failures);
+        if (tx.commands != 0) {
+            shell_print(sh, "  latency us    : min %u / avg %u / max %u",
+                        tx.minLatencyUs,
+                        (uint32_t)(tx.totalLatencyUs / tx.commands),
+                        tx.maxLatencyUs);
+        }
+        shell_print(sh, "  guard wait us : %llu",
+                    (unsigned long long)tx.guardWaitUs);
+        shell_print(sh, "  ready wait us : %llu (max %u, timeouts %u)",
+                    (unsigned long long)tx.readyWaitUs, tx.maxReadyWaitUs,
+                    tx.readyTimeouts);
+    } else if (strcmp(argv[0], "rxring") == 0) {
+        phTmlUwb_RxRingStats_t rx;
+
+        phTmlUwb_GetRxRingStats(&rx);
+        shell_print(sh, "RX ring slots   : %u (in use %u, max %u)", rx.bSlots,
+                    rx.bInUse, rx.bMaxInUse);
+        shell_print(sh, "  delivered     : %u", rx.dwDelivered);
+        shell_print(sh, "  ring full drop: %u", rx.dwRingFullDrops);
+        shell_print(sh, "  post failures : %u", rx.dwPostFailures);
+    } else if (strcmp(argv[0], "irqlat") == 0) {
+        phTmlUwb_IrqLatencyStats_t lat;
+
+        phTmlUwb_GetIrqLatencyStats(&lat);
+        shell_print(sh, "IRQ to callback : %u packets", lat.dwSamples);
+        uwb_print_latency(sh, &lat);
+    } else if (strcmp(argv[0], "mem") == 0) {
+        phOsalUwb_MemStats_t mem[8];
+        uint8_t count = phOsalUwb_GetMemStats(mem, ARRAY_SIZE(mem));
+
+        shell_print(sh, "OSAL memory   : in use / max / blocks, allocs, fail");
+        for (uint8_t i = 0; i < count; i++) {
+            if (mem[i].dwBlockSize == 0) {
+                shell_print(sh, "  heap          : %5u / %5u /   -  , %u, %u",
+                            mem[i].wInUse, mem[i].wMaxInUse, mem[i].dwAllocs,
+                            mem[i].dwFailures);
+            } else {
+                shell_print(sh, "  %4u bytes    : %5u / %5u / %4u, %u, %u",
+                            mem[i].dwBlockSize, mem[i].wInUse,
+                            mem[i].wMaxInUse, mem[i].wBlocks, mem[i].dwAllocs,
+                            mem[i].dwFailures);
+            }
+        }
+    } else if (strcmp(argv[0], "fwdl") == 0) {
+        phNxpUciHal_FwCacheStats_t fw;
+
+        phNxpUciHal_GetFwCacheStats(&fw);
+        shell_print(sh, "FW downloads    : %u (last init %u ms)",
+                    fw.dwDownloads, fw.dwLastFullInitMs);
+        shell_print(sh, "  skipped       : %u (last init %u ms)", fw.dwSkips,
+                    fw.dwLastWarmInitMs);
+        shell_print(sh, "  warm failures : %u", fw.dwWarmFailures);
+        if (fw.dwLastDlMs != 0U) {
+            shell_print(sh, "  last download : %u bytes in %u ms (%u KiB/s)",
+                        fw.dwLastDlBytes, fw.dwLastDlMs,
+                        (uint32_t)((uint64_t)fw.dwLastDlBytes * 1000U /
+                                   1024U / fw.dwLastDlMs));
+        }
+        shell_print(sh, "  time saved ms : %llu",
+                    (unsigned long long)fw.qwSavedMs);
+    } else if (strcmp(argv[0], "sync") == 0) {
+        static const char* const types[] = {"free", "sem", "binsem", "mutex"};
+        static phOsalUwb_SyncObjInfo_t objs[PH_OSALUWB_SYNC_OBJECTS];
+        phOsalUwb_SyncObjStats_t sync;
+        uint16_t count =
+            phOsalUwb_GetSyncObjects(objs, ARRAY_SIZE(objs), &sync);
+
+        shell_print(sh, "OSAL sync objs  : %u / %u (max %u, failed %u)",
+                    sync.wInUse, sync.wCapacity, sync.wMaxInUse,
+                    sync.dwFailures);
+        for (uint16_t i = 0; i < count; i++) {
+            shell_print(sh, "  %-6s %p owner %p [%s]",
+                        (objs[i].bType < ARRAY_SIZE(types))
+                            ? types[objs[i].bType]
+                            : "?",
+                        objs[i].pHandle, objs[i].pOwner, objs[i].acThread);
+        }
+    } else if (strcmp(argv[0], "dispatch") == 0) {
+        phOsalUwb_DispatchStats_t st;
+
+        phNxpUciHal_GetDispatchStats(&st);
+        uwb_print_dispatch(sh, "HAL client", &st);
+#ifdef UWBIOT_APP_BUILD__DEMO_NEARBY_INTERACTION
+        tlvMngGetDispatchStats(&st);
+        uwb_print_dispatch(sh, "TLV manager", &st);
+#endif
+    } else if (strcmp(argv[0], "cpu") == 0) {
+        phUwbtask_Stats_t task;
+        uint32_t windowMs;
+
+        uwb_task_get_stats(&task);
+        windowMs = (uint32_t)(k_uptime_get() - uwb_cpu_base.uptimeMs);
+        shell_print(sh, "Window ms       : %u", windowMs);
+        shell_print(sh, "uwb_task wakeups: %u (%u/s), messages %u, timeouts %u",
+                    task.dwWakeups,
+                    windowMs ? (uint32_t)((uint64_t)task.dwWakeups * 1000U /
+                                          windowMs)
+                             : 0U,
+                    task.dwMessages, task.dwTimerExpiries);
+#if defined(CONFIG_SCHED_THREAD_USAGE_ALL)
+        k_thread_runtime_stats_t all;
+        uint64_t allCycles;
+
+        k_thread_runtime_stats_all_get(&all);
+        allCycles = all.execution_cycles - uwb_cpu_base.allCycles;
+        if (allCycles != 0U) {
+            uint32_t idle = (uint32_t)((all.idle_cycles -
+                                        uwb_cpu_base.idleCycles) *
+                                       1000U / allCycles);
+            uint32_t busy = (uint32_t)((uwb_task_cycles(&task) -
+                                        uwb_cpu_base.taskCycles) *
+                                       1000U / allCycles);
+
+            shell_print(sh, "  CPU idle      : %u.%u %%", idle / 10U,
+                        idle % 10U);
+            shell_print(sh, "  uwb_task CPU  : %u.%u %%", busy / 10U,
+                        busy % 10U);
+        }
+#else
+        shell_print(sh, "  CPU idle      : n/a, needs SCHED_THREAD_USAGE_ALL");
+#endif
+    } else if (strcmp(argv[0], "reset") == 0) {
+        uwb_uwbs_tml_reset_tx_stats();
+        phOsalUwb_ResetMemStats();
+        phTmlUwb_ResetRxRingStats();
+        phTmlUwb_ResetIrqLatencyStats();
+        phNxpUciHal_ResetFwCacheStats();
+        uwb_task_reset_stats();
+        phNxpUciHal_ResetDispatchStats();
+#ifdef UWBIOT_APP_BUILD__DEMO_NEARBY_INTERACTION
+        tlvMngResetDispatchStats();
+#endif
+        uwb_cpu_snapshot();
+        shell_print(sh, "UWB statistics cleared");
+    } else {
+        shell_error(sh, "Usage: uwb_stats <cmd>");
+        shell_print(sh, "Commands:");
+        shell_print(sh, "  tml            - Show UCI TX latency counters");
+        shell_print(sh, "  rxring         - Show TML receive ring counters");
+        shell_print(sh, "  irqlat         - Show UWBS IRQ to callback latency");
+        shell_print(sh, "  mem            - Show OSAL memory pool usage");
+        shell_print(sh, "  fwdl           - Show FW download skip counters");
+        shell_print(sh, "  sync           - List OSAL semaphores and mutexes");
+        shell_print(sh, "  dispatch       - Show HAL thread queueing latency");
+        shell_print(sh, "  cpu            - Show CPU idle and uwb_task load");
+        shell_print(sh, "  reset          - Clear UWB statistics");
+        return -EINVAL;
+    }
+    return 0;
+}
+
+#if defined(CONFIG_UWB_TRACE)
+static int cmd_uwb_trace(const struct shell* sh, size_t argc, char** argv) {
+    if (strcmp(argv[0], "dump") == 0) {
+        uint32_t head = phNxpUciHal_TraceHead();
+        uint32_t seq = phNxpUciHal_TraceFirst();
+        uint32_t skipped = 0;
+        phNxpUciHal_TraceRec_t rec;
+
+        if (argc > 1) {
+            uint32_t count = strtoul(argv[1], NULL, 0);
+
+            if ((head - seq) > count) {
+                seq = head - count;
+            }
+        }
+        for (; seq != head; seq++) {
+            if (phNxpUciHal_TraceRead(seq, &rec)) {
+                phNxpUciHal_TracePrint(sh, &rec);
+            } else {
+                skipped++;
+            }
+        }
+        if (skipped != 0U) {
+            shell_warn(sh, "%u records overwritten while dumping", skipped);
+        }
+    } else if (strcmp(argv[0], "stream") == 0) {
+        if ((argc > 1) && (strcmp(argv[1], "on") == 0)) {
+            phNxpUciHal_TraceStream(sh);
+        } else if ((argc > 1) && (strcmp(argv[1], "off") == 0)) {
+            phNxpUciHal_TraceStream(NULL);
+        } else {
+            shell_error(sh, "Usage: uwb_trace stream <on|off>");
+            return -EINVAL;
+        }
+    } else if (strcmp(argv[0], "clear") == 0) {
+        phNxpUciHal_TraceClear();
+    } else if (strcmp(argv[0], "stats") == 0) {
+        phNxpUciHal_TraceStats_t st;
+
+        phNxpUciHal_TraceGetStats(&st);
+        shell_print(sh, "Trace ring      : %u records x %u bytes", st.wRecords,
+                    st.wBytes);
+        shell_print(sh, "  written       : %u", st.dwWritten);
+        shell_print(sh, "  streaming     : %s (printed %u, lost %u)",
+                    st.bStreaming ? "on" : "off", st.dwStreamed,
+                    st.dwStreamLost);
+    } else {
+        shell_error(sh, "Usage: uwb_trace <cmd>");
+        shell_print(sh, "Commands:");
+        shell_print(sh, "  dump [n]       - Print the last n UCI packets");
+        shell_print(sh, "  stream on|off  - Print new UCI packets live");
+        shell_print(sh, "  clear          - Drop recorded UCI packets");
+        shell_print(sh, "  stats          - Show trace ring counters");
+        return -EINVAL;
+    }
+    return 0;
+}
+#endif
+
 /*SWITCH UART cmd*/
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_switch_uart,
                                SHELL_CMD_ARG(set, NULL, "Set Shell uart",
@@ -876,6 +1583,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_pn7160,
                                              cmd_pn7160_test, 1, 0),
                                SHELL_CMD_ARG(stop, NULL, "Stop PN7160 test",
                                              cmd_pn7160_test, 1, 0),
+                               SHELL_CMD_ARG(stats, NULL,
+                                             "Show NCI latency and NDEF "
+                                             "read time",
+                                             cmd_pn7160_test, 1, 1),
                                SHELL_SUBCMD_SET_END);
 SHELL_CMD_REGISTER(PN7160_test, &sub_pn7160, "PN7160 test commands",
                    cmd_pn7160_test);
@@ -883,6 +1594,10 @@ SHELL_CMD_REGISTER(PN7160_test, &sub_pn7160, "PN7160 test commands",
 SHELL_STATIC_SUBCMD_SET_CREATE(
     sub_dtm, SHELL_CMD_ARG(start, NULL, "Start DTM", cmd_dtm_test, 1, 0),
     SHELL_CMD_ARG(stop, NULL, "Stop DTM", cmd_dtm_test, 1, 0),
+    SHELL_CMD_ARG(plan, NULL,
+                  "Run test plan steps <tx|rx|cw>:ch[-last[/inc]]:"
+                  "<1m|2m|s8|s2>:dBm:len:ms ..., or 'plan stop'",
+                  cmd_dtm_test, 2, SHELL_OPT_ARG_MAX),
     SHELL_SUBCMD_SET_END);
 SHELL_CMD_REGISTER(dtm_test, &sub_dtm,
                    "Start DTM (initialize Radio and connect interrupts)",
@@ -893,6 +1608,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_em4095,
                                              cmd_em4095_test, 1, 0),
                                SHELL_CMD_ARG(stop, NULL, "Stop EM4095 test",
                                              cmd_em4095_test, 1, 0),
+                               SHELL_CMD_ARG(stats, NULL,
+                                             "Show capture and decode "
+                                             "counters",
+                                             cmd_em4095_test, 1, 1),
+                               SHELL_CMD_ARG(bench, NULL,
+                                             "Replay the last capture "
+                                             "through the decoders [n]",
+                                             cmd_em4095_test, 1, 1),
                                SHELL_SUBCMD_SET_END);
 SHELL_CMD_REGISTER(em4095_test, &sub_em4095, "EM4095 test commands",
                    cmd_em4095_test);
@@ -913,4 +1636,45 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
     SHELL_CMD_ARG(settime, NULL, "Set UWB tx receive time", cmd_uwb_rx, 1, 1),
     SHELL_SUBCMD_SET_END);
 SHELL_CMD_REGISTER(uwb_test_rx, &sub_uwb_test_rx, "UWB demo test tx commands",
-                   cmd_uwb_rx);
\ No newline at end of file
+                   cmd_uwb_rx);
+
+/*UWB statistics*/
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    sub_uwb_stats,
+    SHELL_CMD_ARG(tml, NULL, "Show UCI TX latency counters", cmd_uwb_stats, 1,
+                  0),
+    SHELL_CMD_ARG(rxring, NULL, "Show TML receive ring counters",
+                  cmd_uwb_stats, 1, 0),
+    SHELL_CMD_ARG(irqlat, NULL, "Show UWBS IRQ to callback latency",
+                  cmd_uwb_stats, 1, 0),
+    SHELL_CMD_ARG(mem, NULL, "Show OSAL memory pool usage", cmd_uwb_stats, 1,
+                  0),
+    SHELL_CMD_ARG(fwdl, NULL, "Show FW download skip counters",
+                  cmd_uwb_stats, 1, 0),
+    SHELL_CMD_ARG(sync, NULL, "List OSAL semaphores and mutexes",
+                  cmd_uwb_stats, 1, 0),
+    SHELL_CMD_ARG(dispatch, NULL, "Show HAL thread queueing latency",
+                  cmd_uwb_stats, 1, 0),
+    SHELL_CMD_ARG(cpu, NULL, "Show CPU idle and uwb_task load",
+                  cmd_uwb_stats, 1, 0),
+    SHELL_CMD_ARG(reset, NULL, "Clear UWB statistics", cmd_uwb_stats, 1, 0),
+    SHELL_SUBCMD_SET_END);
+SHELL_CMD_REGISTER(uwb_stats, &sub_uwb_stats, "UWB stack statistics",
+                   cmd_uwb_stats);
+
+#if defined(CONFIG_UWB_TRACE)
+/*UWB UCI trace*/
+SHELL_STATIC_SUBCMD_SET_CREATE(
+    sub_uwb_trace,
+    SHELL_CMD_ARG(dump, NULL, "Print the last [n] UCI packets", cmd_uwb_trace,
+                  1, 1),
+    SHELL_CMD_ARG(stream, NULL, "Print new UCI packets <on|off>",
+                  cmd_uwb_trace, 2, 0),
+    SHELL_CMD_ARG(clear, NULL, "Drop recorded UCI packets", cmd_uwb_trace, 1,
+                  0),
+    SHELL_CMD_ARG(stats, NULL, "Show trace ring counters", cmd_uwb_trace, 1,
+                  0),
+    SHELL_SUBCMD_SET_END);
+SHELL_CMD_REGISTER(uwb_trace, &sub_uwb_trace, "UWB UCI packet trace",
+                   cmd_uwb_trace);
+#endif
@@ -2627,6 +2627,92 @@ int dtm_test_end(uint16_t* pack_cnt) {
   return 0;
 }
 
+/* dtm_plan_abort() 叫醒等待中的 step，plan 在該 step 結束後停止；
+ * dtm_plan_run() 開始前送的 abort 會被清掉 */
+static K_SEM_DEFINE(dtm_plan_stop_sem, 0, 1);
+
+void dtm_plan_abort(void) { k_sem_give(&dtm_plan_stop_sem); }
+
+int dtm_plan_run(const struct dtm_plan_step* steps, size_t count,
+                 struct dtm_plan_result* results) {
+  int64_t deadline;
+  bool stopped = false;
+  size_t count_done = 0;
+
+  if ((steps == NULL) || (results == NULL)) {
+    return -EINVAL;
+  }
+
+  if (dtm_inst.state == STATE_UNINITIALIZED) {
+    return -EACCES;
+  }
+
+  /* 上一個 plan 結束後才送來的 abort 不算 */
+  k_sem_reset(&dtm_plan_stop_sem);
+
+  /* 每一步的結束時間以 plan 開始時間累加，setup 花的時間不會累積成漂移 */
+  deadline = k_uptime_ticks();
+  for (size_t i = 0; (i < count) && !stopped; i++) {
+    const struct dtm_plan_step* step = &steps[i];
+    struct dtm_plan_result* res = &results[i];
+    uint32_t start = k_cycle_get_32();
+    uint16_t cnt = 0;
+
+    memset(res, 0, sizeof(*res));
+    deadline += k_ms_to_ticks_ceil64(step->duration_ms);
+
+    dtm_setup_prepare();
+    res->err = dtm_setup_set_phy(step->phy);
+    if ((res->err == 0) && (step->mode != DTM_PLAN_RX)) {
+      res->tx_power = dtm_setup_set_transmit_power(DTM_TX_POWER_REQUEST_VAL,
+                                                   step->tx_power,
+                                                   step->channel)
+                          .power;
+    }
+
+    if (res->err == 0) {
+      switch (step->mode) {
+        case DTM_PLAN_TX:
+          res->err = dtm_test_transmit(step->channel, step->length, step->pkt);
+          break;
+
+        case DTM_PLAN_RX:
+          res->err = dtm_test_receive(step->channel);
+          break;
+
+        case DTM_PLAN_CARRIER:
+          if ((step->phy != DTM_PHY_1M) && (step->phy != DTM_PHY_2M)) {
+            res->err = -EINVAL;
+            break;
+          }
+          res->err = dtm_test_transmit(step->channel, CARRIER_TEST,
+                                       DTM_PACKET_FF_OR_VENDOR);
+          break;
+
+        default:
+          res->err = -EINVAL;
+          break;
+      }
+    }
+
+    if (res->err == 0) {
+      stopped = (k_sem_take(&dtm_plan_stop_sem,
+                            K_TIMEOUT_ABS_TICKS(deadline)) == 0);
+    } else {
+      /* 失敗的步驟不佔時間，後面的步驟從現在重新對齊 */
+      deadline = k_uptime_ticks();
+      stopped = (k_sem_take(&dtm_plan_stop_sem, K_NO_WAIT) == 0);
+    }
+
+    (void)dtm_test_end(&cnt);
+    res->packets = (step->mode == DTM_PLAN_RX) ? cnt : 0;
+    res->elapsed_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+    count_done = i + 1;
+  }
+
+  return (int)count_done;
+}
+
 static struct dtm_pdu* radio_buffer_swap(void) {
   struct dtm_pdu* received_pdu = dtm_inst.current_pdu;
   uint32_t packet_index = (dtm_inst.current_pdu == dtm_inst.pdu);
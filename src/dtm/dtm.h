@@ -8,6 +8,7 @@
 #define DTM_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <zephyr/types.h>
 #include <zephyr/devicetree.h>
 
@@ -170,6 +171,57 @@ struct dtm_tx_power {
 	bool max;
 };
 
+/** @brief DTM test plan step type. */
+enum dtm_plan_mode {
+	/** Transmitter test with modulated packets. */
+	DTM_PLAN_TX,
+
+	/** Receiver test, counting received packets. */
+	DTM_PLAN_RX,
+
+	/** Unmodulated carrier (vendor specific, 1M/2M PHY only). */
+	DTM_PLAN_CARRIER
+};
+
+/** @brief One step of a DTM test plan. */
+struct dtm_plan_step {
+	/** Step type. */
+	enum dtm_plan_mode mode;
+
+	/** PHY used for the step. */
+	enum dtm_phy phy;
+
+	/** Packet type for transmitter steps. */
+	enum dtm_packet pkt;
+
+	/** DTM channel, 0 to 39. */
+	uint8_t channel;
+
+	/** Payload length for transmitter steps. */
+	uint8_t length;
+
+	/** Requested TX power in dBm. */
+	int8_t tx_power;
+
+	/** Time the radio stays in this step, in milliseconds. */
+	uint16_t duration_ms;
+};
+
+/** @brief Result of one DTM test plan step. */
+struct dtm_plan_result {
+	/** 0 on success or negative error code of the failing DTM call. */
+	int err;
+
+	/** Time from the step start to its end, in microseconds. */
+	uint32_t elapsed_us;
+
+	/** Packets received, for receiver steps. */
+	uint16_t packets;
+
+	/** TX power actually set in dBm, for transmitter and carrier steps. */
+	int8_t tx_power;
+};
+
 /** @brief DTM Packet status for IQ Sample report. */
 enum dtm_packet_status {
 	/** Packet received with proper CRC. */
@@ -380,6 +432,34 @@ int dtm_test_transmit(uint8_t channel, uint8_t length, enum dtm_packet pkt);
  */
 int dtm_test_end(uint16_t *pack_cnt);
 
+/** @brief Run a DTM test plan locally.
+ *
+ * Runs the steps back to back without any host round trip. Step
+ * boundaries follow absolute kernel deadlines from the plan start, so
+ * the setup time of a step does not stretch the plan. A failing step is
+ * recorded in its result and the plan continues with the next one.
+ *
+ * The caller must keep the DTM transport from processing commands while
+ * the plan runs.
+ *
+ * @param[in]  steps   The test plan.
+ * @param[in]  count   Number of steps.
+ * @param[out] results One result per step.
+ *
+ * @return Number of steps run, less than @p count when the plan was
+ *         stopped by dtm_plan_abort(), or negative value in case of error.
+ */
+int dtm_plan_run(const struct dtm_plan_step *steps, size_t count,
+		 struct dtm_plan_result *results);
+
+/** @brief Stop a running DTM test plan.
+ *
+ * The current step ends right away and dtm_plan_run() returns without
+ * running the remaining steps. Safe to call from any thread. An abort
+ * issued before dtm_plan_run() starts is discarded.
+ */
+void dtm_plan_abort(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -72,6 +72,47 @@ LOG_MODULE_REGISTER(dtm_tw_tr, CONFIG_DTM_TRANSPORT_LOG_LEVEL);
 
 static const struct device *dtm_uart = DEVICE_DT_GET(DTM_UART);
 
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN)
+/* A received byte and its arrival time, for the second byte timeout. */
+struct dtm_rx_byte {
+	uint32_t time;
+	uint8_t data;
+};
+
+K_MSGQ_DEFINE(dtm_rx_q, sizeof(struct dtm_rx_byte), CONFIG_DTM_UART_RX_QUEUE_SIZE, 4);
+
+/* Bytes dropped because the receive queue was full. */
+static atomic_t dtm_rx_dropped;
+
+static void dtm_uart_isr(const struct device *dev, void *user_data)
+{
+	struct dtm_rx_byte rx;
+	uint8_t buf[8];
+	int len;
+
+	ARG_UNUSED(user_data);
+
+	if (!uart_irq_update(dev)) {
+		return;
+	}
+
+	while (uart_irq_rx_ready(dev)) {
+		len = uart_fifo_read(dev, buf, sizeof(buf));
+		if (len <= 0) {
+			break;
+		}
+
+		rx.time = k_uptime_get_32();
+		for (int i = 0; i < len; i++) {
+			rx.data = buf[i];
+			if (k_msgq_put(&dtm_rx_q, &rx, K_NO_WAIT) != 0) {
+				atomic_inc(&dtm_rx_dropped);
+			}
+		}
+	}
+}
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+
 /* DTM command codes */
 enum dtm_cmd_code {
 	/* Test Setup Command: Set PHY or modulation, configure upper two bits
@@ -741,6 +782,13 @@ static bool dtm_transport_initialized = false;
 /* Function to reset transport initialization state (called from dtm_stop) */
 void dtm_tr_reset_state(void)
 {
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN)
+	if (dtm_transport_initialized) {
+		uart_irq_rx_disable(dtm_uart);
+		uart_irq_callback_user_data_set(dtm_uart, NULL, NULL);
+		k_msgq_purge(&dtm_rx_q);
+	}
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
 	dtm_transport_initialized = false;
 }
 
@@ -765,15 +813,85 @@ int dtm_tr_init(void)
 		return err;
 	}
 
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN)
+	uint8_t dummy;
+
+	/* Receive in the UART interrupt instead of polling on a timer. */
+	uart_irq_rx_disable(dtm_uart);
+	err = uart_irq_callback_user_data_set(dtm_uart, dtm_uart_isr, NULL);
+	if (err) {
+		LOG_ERR("Cannot set UART RX callback: %d", err);
+		return err;
+	}
+
+	while (uart_fifo_read(dtm_uart, &dummy, 1) > 0) {
+		/* Drop stale bytes */
+	}
+	k_msgq_purge(&dtm_rx_q);
+	uart_irq_rx_enable(dtm_uart);
+#else
 	err = dtm_uart_wait_init();
 	if (err) {
 		return err;
 	}
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
 
 	dtm_transport_initialized = true;
 	return 0;
 }
 
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN)
+union dtm_tr_packet dtm_tr_get(void)
+{
+	bool is_msb_read = false;
+	union dtm_tr_packet tmp;
+	struct dtm_rx_byte rx;
+	uint16_t dtm_cmd = 0;
+	uint32_t msb_time = 0;
+	atomic_val_t dropped;
+
+	for (;;) {
+		/* Queued bytes are framed back to back; sleep only when empty. */
+		(void)k_msgq_get(&dtm_rx_q, &rx, K_FOREVER);
+
+		dropped = atomic_clear(&dtm_rx_dropped);
+		if (dropped) {
+			LOG_WRN("%ld received bytes dropped, queue full", (long)dropped);
+		}
+
+		if (!is_msb_read) {
+			/* This is first byte of two-byte command. */
+			is_msb_read = true;
+			dtm_cmd = rx.data << 8;
+			msb_time = rx.time;
+
+			/* Go back and wait for 2nd byte of command word. */
+			continue;
+		}
+
+		/* This is the second byte read; combine it with the first and
+		 * process command. Both times were taken in the RX interrupt,
+		 * so a byte that waited in the queue is not mistaken as late.
+		 */
+		if ((rx.time - msb_time) > DTM_UART_SECOND_BYTE_MAX_DELAY) {
+			/* More than ~5mS after msb: Drop old byte, take the
+			 * new byte as MSB. The variable is_msb_read will
+			 * remain true.
+			 */
+			dtm_cmd = rx.data << 8;
+			msb_time = rx.time;
+			/* Go back and wait for 2nd byte of command word. */
+			LOG_DBG("Received byte discarded");
+			continue;
+		} else {
+			dtm_cmd |= rx.data;
+			LOG_INF("Received 0x%04x command", dtm_cmd);
+			tmp.twowire = dtm_cmd;
+			return tmp;
+		}
+	}
+}
+#else
 union dtm_tr_packet dtm_tr_get(void)
 {
 	bool is_msb_read = false;
@@ -828,6 +946,7 @@ union dtm_tr_packet dtm_tr_get(void)
 		}
 	}
 }
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
 
 int dtm_tr_process(union dtm_tr_packet cmd)
 {
@@ -82,41 +82,45 @@ static uint16_t demod_counter = 0;
 static uint16_t demod_check_counter = 0;
 static uint16_t em4095_timer_expired = 0;
 
-#define TICK_BUFFER_SIZE ((96 * 2 + 8) * 6) /* 200 */
-uint32_t tick_buffer[TICK_BUFFER_SIZE] = {0, 0};
-uint8_t fsk_bit_buffer[TICK_BUFFER_SIZE] = {0, 0};
-
-/* 原本是 0x480 (1152) */
-/* FSK '0' 約 975 ticks, FSK '1' 約 1220 ticks */
-/* 中間值約 1097, 設定為 1100 以獲得最佳平衡 */
-#define MIN_FSK_1_TICK 0x44C /* 1/12.5KHz = 80us, 1280 ticks when 16MHz */
+/* 採樣視窗結束 (COMPARE3 到期或 tick_buffer 滿) 時由 ISR give，
+ * receiver thread 睡在這裡等，不再固定 sleep 一整個視窗 */
+static K_SEM_DEFINE(em4095_capture_sem, 0, 1);
+/* FSK 與 ASK 共用一個 toggle 觸發的視窗：
+ * HID 約 86ms 就會把 tick_buffer 填滿 ((96+8) bits * 400us 至少兩次)，
+ * EM4100 (64 bits * 512us) 解到卡號就提早結束，沒有卡則最多 120ms */
+#define EM4095_CAPTURE_WINDOW_MS 120
+/* COMPARE3 沒有觸發 (timer 被 deinit) 時的保險時間 */
+#define EM4095_CAPTURE_GUARD_MS 10
+
+/* TICK_BUFFER_SIZE 定義在 em4095_decode.h */
+uint16_t tick_buffer[TICK_BUFFER_SIZE] = {0, 0};
+/* 最後一個採樣視窗收到的 edge 數，給 em4095_replay() 用 */
+static uint16_t tick_count = 0;
 
 uint32_t preview_tick = 0;
 uint32_t current_tick = 0;
-uint32_t threadhold = 0;
-uint8_t fsk_bit_0_counter = 0;
-uint8_t fsk_bit_1_counter = 0;
-uint16_t header_position = 0;
-uint8_t data_bit_count = 0;
-uint8_t data_buf[96 - 6];
-uint32_t original_data[3] = {0, 0};
-uint8_t fsk_card_detected = 1;
-uint8_t real_44bits_buffer[44];
-uint16_t company_code, card_format, sc_code, ep, op, ep_sum, op_sum;
-uint32_t pre_card_number = 0;
-uint32_t card_number = 0;
-uint16_t ep_35bit_sum, op_35bit_sum_all, op_35bit_sum;
-uint16_t ep_37bit_sum, op_37bit_sum;
-uint16_t ep_37bit_10302_sum, op_37bit_10302_sum;
-uint16_t op1_sum, ep2_sum, op3_sum;
 const nrfx_timer_t TIMER_EM4095 = NRFX_TIMER_INSTANCE(3);
 
 static uint32_t last_capture_tick = 0;
 static nrf_ppi_channel_t m_ppi_channel;
+/* PPI fork 到 TIMER4 (counter mode) 數 GPIOTE event。ISR 慢於下一個 edge
+ * 時 CC0 會被覆蓋、demod_counter 少算，視窗結束時兩者就對不起來 */
+const nrfx_timer_t COUNTER_EM4095 = NRFX_TIMER_INSTANCE(4);
+/* 視窗結束時 PPI 已經拍下、但 GPIOTE ISR 還沒跑的最後一個 edge */
+#define EM4095_OVERRUN_SLACK 1
 static const nrfx_gpiote_t m_gpiote = NRFX_GPIOTE_INSTANCE(0);
 static bool m_gpiote_initialized = false;
 #define EM4095_CAPTURE_CC_IDX 0
-#define NOISE_GLITCH_THRESHOLD 200
+
+static enum PPI_TRIGGER_MODE em4095_trigger_mode = FSK;
+/* ASK 模式下由 demod_gpio_handler 逐個 edge 餵入 */
+static em4100_decoder_t em4100_decoder;
+/* toggle 觸發下 HID 每 32-40us 就有一個 edge (約 28kHz)，前
+ * EM4095_FSK_PROBE_EDGES 個間隔多半是 FSK 半週期時就停止餵 em4100_decoder，
+ * 讓 ISR 趕得上下一個 edge */
+#define EM4095_FSK_PROBE_EDGES 32
+static bool em4100_feeding = true;
+static uint16_t fsk_probe_edges = 0;
 
 void em4095_set_trigger_mode(enum PPI_TRIGGER_MODE mode) {
   uint8_t ch_index;
@@ -141,6 +145,7 @@ void em4095_set_trigger_mode(enum PPI_TRIGGER_MODE mode) {
   /* 重新啟用 */
   nrf_gpiote_event_enable(NRF_GPIOTE, ch_index);
   nrf_gpiote_int_enable(NRF_GPIOTE, 1UL << ch_index);
+  em4095_trigger_mode = mode;
 }
 
 /* compare timer to calculate duration between low to high */
@@ -157,6 +162,7 @@ void pin_demod_handler(const struct device* dev, struct gpio_callback* cb,
       // NRF_LOG_INFO("DEMOD_INTERRUPT!(%d) (%d)\n", tick_buffer[49],
       // tick_buffer[50]);
       em4095_gpio_sampling_disable();
+      k_sem_give(&em4095_capture_sem);
       // demod_counter = 0;
     }
 #if 0
@@ -186,16 +192,33 @@ void demod_gpio_handler(nrfx_gpiote_pin_t pin, nrfx_gpiote_trigger_t trigger,
     // 這裡維持「累積計時」邏輯，不歸零 Timer，容錯率最高
     uint32_t period = current_absolute_tick - last_capture_tick;
 
-    tick_buffer[demod_counter] = period;
+    tick_buffer[demod_counter] = MIN(period, UINT16_MAX);
 
     // 3. 更新 last_capture_tick
     last_capture_tick = current_absolute_tick;
 
+    /* ticks[0] 是從開視窗到第一個 edge 的時間，不算 */
+    if (em4100_feeding && (demod_counter != 0) &&
+        (demod_counter <= EM4095_FSK_PROBE_EDGES)) {
+      if (period < FSK_HALF_TICK_MAX) fsk_probe_edges++;
+      if ((demod_counter == EM4095_FSK_PROBE_EDGES) &&
+          (fsk_probe_edges > EM4095_FSK_PROBE_EDGES / 2)) {
+        em4100_feeding = false;
+      }
+    }
+
     demod_counter++;
     demod_check_counter++;
 
-    if (demod_counter >= TICK_BUFFER_SIZE) {
+    if ((em4095_trigger_mode == ASK) && em4100_feeding &&
+        em4100_decoder_feed(&em4100_decoder, period)) {
+      /* 收到完整的 EM4100 frame，不用等視窗結束 */
       em4095_gpio_sampling_disable();
+      k_sem_give(&em4095_capture_sem);
+    } else if (demod_counter >= TICK_BUFFER_SIZE) {
+      /* buffer 滿了就提早結束視窗 */
+      em4095_gpio_sampling_disable();
+      k_sem_give(&em4095_capture_sem);
     }
   }
 }
@@ -211,9 +234,7 @@ void em4095_timer_event_handle(nrf_timer_event_t event_type, void* p_context) {
       nrfx_timer_clear(&TIMER_EM4095);
 
       em4095_gpio_sampling_disable();
-      if (demod_counter < (TICK_BUFFER_SIZE / 2)) {
-        fsk_card_detected = 0;
-      }
+      k_sem_give(&em4095_capture_sem);
       // NRF_LOG_INFO("em4095 timer3 isr!!");
       break;
 
@@ -223,10 +244,9 @@ void em4095_timer_event_handle(nrf_timer_event_t event_type, void* p_context) {
   }
 }
 
-void em4095_timer_enable(void) {
+/* time_ms: Time(in miliseconds) between consecutive compare events. */
+void em4095_timer_enable(uint32_t time_ms) {
   /* start timer */
-  uint32_t time_ms =
-      84;  // Time(in miliseconds) between consecutive compare events.
   uint32_t time_ticks;
   em4095_timer_expired = 0; /* clear */
   // demod_counter = 0;
@@ -247,7 +267,11 @@ void em4095_timer_disable(void) {
 
 void em4095_gpio_sampling_enable(void) {
   last_capture_tick = 0;
+  em4100_feeding = true;
+  fsk_probe_edges = 0;
   nrfx_timer_clear(&TIMER_EM4095);
+  nrfx_timer_clear(&COUNTER_EM4095);
+  nrfx_timer_enable(&COUNTER_EM4095);
 
   /* v3: 啟用 Trigger (包含中斷與 Event) */
   nrfx_gpiote_trigger_enable(&m_gpiote, demod_out_gpio.pin, true);
@@ -268,6 +292,32 @@ void em4095_gpio_sampling_disable(void) {
   nrfx_gpiote_trigger_disable(&m_gpiote, demod_out_gpio.pin);
 }
 
+/* 開一個 time_ms 的採樣視窗，thread 睡在 em4095_capture_sem 上直到
+ * COMPARE3 到期或 tick_buffer 滿，回傳收到的 edge 數。
+ * GPIOTE event 比 ISR 收到的 edge 多 (CC0 被覆蓋) 時 *overrun 為 true */
+static uint16_t em4095_capture_window(uint32_t time_ms, bool* overrun) {
+  k_sem_reset(&em4095_capture_sem);
+  em4095_timer_enable(time_ms);
+  demod_counter = 0;
+  em4095_gpio_sampling_enable();
+
+  (void)k_sem_take(&em4095_capture_sem,
+                   K_MSEC(time_ms + EM4095_CAPTURE_GUARD_MS));
+
+  em4095_gpio_sampling_disable();
+  em4095_timer_disable();
+
+  uint32_t events =
+      nrfx_timer_capture(&COUNTER_EM4095, NRF_TIMER_CC_CHANNEL0);
+  nrfx_timer_disable(&COUNTER_EM4095);
+  *overrun = (events > (uint32_t)demod_counter + EM4095_OVERRUN_SLACK);
+  return demod_counter;
+}
+
+/* COUNTER_EM4095 只用 COUNT/CAPTURE task，不開中斷 */
+static void em4095_counter_event_handle(nrf_timer_event_t event_type,
+                                        void* p_context) {}
+
 int em4095_timer3_init(void) {
   nrfx_err_t err_code = NRFX_SUCCESS;
 
@@ -282,6 +332,19 @@ int em4095_timer3_init(void) {
     return -EIO;
   }
 
+  /* 1-1. GPIOTE event counter */
+  nrfx_timer_config_t counter_cfg =
+      NRFX_TIMER_DEFAULT_CONFIG(NRF_TIMER_BASE_FREQUENCY_16MHZ);
+  counter_cfg.mode = NRF_TIMER_MODE_COUNTER;
+  counter_cfg.bit_width = NRF_TIMER_BIT_WIDTH_32;
+  err_code = nrfx_timer_init(&COUNTER_EM4095, &counter_cfg,
+                             em4095_counter_event_handle);
+  if (err_code != NRFX_SUCCESS) {
+    printk("Error: nrfx_timer_init (counter) fail code: %d\n", err_code);
+    nrfx_timer_uninit(&TIMER_EM4095);
+    return -EIO;
+  }
+
   /* 2. PPI Alloc */
   err_code = nrfx_ppi_channel_alloc(&m_ppi_channel);
   if (err_code != NRFX_SUCCESS) {
@@ -364,6 +427,9 @@ int em4095_timer3_init(void) {
       nrfx_timer_capture_task_address_get(&TIMER_EM4095, EM4095_CAPTURE_CC_IDX);
   nrfx_ppi_channel_assign(m_ppi_channel, gpiote_event_addr,
                           timer_capture_task_addr);
+  nrfx_ppi_channel_fork_assign(
+      m_ppi_channel,
+      nrfx_timer_task_address_get(&COUNTER_EM4095, NRF_TIMER_TASK_COUNT));
 
   /* 11. IRQ Connect */
   IRQ_CONNECT(TIMER3_IRQn, 1, nrfx_isr, nrfx_timer_3_irq_handler, 0);
@@ -385,338 +451,78 @@ void em4095_timer3_deinit(void) {
 
   /* Uninitialize timer to release it */
   nrfx_timer_uninit(&TIMER_EM4095);
+  nrfx_timer_uninit(&COUNTER_EM4095);
 
   /* Free PPI channel */
   nrfx_ppi_channel_free(m_ppi_channel);
 }
 
-unsigned short em4095_hid_receiver(void) {
-  /* 1. confirm FSK signal
-   * 2. open detection windows to detect 0x1D(detect 18 times 15.625KHz square
-   * wave) 1 bit 400us, needs (96+8) * 400 = 41.60ms should be detect one time
-   * at least in 42 ms if get 0x1D, should be detect one time to receive all
-   * data again.
-   * 3. timer interrupt service to detect fsk 0 and fsk 1
-   *    fsk 0 : 15.625KHz * 6 (64us * 6 = 384us) -> 63.36-64.64 us
-   *    fsk 1 : 12.5KHz * 5 (80us * 5 = 400us) -> 79.2-80.8 us
-   *
-   */
-  uint16_t i;
-  uint32_t redundant_word_26 = 0, redundant_word_35 = 0, redundant_word_37 = 0;
-  unsigned short ret = 0;
-
-  /* 42 ms timer test */
-  /* need to find 0x1D(0x0001 1101), means 18*fsk_0 and 15*fsk_1 at least */
-  memset(tick_buffer, 0, TICK_BUFFER_SIZE);
-  memset(fsk_bit_buffer, 0, TICK_BUFFER_SIZE);
-  while (1) {
-    fsk_card_detected = 1;
-    em4095_timer_enable();
-    em4095_timer_expired = 0;
-    demod_counter = 0;
-    em4095_gpio_sampling_enable();
-    // gpio_SetValue(1, 8, HIGH);
-    // while(!em4095_timer_expired)
-    //{
-    nrf_delay_ms(84);
-    //}
-    // gpio_SetValue(1, 8, LOW);
-    em4095_gpio_sampling_disable();
-    em4095_timer_disable();
-    if (demod_counter < (TICK_BUFFER_SIZE / 2)) {
-      fsk_card_detected = 0;
-    }
-    break;
-  }
-  // NRF_LOG_INFO("fsk_card_detected = %d\n", fsk_card_detected);
-  if (fsk_card_detected) {
-#if 0
-        /* decision adjustment */
-        //NRF_LOG_INFO("[em4095] HID DETECTED!!!"); 
-        uint16_t queue_data_1[64], queue_data_2[22];
-        uint16_t queue_1_index = 0, queue_2_index = 0;
-        
-        for(i = 10; i < TICK_BUFFER_SIZE; i++)
-        {
-            if((tick_buffer[i] > 800) && (tick_buffer[i] < 1500))
-            {
-                queue_data_1[queue_1_index++] = tick_buffer[i];
-                if(queue_1_index >= 64)
-                {
-                    break;
-                }
-            }
-        }
-        threadhold = 0;
-        for(i = 0; i < 64; i++)
-        {
-            threadhold += queue_data_1[i];
-        }
-        threadhold >>= 6;
-        uint8_t pre_bit = 0;
-        queue_1_index = 0;
-        for(i = 1; i < TICK_BUFFER_SIZE; i++)
-        {
-            if(tick_buffer[i] > 1500)
-            {
-                if(pre_bit)
-                {
-                    fsk_bit_buffer[queue_1_index++] = 1;
-                    fsk_bit_buffer[queue_1_index++] = 0;
-                }
-                else
-                {
-                    fsk_bit_buffer[queue_1_index++] = 0;
-                    fsk_bit_buffer[queue_1_index++] = 1;                    
-                }
-            }
-            else if(tick_buffer[i] > threadhold)
-            {
-                fsk_bit_buffer[queue_1_index++] = 1;
-                pre_bit = 1;
-                //queue_1_index++;
-            }
-
-            else
-            {
-                fsk_bit_buffer[queue_1_index++] = 0;
-                pre_bit = 0;
-                //queue_1_index++;
-            }
-            if(queue_1_index>=TICK_BUFFER_SIZE)
-            {
-                break;
-            }
-        }
-#else
-    /*
-    NRF_LOG_INFO("--- HID RAW TICKS ---");
-    for (int k = 0; k < 20; k += 2) {
-      // 印出完整週期 (Low + High)
-      uint32_t period = tick_buffer[k] + tick_buffer[k + 1];
-      NRF_LOG_INFO("[%d] %u", k, period);
-    }
-    */
+static em4095_stats_t em4095_stats;
 
-    uint32_t accumulated_tick = 0;
-    for (i = 0; i < TICK_BUFFER_SIZE; i++) {
-      /* 取出當前數值 */
-      uint32_t current_val = tick_buffer[i];
+K_MSGQ_DEFINE(em4095_card_msgq, sizeof(em4095_card_event_t),
+              CONFIG_EM4095_EVENT_QUEUE_DEPTH, 8);
 
-      /* 如果有累積的數值 (之前有雜訊)，加進來 */
-      current_val += accumulated_tick;
-      accumulated_tick = 0;  // 清空累積
+/* 最近讀到的卡，卡片一直放在感應區時只回報一次 */
+struct em4095_seen_card {
+  int64_t last_seen; /* 0: 空的 */
+  uint64_t code;
+  uint8_t type;
+};
+static struct em4095_seen_card em4095_seen[CONFIG_EM4095_CARD_CACHE_SIZE];
 
-      /* 檢查是否為極短雜訊 (Glitch) */
-      if (current_val < NOISE_GLITCH_THRESHOLD) {
-        /* 這是一個雜訊！不要判斷它，把它加到下一個數值去修復波形 */
-        accumulated_tick = current_val;
+/* 回傳 true 表示這張卡在 hold-off 內已經回報過；每次讀到都會重新計時 */
+static bool em4095_card_seen(uint8_t type, uint64_t code, int64_t now) {
+  struct em4095_seen_card* oldest = &em4095_seen[0];
 
-        /* 暫時將這個 bit 標記為無效或預設值 (之後判斷 header 會自動忽略) */
-        fsk_bit_buffer[i] = 0;
-        continue;
-      }
+  for (int i = 0; i < CONFIG_EM4095_CARD_CACHE_SIZE; i++) {
+    struct em4095_seen_card* entry = &em4095_seen[i];
 
-      if (tick_buffer[i] > MIN_FSK_1_TICK) {
-        fsk_bit_buffer[i] = 1;
-      } else
-        fsk_bit_buffer[i] = 0;
+    if ((entry->last_seen != 0) && (entry->type == type) &&
+        (entry->code == code)) {
+      bool seen = (now - entry->last_seen) < CONFIG_EM4095_CARD_HOLDOFF_MS;
+      entry->last_seen = now;
+      return seen;
     }
-#endif
-    /* search header */
-    // NRF_LOG_INFO("[em4095] search header...");
-    fsk_bit_0_counter = 0;
-    fsk_bit_1_counter = 1;
-    header_position = 0;
-    memset(data_buf, 0xFF, sizeof(data_buf));
-    for (i = 0; i < TICK_BUFFER_SIZE; i++) {
-      if (fsk_bit_buffer[i] == 0) {
-        fsk_bit_0_counter++;
-      } else {
-        if (fsk_bit_0_counter >= 14) {
-          header_position = i; /* find the position of first fsk bit 1 */
-          break;
-        } else {
-          fsk_bit_0_counter = 0;
-        }
-      }
+    if (entry->last_seen < oldest->last_seen) {
+      oldest = entry;
     }
-    if (header_position) {
-      for (i = header_position; i < TICK_BUFFER_SIZE; i++) {
-        if (fsk_bit_buffer[i] == 1) {
-          fsk_bit_1_counter++;
-        } else {
-          if (fsk_bit_1_counter >= 13) {
-            header_position =
-                i; /* find the position of the last 2 bit of header */
-            break;
-          } else {
-            fsk_bit_1_counter = 0;
-          }
-        }
-      }
-      data_bit_count = 0;
-      fsk_bit_0_counter = fsk_bit_1_counter = 0;
-      /* decision the fsk bit to data bit */
-      for (i = header_position; i < TICK_BUFFER_SIZE; i++) {
-        if (fsk_bit_buffer[i] == 1) {
-          fsk_bit_1_counter++;
-          if (fsk_bit_0_counter >= 4) {
-            if (fsk_bit_0_counter > 8) {
-              data_buf[data_bit_count++] = 0;
-            }
-            data_buf[data_bit_count++] = 0;
-            fsk_bit_0_counter = 0;
-          }
-        } else {
-          fsk_bit_0_counter++;
-          if (fsk_bit_1_counter >= 4) {
-            if (fsk_bit_1_counter > 8) {
-              data_buf[data_bit_count++] = 1;
-            }
-            data_buf[data_bit_count++] = 1;
-            fsk_bit_1_counter = 0;
-          }
-        }
-        if (data_bit_count >= 90) {
-          /* all data received */
-          break;
-        }
-      }
-#if 0
-     for(i = 0; i < 26; i++)
-     {
-        original_data[0] |= (data_buf[i] << (25-i));
-     }
-     for(i = 26; i < 58; i++)
-     {
-        original_data[1] |= (data_buf[i] << (57-i));
-     }
-     for(i = 58; i < 90; i++)
-     {
-        original_data[2] |= (data_buf[i] << (89-i));
-     }
-     NRF_LOG_INFO("[em4095] HID card was detected!(0x%8X)(0x%8X)(0x%8X)", original_data[0], original_data[1], original_data[2]);
-#endif
-      memset(real_44bits_buffer, 0xFF, sizeof(real_44bits_buffer));
-      for (i = 0; i < 88; i += 2) {
-        real_44bits_buffer[43 - i / 2] = i + 1;
-        if ((data_buf[2 + i] == 0) && (data_buf[2 + i + 1] == 1)) {
-          real_44bits_buffer[43 - i / 2] = 0;
-        } else if ((data_buf[2 + i] == 1) && (data_buf[2 + i + 1] == 0)) {
-          real_44bits_buffer[43 - i / 2] = 1;
-        } else {
-          /* should not happen break! */
-          // printk("should not happen break!\n");
-          return 0;
-        }
-      }
+  }
+  oldest->last_seen = now;
+  oldest->code = code;
+  oldest->type = type;
+  return false;
+}
 
-      /* parity check */
-      // NRF_LOG_INFO("[em4095] parity check...");
-      /* HID 10302 */
-      ep_sum = 0;
-      op_sum = 0;
-      /* should be 0 if even parity check */
-      for (i = 13; i < 26; i++) ep_sum += (real_44bits_buffer[i] & 0x01);
-      /* should be 1 if odd parity check */
-      for (i = 0; i < 13; i++) op_sum += (real_44bits_buffer[i] & 0x01);
-      /* 18 bits, 0x00801 */
-      for (i = 26; i < 44; i++) {
-        redundant_word_26 |= (real_44bits_buffer[i] << (i - 26));
-      }
-      /* corp 1000 35bits */ /* 34-0 */
-      ep_35bit_sum = op_35bit_sum_all = op_35bit_sum = 0;
-      ep_35bit_sum = real_44bits_buffer[33];
-      op_35bit_sum = real_44bits_buffer[0];
-      for (i = 1; i < 34; i += 3) {
-        ep_35bit_sum += (real_44bits_buffer[i] + real_44bits_buffer[i + 1]);
-        op_35bit_sum += (real_44bits_buffer[i + 1] + real_44bits_buffer[i + 2]);
-      }
-      for (i = 0; i < 35; i += 1) {
-        op_35bit_sum_all += real_44bits_buffer[0];
-      }
-      /* 9 bits, 0x005 */
-      for (i = 35; i < 44; i++) {
-        redundant_word_35 |= (real_44bits_buffer[i] << (i - 35));
-      }
-      /* HID H10304 or H10302 */
-      ep_37bit_sum = 0;
-      op_37bit_sum = 0;
-      for (i = 18; i < 37; i++) ep_37bit_sum += (real_44bits_buffer[i] & 0x01);
-      for (i = 0; i < 19; i++) op_37bit_sum += (real_44bits_buffer[i] & 0x01);
-      /* 7 bits, 0x00 */
-      for (i = 37; i < 44; i++) {
-        redundant_word_37 |= (real_44bits_buffer[i] << (i - 35));
-      }
+/* 把讀到的卡放進 em4095_card_msgq，不等 consumer，也不碰 console/buzzer */
+static void em4095_report_card(uint8_t type, uint8_t bits, uint64_t code) {
+  em4095_card_event_t event = {
+      .timestamp = k_uptime_get(),
+      .code = code,
+      .type = type,
+      .bits = bits,
+  };
 
-      /* show result */
-      pre_card_number = card_number;
-      card_number = 0;
-      // if(((ep_sum & 0x01) == 0) && ((op_sum & 0x01) == 1) &&
-      // (real_44bits_buffer[25] || real_44bits_buffer[26]) &&
-      // (real_44bits_buffer[27] == 0))
-      NRF_LOG_INFO("[em4095] show result...");
-      if (((ep_sum & 0x01) == 0) && ((op_sum & 0x01) == 1) &&
-          (redundant_word_26 == 0x0801)) {
-        for (i = 1; i < 17; i++)
-          card_number |= (real_44bits_buffer[i] << (i - 1));
-        if (card_number != pre_card_number) {
-          NRF_LOG_INFO("[em4095] HID(26-bits) Card NO: (%d)", card_number);
-        } else {
-          NRF_LOG_INFO("[em4095] [duplicate] HID(26 bits) Card NO: (%d)",
-                       card_number);
-        }
-        tone_em4095_detected();
-        ret = 1;
-      }
-      // else if(((ep_35bit_sum & 0x01) == 0) && ((op_35bit_sum & 0x01) == 1) &&
-      // ((op_35bit_sum_all & 0x01) == 1))
-      else if (((ep_35bit_sum & 0x01) == 0) && ((op_35bit_sum & 0x01) == 1) &&
-               ((op_35bit_sum_all & 0x01) == 1) &&
-               (redundant_word_35 == 0x005)) {
-        card_number = 0;
-        for (i = 1; i < 21; i++)
-          card_number |= (real_44bits_buffer[i] << (i - 1));
-        /* with facility code, H10304 */
-        if (card_number != pre_card_number) {
-          NRF_LOG_INFO("[em4095] HID(35 bits) Card NO: (%d)", card_number);
-        } else {
-          NRF_LOG_INFO("[em4095] [duplicate] HID(35 bits) Card NO: (%d)",
-                       card_number);
-        }
-        ret = 1;
-      }
-      // else if(((ep_37bit_sum & 0x01) == 0) && ((op_37bit_sum & 0x01) == 1) &&
-      // (real_44bits_buffer[36] || real_44bits_buffer[37]) &&
-      // (real_44bits_buffer[38] == 0))
-      else if (((ep_37bit_sum & 0x01) == 0) && ((op_37bit_sum & 0x01) == 1) &&
-               (redundant_word_37 == 0x00)) {
-        card_number = 0;
-        for (i = 1; i < 20; i++)
-          card_number |= (real_44bits_buffer[i] << (i - 1));
-        /* with facility code, H10304 */
-        if (card_number != pre_card_number) {
-          NRF_LOG_INFO("[em4095] HID(37 bits) Card NO: (%d)", card_number);
-        } else {
-          NRF_LOG_INFO("[em4095] [duplicate] HID(37 bits) Card NO: (%d)",
-                       card_number);
-        }
-        ret = 1;
-      } else {
-        NRF_LOG_INFO("[em4095] HID CRC failed!)");
-      }
-    }
-#if 0
-    /* removed it due to show this message when no card nearby */
-    else
-    {
+  /* k_uptime_get() 開機後第一毫秒是 0，和空的 entry 分不出來 */
+  if (event.timestamp == 0) event.timestamp = 1;
+  if (em4095_card_seen(type, code, event.timestamp)) {
+    em4095_stats.duplicates++;
+    return;
+  }
+  if (k_msgq_put(&em4095_card_msgq, &event, K_NO_WAIT) != 0) {
+    em4095_stats.dropped++;
+  }
+}
 
-        NRF_LOG_INFO("[em4095] failed to find heeader (%d)", threadhold);
-    }
-#endif
+static unsigned short em4095_hid_report(enum EM4095_HID_RESULT result,
+                                        const em4095_hid_card_t* card) {
+  if (result == EM4095_HID_NO_FRAME) return 0;
+
+  if (result != EM4095_HID_OK) {
+    NRF_LOG_INFO("[em4095] HID CRC failed!)");
+    return 0;
   }
-  return ret;
+  em4095_report_card(EM4095_CARD_HID, card->bits, card->card_number);
+  return 1;
 }
 
 #endif /* #ifdef EM4095_FSK_DETECTION */
@@ -816,6 +622,13 @@ int em4095_enable(void) {
   if (err != 0) {
     return err;
   }
+  /* FSK 與 ASK 都用雙邊緣觸發採樣，再由 em4095_classify() 判斷 */
+  em4095_set_trigger_mode(ASK);
+  /* 每次 start 都從空的 cache 開始，上次看過的卡也要回報 */
+  memset(em4095_seen, 0, sizeof(em4095_seen));
+  /* 統計裡的 decode 時間用 DWT cycle counter 量 */
+  timing_init();
+  timing_start();
 #endif /* #ifdef EM4095_FSK_DETECTION */
   em4095_shd_emit_rf();
   return 0;
@@ -935,193 +748,14 @@ unsigned short em4095_clk_check(void) {
   return result;
 }
 
-#define DEBUG_EM4095 1
-
-// 根據您的 Log 調整的數值
-#define EM_SHORT_MIN 3000
-#define EM_SHORT_MAX 4800
-#define EM_LONG_MIN 6500
-#define EM_LONG_MAX 9000
-
-void clean_glitches(uint16_t count) {
-  for (int i = 1; i < count - 1; i++) {
-    if (tick_buffer[i] > 0 && tick_buffer[i] < 1500) {
-      // 合併極短雜訊
-      tick_buffer[i + 1] += tick_buffer[i];
-      tick_buffer[i] = 0;
-    }
-  }
-}
-
-void decode_bitstream(uint16_t total_ticks, uint8_t* out_bits, int* out_len) {
-  int bit_idx = 0;
-  uint8_t current_val = 1;  // 假設 Header 為 1
-  int state = 0;
-
-  memset(out_bits, 0, 300);
-  *out_len = 0;
-
-  for (int i = 0; i < total_ticks; i++) {
-    uint32_t T = tick_buffer[i];
-    if (T == 0) continue;
-
-    if (T > EM_LONG_MIN && T < EM_LONG_MAX) {
-      // Long Pulse: 翻轉數值 (例如 0->1 或 1->0)
-      if (state == 1) state = 0;  // 重置狀態
-      current_val = !current_val;
-      if (bit_idx < 300) out_bits[bit_idx++] = current_val;
-      state = 0;
-    } else if (T > EM_SHORT_MIN && T < EM_SHORT_MAX) {
-      // Short Pulse: 保持數值
-      if (state == 0) {
-        state = 1;  // 等待第二個 Short
-      } else {
-        // 第二個 Short 到達，確認一個 Bit
-        if (bit_idx < 300) out_bits[bit_idx++] = current_val;
-        state = 0;
-      }
-    } else {
-      // 異常長度，重置狀態
-      state = 0;
-    }
-  }
-  *out_len = bit_idx;
-}
-
-/* 3. 校驗與解碼 */
-int check_and_decode(uint8_t* bits, uint64_t* result) {
-  uint8_t data[64];
-
-  // Header Check
-  for (int k = 0; k < 9; k++)
-    if (bits[k] != 1) return 0;
-  // Stop Bit
-  if (bits[63] != 0) return 0;
-
-  // Copy
-  for (int k = 0; k < 64; k++) data[k] = bits[k];
-
-  // Parity Check (Full Matrix)
-  uint8_t col_p[4] = {0};
-  for (int r = 0; r < 10; r++) {
-    int base = 9 + r * 5;
-    int row_sum = 0;
-    for (int c = 0; c < 4; c++) {
-      row_sum += data[base + c];
-      col_p[c] += data[base + c];
-    }
-    if ((row_sum + data[base + 4]) % 2 != 0) return 0;
-  }
-  for (int c = 0; c < 4; c++) {
-    if ((col_p[c] + data[59 + c]) % 2 != 0) return 0;
-  }
-
-  // Decode
-  *result = 0;
-  for (int j = 0; j < 10; j++) {
-    uint64_t digit = (data[9 + 5 * j] << 3) | (data[9 + 5 * j + 1] << 2) |
-                     (data[9 + 5 * j + 2] << 1) | (data[9 + 5 * j + 3] << 0);
-    *result |= (digit << (4 * (9 - j)));
-  }
-  return 1;
-}
-
-int EM4100_Full_Check(uint8_t* bits) {
-  // 檢查 Header (9個1)
-  for (int i = 0; i < 9; i++)
-    if (bits[i] != 1) return 0;
-  // 檢查 Stop Bit (1個0)
-  if (bits[63] != 0) return 0;
-
-  uint8_t col_parity_calc[4] = {0};
-
-  // 檢查 Row Parity
-  for (int row = 0; row < 10; row++) {
-    int base = 9 + row * 5;
-    int row_sum = 0;
-    for (int col = 0; col < 4; col++) {
-      uint8_t val = bits[base + col];
-      row_sum += val;
-      col_parity_calc[col] += val;
-    }
-    // 偶同位檢查
-    if ((row_sum + bits[base + 4]) % 2 != 0) return 0;
-  }
-
-  // 檢查 Column Parity
-  for (int col = 0; col < 4; col++) {
-    if ((col_parity_calc[col] + bits[59 + col]) % 2 != 0) return 0;
-  }
-  return 1;  // 校驗通過
-}
-
-/* 4. 卡號轉換函式 (您缺失的部分) */
-uint64_t decode_card_code(uint8_t* bits) {
-  uint64_t code = 0;
-  for (int j = 0; j < 10; j++) {
-    unsigned int digit = (bits[9 + 5 * j] << 3) | (bits[9 + 5 * j + 1] << 2) |
-                         (bits[9 + 5 * j + 2] << 1) |
-                         (bits[9 + 5 * j + 3] << 0);
-    code |= ((uint64_t)digit << (4 * (9 - j)));
-  }
-  /*total 40 bits, 保留最後 32 bits (8個 Hex)，過濾掉前面的 Customer ID*/
-  return (code & 0xFFFFFFFF);
-}
-
-/* 4. 主接收函式 */
+/* 4. 主接收函式：EM4100 已在採樣時由 demod_gpio_handler 解完 */
 unsigned short em4095_em_receiver_ppi(void) {
-  uint8_t raw_bits[350];
-  int raw_bit_count = 0;
-
-  // PPI 採樣
-  em4095_set_trigger_mode(ASK);
-  memset(tick_buffer, 0, TICK_BUFFER_SIZE * sizeof(uint32_t));
-
-  em4095_timer_enable();
-  em4095_timer_expired = 0;
-  demod_counter = 0;
-
-  em4095_gpio_sampling_enable();
+  if (!em4100_decoder.found) return 0;
 
-  nrf_delay_ms(120);
-  em4095_gpio_sampling_disable();
-  em4095_timer_disable();
-
-  em4095_set_trigger_mode(FSK);
-
-  if (demod_counter < 64) return 0;
-
-  clean_glitches(demod_counter);
-
-  // 解碼
-  decode_bitstream(demod_counter, raw_bits, &raw_bit_count);
-
-  if (raw_bit_count < 64) return 0;
-
-  // 搜尋卡號
-  for (int i = 0; i <= raw_bit_count - 64; i++) {
-    // 檢查 Header (九個 1)
-    int header_match = 1;
-    for (int k = 0; k < 9; k++)
-      if (raw_bits[i + k] != 1) {
-        header_match = 0;
-        break;
-      }
-    if (!header_match) continue;
-
-    // 提取 64 bits
-    for (int k = 0; k < 64; k++) data_valid[k] = raw_bits[i + k];
-
-    // 執行校驗
-    if (EM4100_Full_Check(data_valid) == 1) {
-      em_card_code = decode_card_code(data_valid);
-      NRF_LOG_INFO("[em4095] Card Found: (%010llu)", em_card_code);
-      tone_em4095_detected();
-      return 1;
-    }
-  }
-
-  return 0;
+  /*total 40 bits, 保留最後 32 bits (8個 Hex)，過濾掉前面的 Customer ID*/
+  em_card_code = em4100_decoder.code & 0xFFFFFFFF;
+  em4095_report_card(EM4095_CARD_EM4100, 40, em4100_decoder.code);
+  return 1;
 }
 
 void em4095_em_receiver(void) {
@@ -1310,6 +944,78 @@ void em4095_em_receiver(void) {
   k_thread_priority_set(current_tid, old_prio);
 }
 
+#ifdef EM4095_FSK_DETECTION
+/* window_cycles 為 k_cycle_get_32() (nRF52 上是 32.768KHz 的 RTC，約 30us
+ * 一格，夠量 120ms 的視窗)；decode 只有幾百 us，用 timing_counter_get()
+ * (Cortex-M DWT CYCCNT) 量 */
+static void em4095_update_stats(enum EM4095_MODULATION modulation,
+                                bool hid_ok, uint32_t window_cycles,
+                                uint64_t decode_ns) {
+  uint32_t decode_us = (uint32_t)(decode_ns / NSEC_PER_USEC);
+
+  em4095_stats.windows++;
+  if (modulation == EM4095_MOD_FSK) {
+    em4095_stats.fsk++;
+  } else if (modulation == EM4095_MOD_ASK) {
+    em4095_stats.ask++;
+  } else {
+    em4095_stats.none++;
+  }
+  if (hid_ok) em4095_stats.hid_reads++;
+  if (em4100_decoder.found) em4095_stats.em_reads++;
+  em4095_stats.window_us_total += k_cyc_to_us_floor32(window_cycles);
+  em4095_stats.decode_us_total += decode_us;
+  if (decode_us > em4095_stats.decode_us_max) {
+    em4095_stats.decode_us_max = decode_us;
+  }
+}
+
+void em4095_get_stats(em4095_stats_t* stats) { *stats = em4095_stats; }
+
+void em4095_reset_stats(void) {
+  memset(&em4095_stats, 0, sizeof(em4095_stats));
+}
+
+int em4095_replay(uint32_t iterations, em4095_replay_t* result) {
+  uint64_t classify_cycles = 0, hid_cycles = 0, em_cycles = 0;
+
+  if ((tick_count == 0) || (iterations == 0)) return -ENODATA;
+
+  timing_init();
+  timing_start();
+  memset(result, 0, sizeof(*result));
+  result->edges = tick_count;
+  result->iterations = iterations;
+  for (uint32_t n = 0; n < iterations; n++) {
+    timing_t t0 = timing_counter_get();
+    enum EM4095_MODULATION modulation =
+        em4095_classify(tick_buffer, tick_count);
+    timing_t t1 = timing_counter_get();
+    enum EM4095_HID_RESULT hid_result =
+        em4095_hid_decode(tick_buffer, tick_count, &result->hid_card);
+    timing_t t2 = timing_counter_get();
+    bool em_found = em4100_decode_ticks(tick_buffer, tick_count,
+                                        &result->em_code);
+    timing_t t3 = timing_counter_get();
+
+    classify_cycles += timing_cycles_get(&t0, &t1);
+    hid_cycles += timing_cycles_get(&t1, &t2);
+    em_cycles += timing_cycles_get(&t2, &t3);
+    result->modulation = modulation;
+    if (hid_result == EM4095_HID_OK) result->hid_reads++;
+    if (em_found) result->em_reads++;
+  }
+  result->classify_cycles = (uint32_t)(classify_cycles / iterations);
+  result->hid_cycles = (uint32_t)(hid_cycles / iterations);
+  result->em_cycles = (uint32_t)(em_cycles / iterations);
+  result->classify_ns =
+      (uint32_t)timing_cycles_to_ns_avg(classify_cycles, iterations);
+  result->hid_ns = (uint32_t)timing_cycles_to_ns_avg(hid_cycles, iterations);
+  result->em_ns = (uint32_t)timing_cycles_to_ns_avg(em_cycles, iterations);
+  return 0;
+}
+#endif /* #ifdef EM4095_FSK_DETECTION */
+
 // main program
 void em4095_receiver(void) {
   if (em4095_reboot) {
@@ -1322,20 +1028,55 @@ void em4095_receiver(void) {
     NRF_LOG_INFO("[em4095] RESET!");
   }
 #ifdef EM4095_FSK_DETECTION
-  unsigned short result = em4095_hid_receiver();
-  if (!result) {
-    // NRF_LOG_INFO("[em4095] Trying use em!");
-    //  int result = em4095_clk_check();
-    //  NRF_LOG_INFO("[em4095] Check clk = %d!", result);
-    em4095_em_receiver_ppi();
+  /* 只開一個 toggle 觸發的視窗，EM4100 邊收邊解，其餘交給分類器 */
+  enum EM4095_MODULATION modulation;
+  enum EM4095_HID_RESULT hid_result = EM4095_HID_NO_FRAME;
+  em4095_hid_card_t hid_card;
+  bool overrun;
+  uint32_t start = k_cycle_get_32();
+
+  em4100_decoder_reset(&em4100_decoder);
+  tick_count = em4095_capture_window(EM4095_CAPTURE_WINDOW_MS, &overrun);
+
+  uint32_t captured = k_cycle_get_32();
+  timing_t decode_start = timing_counter_get();
+  if (overrun) {
+    /* 少了 edge 的 tick_buffer 解不出可信的卡號，整個視窗丟掉 */
+    em4095_stats.overruns++;
+    em4100_decoder.found = false;
+    modulation = EM4095_MOD_NONE;
+  } else if (em4100_decoder.found) {
+    modulation = EM4095_MOD_ASK;
   } else {
-    // tone_em4095_detected();
-    em4095_detected = 1;
+    modulation = em4095_classify(tick_buffer, tick_count);
+  }
+  if (modulation == EM4095_MOD_FSK) {
+    hid_result = em4095_hid_decode(tick_buffer, tick_count, &hid_card);
+  }
+  timing_t decode_end = timing_counter_get();
+  em4095_update_stats(
+      modulation, hid_result == EM4095_HID_OK, captured - start,
+      timing_cycles_to_ns(timing_cycles_get(&decode_start, &decode_end)));
+
+  switch (modulation) {
+    case EM4095_MOD_FSK:
+      if (em4095_hid_report(hid_result, &hid_card)) {
+        // tone_em4095_detected();
+        em4095_detected = 1;
 #ifdef EM4095_SHD_HW_MOD
-    em4095_reboot = 1;
-    /* need 25-35ms for PLL stable */
+        em4095_reboot = 1;
+        /* need 25-35ms for PLL stable */
 #endif /* EM4095_SHD_HW_MOD */
-       /* reset em4095 again due to sometimes incorrect behavior */
+        /* reset em4095 again due to sometimes incorrect behavior */
+      }
+      break;
+
+    case EM4095_MOD_ASK:
+      em4095_em_receiver_ppi();
+      break;
+
+    default:
+      break;
   }
 #else /* #ifdef EM4095_FSK_DETECTION */
   em4095_em_receiver();
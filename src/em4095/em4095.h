@@ -13,8 +13,10 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
 
 #include "buzzer.h"
+#include "em4095_decode.h"
 // #define PORT_IRQ              PORT0
 // #define PORT_VEN              PORT0
 // #define PIN_IRQ               6 // P0.6 <- P1.010
@@ -42,11 +44,37 @@
     printk("\n");         \
   } while (0);
 
+#ifndef CONFIG_EM4095_CARD_HOLDOFF_MS
+#define CONFIG_EM4095_CARD_HOLDOFF_MS 1000
+#endif
+#ifndef CONFIG_EM4095_CARD_CACHE_SIZE
+#define CONFIG_EM4095_CARD_CACHE_SIZE 4
+#endif
+#ifndef CONFIG_EM4095_EVENT_QUEUE_DEPTH
+#define CONFIG_EM4095_EVENT_QUEUE_DEPTH 8
+#endif
+
 enum PPI_TRIGGER_MODE {
   FSK,
   ASK,
 };
 
+enum EM4095_CARD_TYPE {
+  EM4095_CARD_EM4100,
+  EM4095_CARD_HID,
+};
+
+/* 放進 em4095_card_msgq 的讀卡事件，hold-off 內重複的卡不會再放 */
+typedef struct em4095_card_event {
+  int64_t timestamp; /* k_uptime_get() */
+  uint64_t code;     /* EM4100: 40-bit 卡號, HID: card number */
+  uint8_t type;      /* enum EM4095_CARD_TYPE */
+  uint8_t bits;      /* HID 格式 26 / 35 / 37，EM4100 為 40 */
+} em4095_card_event_t;
+
+/* reader thread 只用 K_NO_WAIT 放入，consumer 用 k_msgq_get() 取出 */
+extern struct k_msgq em4095_card_msgq;
+
 void em4095_receiver(void);
 int em4095_gpio_init(void);
 int em4095_enable(void);
@@ -62,4 +90,45 @@ unsigned short em4095_demod_check(void);
 int em4095_timer3_init(void);
 void em4095_timer3_deinit(void);
 
+/* reader thread 的統計，decode 為視窗結束後分類 + HID 解碼的時間
+ * (EM4100 在 ISR 裡邊收邊解，不算在內) */
+typedef struct em4095_stats {
+  uint32_t windows; /* 採樣視窗數 */
+  uint32_t fsk;     /* 分類結果 */
+  uint32_t ask;
+  uint32_t none;
+  uint32_t hid_reads; /* 解碼成功次數 */
+  uint32_t em_reads;
+  uint32_t duplicates; /* hold-off 內重複讀到，沒有放進 queue */
+  uint32_t dropped;    /* em4095_card_msgq 滿了被丟掉 */
+  uint32_t overruns;   /* ISR 跟不上 edge (CC0 被覆蓋)，視窗整個丟掉 */
+  uint32_t window_us_total;
+  uint32_t decode_us_total;
+  uint32_t decode_us_max;
+} em4095_stats_t;
+
+/* em4095_replay() 的結果，cycles 為每次的平均 CPU cycle 數
+ * (timing_counter_get()，nRF52840 上是 64MHz 的 DWT CYCCNT)，ns 為換算後的時間 */
+typedef struct em4095_replay {
+  uint32_t iterations;
+  uint16_t edges; /* tick_buffer 中的 edge 數 */
+  enum EM4095_MODULATION modulation;
+  uint32_t hid_reads;
+  uint32_t em_reads;
+  em4095_hid_card_t hid_card;
+  uint64_t em_code;
+  uint32_t classify_cycles;
+  uint32_t hid_cycles;
+  uint32_t em_cycles;
+  uint32_t classify_ns;
+  uint32_t hid_ns;
+  uint32_t em_ns;
+} em4095_replay_t;
+
+void em4095_get_stats(em4095_stats_t* stats);
+void em4095_reset_stats(void);
+/* 用最後一個採樣視窗的 tick_buffer 重跑解碼 iterations 次，
+ * 呼叫前 reader thread 必須已經停止 */
+int em4095_replay(uint32_t iterations, em4095_replay_t* result);
+
 #endif /* #ifndef __em4095_H_ */
\ No newline at end of file
@@ -0,0 +1,370 @@
+/*
+ * EM4095 解碼 (不含 nrfx TIMER/GPIOTE 採樣)
+ *
+ * 輸入都是 em4095.c 採樣得到的 tick_buffer：toggle 觸發下兩個 edge 之間的
+ * TIMER3 tick 數 (16MHz)。這裡只用到 C 標準函式庫，可以直接拿錄下來的
+ * tick_buffer 重播，量測解碼成功率與耗時 (見 em4095_replay())。
+ * native_sim 上的測試在 tests/em4095。
+ */
+#include "em4095_decode.h"
+
+#include <string.h>
+
+#define MIN_U16(a) (((a) > UINT16_MAX) ? UINT16_MAX : (uint16_t)(a))
+
+/* 原本是 0x480 (1152) */
+/* FSK '0' 約 975 ticks, FSK '1' 約 1220 ticks */
+/* 中間值約 1097, 設定為 1100 以獲得最佳平衡 */
+#define MIN_FSK_1_TICK 0x44C /* 1/12.5KHz = 80us, 1280 ticks when 16MHz */
+#define NOISE_GLITCH_THRESHOLD 200
+
+#define FSK_HALF_GLITCH_TICK (NOISE_GLITCH_THRESHOLD / 2)
+
+static uint8_t fsk_bit_buffer[FSK_PERIOD_SIZE];
+static uint8_t data_buf[96 - 6];
+static uint8_t real_44bits_buffer[44];
+
+/* 用半週期寬度分布判斷調變方式：
+ * FSK 半週期約 32-40us，EM4100 (RF/64) 則是 256/512us */
+enum EM4095_MODULATION em4095_classify(const uint16_t* ticks, uint16_t count) {
+  uint16_t fsk_count = 0, ask_count = 0;
+
+  /* ticks[0] 是從開視窗到第一個 edge 的時間，不算 */
+  for (uint16_t i = 1; i < count; i++) {
+    uint16_t tick = ticks[i];
+    if (tick < FSK_HALF_TICK_MAX) {
+      fsk_count++;
+    } else if ((tick > EM4100_SHORT_MIN) && (tick < EM4100_LONG_MAX)) {
+      ask_count++;
+    }
+  }
+  if ((fsk_count >= FSK_PERIOD_SIZE) && (fsk_count > ask_count)) {
+    return EM4095_MOD_FSK;
+  }
+  /* 有 ASK 波形 (是否解出合法 frame 由 em4100_decoder 決定) */
+  if (ask_count >= 64) return EM4095_MOD_ASK;
+  return EM4095_MOD_NONE;
+}
+
+/* 一個整週期判斷成 FSK bit；比 NOISE_GLITCH_THRESHOLD 短的週期當作雜訊，
+ * 記在 *accumulated 併入下一個週期 */
+static uint8_t em4095_fsk_bit(uint16_t period, uint32_t* accumulated) {
+  uint32_t current_val = period + *accumulated;
+
+  *accumulated = 0;
+  if (current_val < NOISE_GLITCH_THRESHOLD) {
+    /* 這是一個雜訊！不要判斷它 (之後判斷 header 會自動忽略) */
+    *accumulated = current_val;
+    return 0;
+  }
+  return (period > MIN_FSK_1_TICK) ? 1 : 0;
+}
+
+/* 把 toggle 觸發的半週期兩兩合併成整週期，逐個判斷成 FSK bit 寫到 bits。
+ * 整週期不另外存，ticks 也不會被改動，同一份 tick_buffer 可以重播。
+ * 雜訊在 toggle 模式下一定是成對的兩個 edge，把極短的那格連同下一格
+ * 併回目前的半週期。回傳整週期 (bit) 的數量 */
+uint16_t em4095_fsk_bits(const uint16_t* ticks, uint16_t count,
+                         uint8_t* bits) {
+  uint16_t n = 0;
+  uint32_t acc = 0, glitch = 0;
+  uint8_t halves = 0;
+
+  /* ticks[0] 是從開視窗到第一個 edge 的時間，不算 */
+  for (uint16_t i = 1; i < count; i++) {
+    if ((ticks[i] < FSK_HALF_GLITCH_TICK) && (i + 1 < count)) {
+      acc += ticks[i] + ticks[i + 1];
+      i++;
+      continue;
+    }
+    if (halves == 2) {
+      bits[n++] = em4095_fsk_bit(MIN_U16(acc), &glitch);
+      acc = 0;
+      halves = 0;
+      if (n >= FSK_PERIOD_SIZE) return n;
+    }
+    acc += ticks[i];
+    halves++;
+  }
+  return n;
+}
+
+bool em4100_decode_ticks(const uint16_t* ticks, uint16_t count,
+                         uint64_t* code) {
+  em4100_decoder_t dec;
+
+  em4100_decoder_reset(&dec);
+  for (uint16_t i = 0; i < count; i++) {
+    if (em4100_decoder_feed(&dec, ticks[i])) {
+      *code = dec.code;
+      return true;
+    }
+  }
+  return false;
+}
+
+enum EM4095_HID_RESULT em4095_hid_decode(const uint16_t* ticks,
+                                         uint16_t count,
+                                         em4095_hid_card_t* card) {
+  /* 1. confirm FSK signal
+   * 2. open detection windows to detect 0x1D(detect 18 times 15.625KHz square
+   * wave) 1 bit 400us, needs (96+8) * 400 = 41.60ms should be detect one time
+   * at least in 42 ms if get 0x1D, should be detect one time to receive all
+   * data again.
+   * 3. timer interrupt service to detect fsk 0 and fsk 1
+   *    fsk 0 : 15.625KHz * 6 (64us * 6 = 384us) -> 63.36-64.64 us
+   *    fsk 1 : 12.5KHz * 5 (80us * 5 = 400us) -> 79.2-80.8 us
+   *
+   */
+  uint16_t i;
+  uint32_t redundant_word_26 = 0, redundant_word_35 = 0, redundant_word_37 = 0;
+  uint8_t fsk_bit_0_counter, fsk_bit_1_counter, data_bit_count;
+  uint16_t header_position;
+  uint16_t ep_sum, op_sum;
+  uint16_t ep_35bit_sum, op_35bit_sum_all, op_35bit_sum;
+  uint16_t ep_37bit_sum, op_37bit_sum;
+  enum EM4095_HID_RESULT ret = EM4095_HID_NO_FRAME;
+
+  card->bits = 0;
+  card->card_number = 0;
+
+  /* 42 ms timer test */
+  /* need to find 0x1D(0x0001 1101), means 18*fsk_0 and 15*fsk_1 at least */
+  memset(fsk_bit_buffer, 0, sizeof(fsk_bit_buffer));
+  count = em4095_fsk_bits(ticks, count, fsk_bit_buffer);
+  if (count >= (FSK_PERIOD_SIZE / 2)) {
+#if 0
+        /* decision adjustment */
+        //NRF_LOG_INFO("[em4095] HID DETECTED!!!"); 
+        uint16_t queue_data_1[64], queue_data_2[22];
+        uint16_t queue_1_index = 0, queue_2_index = 0;
+        
+        for(i = 10; i < TICK_BUFFER_SIZE; i++)
+        {
+            if((fsk_period_buffer[i] > 800) && (fsk_period_buffer[i] < 1500))
+            {
+                queue_data_1[queue_1_index++] = fsk_period_buffer[i];
+                if(queue_1_index >= 64)
+                {
+                    break;
+                }
+            }
+        }
+        threadhold = 0;
+        for(i = 0; i < 64; i++)
+        {
+            threadhold += queue_data_1[i];
+        }
+        threadhold >>= 6;
+        uint8_t pre_bit = 0;
+        queue_1_index = 0;
+        for(i = 1; i < TICK_BUFFER_SIZE; i++)
+        {
+            if(fsk_period_buffer[i] > 1500)
+            {
+                if(pre_bit)
+                {
+                    fsk_bit_buffer[queue_1_index++] = 1;
+                    fsk_bit_buffer[queue_1_index++] = 0;
+                }
+                else
+                {
+                    fsk_bit_buffer[queue_1_index++] = 0;
+                    fsk_bit_buffer[queue_1_index++] = 1;                    
+                }
+            }
+            else if(fsk_period_buffer[i] > threadhold)
+            {
+                fsk_bit_buffer[queue_1_index++] = 1;
+                pre_bit = 1;
+                //queue_1_index++;
+            }
+
+            else
+            {
+                fsk_bit_buffer[queue_1_index++] = 0;
+                pre_bit = 0;
+                //queue_1_index++;
+            }
+            if(queue_1_index>=TICK_BUFFER_SIZE)
+            {
+                break;
+            }
+        }
+#else
+    /* 整週期已經在 em4095_fsk_bits() 判斷成 fsk_bit_buffer */
+#endif
+    /* search header */
+    // NRF_LOG_INFO("[em4095] search header...");
+    fsk_bit_0_counter = 0;
+    fsk_bit_1_counter = 1;
+    header_position = 0;
+    memset(data_buf, 0xFF, sizeof(data_buf));
+    for (i = 0; i < count; i++) {
+      if (fsk_bit_buffer[i] == 0) {
+        fsk_bit_0_counter++;
+      } else {
+        if (fsk_bit_0_counter >= 14) {
+          header_position = i; /* find the position of first fsk bit 1 */
+          break;
+        } else {
+          fsk_bit_0_counter = 0;
+        }
+      }
+    }
+    if (header_position) {
+      for (i = header_position; i < count; i++) {
+        if (fsk_bit_buffer[i] == 1) {
+          fsk_bit_1_counter++;
+        } else {
+          if (fsk_bit_1_counter >= 13) {
+            header_position =
+                i; /* find the position of the last 2 bit of header */
+            break;
+          } else {
+            fsk_bit_1_counter = 0;
+          }
+        }
+      }
+      data_bit_count = 0;
+      fsk_bit_0_counter = fsk_bit_1_counter = 0;
+      /* decision the fsk bit to data bit */
+      for (i = header_position; i < count; i++) {
+        if (fsk_bit_buffer[i] == 1) {
+          fsk_bit_1_counter++;
+          if (fsk_bit_0_counter >= 4) {
+            if (fsk_bit_0_counter > 8) {
+              data_buf[data_bit_count++] = 0;
+            }
+            data_buf[data_bit_count++] = 0;
+            fsk_bit_0_counter = 0;
+          }
+        } else {
+          fsk_bit_0_counter++;
+          if (fsk_bit_1_counter >= 4) {
+            if (fsk_bit_1_counter > 8) {
+              data_buf[data_bit_count++] = 1;
+            }
+            data_buf[data_bit_count++] = 1;
+            fsk_bit_1_counter = 0;
+          }
+        }
+        if (data_bit_count >= 90) {
+          /* all data received */
+          break;
+        }
+      }
+#if 0
+     for(i = 0; i < 26; i++)
+     {
+        original_data[0] |= (data_buf[i] << (25-i));
+     }
+     for(i = 26; i < 58; i++)
+     {
+        original_data[1] |= (data_buf[i] << (57-i));
+     }
+     for(i = 58; i < 90; i++)
+     {
+        original_data[2] |= (data_buf[i] << (89-i));
+     }
+     NRF_LOG_INFO("[em4095] HID card was detected!(0x%8X)(0x%8X)(0x%8X)", original_data[0], original_data[1], original_data[2]);
+#endif
+      memset(real_44bits_buffer, 0xFF, sizeof(real_44bits_buffer));
+      for (i = 0; i < 88; i += 2) {
+        real_44bits_buffer[43 - i / 2] = i + 1;
+        if ((data_buf[2 + i] == 0) && (data_buf[2 + i + 1] == 1)) {
+          real_44bits_buffer[43 - i / 2] = 0;
+        } else if ((data_buf[2 + i] == 1) && (data_buf[2 + i + 1] == 0)) {
+          real_44bits_buffer[43 - i / 2] = 1;
+        } else {
+          /* should not happen break! */
+          // printk("should not happen break!\n");
+          return EM4095_HID_NO_FRAME;
+        }
+      }
+
+      /* parity check */
+      // NRF_LOG_INFO("[em4095] parity check...");
+      /* HID 10302 */
+      ep_sum = 0;
+      op_sum = 0;
+      /* should be 0 if even parity check */
+      for (i = 13; i < 26; i++) ep_sum += (real_44bits_buffer[i] & 0x01);
+      /* should be 1 if odd parity check */
+      for (i = 0; i < 13; i++) op_sum += (real_44bits_buffer[i] & 0x01);
+      /* 18 bits, 0x00801 */
+      for (i = 26; i < 44; i++) {
+        redundant_word_26 |= (real_44bits_buffer[i] << (i - 26));
+      }
+      /* corp 1000 35bits */ /* 34-0 */
+      ep_35bit_sum = op_35bit_sum_all = op_35bit_sum = 0;
+      ep_35bit_sum = real_44bits_buffer[33];
+      op_35bit_sum = real_44bits_buffer[0];
+      for (i = 1; i < 34; i += 3) {
+        ep_35bit_sum += (real_44bits_buffer[i] + real_44bits_buffer[i + 1]);
+        op_35bit_sum += (real_44bits_buffer[i + 1] + real_44bits_buffer[i + 2]);
+      }
+      for (i = 0; i < 35; i += 1) {
+        op_35bit_sum_all += real_44bits_buffer[0];
+      }
+      /* 9 bits, 0x005 */
+      for (i = 35; i < 44; i++) {
+        redundant_word_35 |= (real_44bits_buffer[i] << (i - 35));
+      }
+      /* HID H10304 or H10302 */
+      ep_37bit_sum = 0;
+      op_37bit_sum = 0;
+      for (i = 18; i < 37; i++) ep_37bit_sum += (real_44bits_buffer[i] & 0x01);
+      for (i = 0; i < 19; i++) op_37bit_sum += (real_44bits_buffer[i] & 0x01);
+      /* 7 bits, 0x00 */
+      for (i = 37; i < 44; i++) {
+        redundant_word_37 |= (real_44bits_buffer[i] << (i - 35));
+      }
+
+      /* show result */
+      // if(((ep_sum & 0x01) == 0) && ((op_sum & 0x01) == 1) &&
+      // (real_44bits_buffer[25] || real_44bits_buffer[26]) &&
+      // (real_44bits_buffer[27] == 0))
+      ret = EM4095_HID_CRC_FAILED;
+      if (((ep_sum & 0x01) == 0) && ((op_sum & 0x01) == 1) &&
+          (redundant_word_26 == 0x0801)) {
+        for (i = 1; i < 17; i++)
+          card->card_number |= (real_44bits_buffer[i] << (i - 1));
+        card->bits = 26;
+        ret = EM4095_HID_OK;
+      }
+      // else if(((ep_35bit_sum & 0x01) == 0) && ((op_35bit_sum & 0x01) == 1) &&
+      // ((op_35bit_sum_all & 0x01) == 1))
+      else if (((ep_35bit_sum & 0x01) == 0) && ((op_35bit_sum & 0x01) == 1) &&
+               ((op_35bit_sum_all & 0x01) == 1) &&
+               (redundant_word_35 == 0x005)) {
+        for (i = 1; i < 21; i++)
+          card->card_number |= (real_44bits_buffer[i] << (i - 1));
+        /* with facility code, H10304 */
+        card->bits = 35;
+        ret = EM4095_HID_OK;
+      }
+      // else if(((ep_37bit_sum & 0x01) == 0) && ((op_37bit_sum & 0x01) == 1) &&
+      // (real_44bits_buffer[36] || real_44bits_buffer[37]) &&
+      // (real_44bits_buffer[38] == 0))
+      else if (((ep_37bit_sum & 0x01) == 0) && ((op_37bit_sum & 0x01) == 1) &&
+               (redundant_word_37 == 0x00)) {
+        for (i = 1; i < 20; i++)
+          card->card_number |= (real_44bits_buffer[i] << (i - 1));
+        /* with facility code, H10304 */
+        card->bits = 37;
+        ret = EM4095_HID_OK;
+      }
+    }
+#if 0
+    /* removed it due to show this message when no card nearby */
+    else
+    {
+
+        NRF_LOG_INFO("[em4095] failed to find heeader (%d)", threadhold);
+    }
+#endif
+  }
+  return ret;
+}
+
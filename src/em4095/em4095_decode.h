@@ -0,0 +1,49 @@
+#ifndef __em4095_decode_H_
+
+#define __em4095_decode_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "em4100_decoder.h"
+
+/* toggle 觸發，每個 FSK 週期佔兩格 (半週期)；解 HID 前兩兩合併回整週期 */
+#define FSK_PERIOD_SIZE ((96 * 2 + 8) * 6) /* 1200 */
+#define TICK_BUFFER_SIZE (FSK_PERIOD_SIZE * 2)
+
+/* 半週期寬度 (16MHz ticks)：FSK 約 512/640，EM4100 約 4096/8192 */
+#define FSK_HALF_TICK_MAX 2000
+
+enum EM4095_MODULATION {
+  EM4095_MOD_NONE,
+  EM4095_MOD_FSK, /* HID */
+  EM4095_MOD_ASK, /* EM4100 */
+};
+
+enum EM4095_HID_RESULT {
+  EM4095_HID_NO_FRAME,   /* 找不到 header 或 Manchester 錯誤 */
+  EM4095_HID_CRC_FAILED, /* 收到完整 frame 但 parity 不符 */
+  EM4095_HID_OK,
+};
+
+typedef struct em4095_hid_card {
+  uint8_t bits; /* 26 / 35 / 37 */
+  uint32_t card_number;
+} em4095_hid_card_t;
+
+enum EM4095_MODULATION em4095_classify(const uint16_t* ticks, uint16_t count);
+
+/* bits 至少要 FSK_PERIOD_SIZE 格，回傳寫入的 bit 數 */
+uint16_t em4095_fsk_bits(const uint16_t* ticks, uint16_t count,
+                         uint8_t* bits);
+
+/* ticks 為 toggle 觸發的半週期 (會先用 em4095_fsk_bits 合併、判斷) */
+enum EM4095_HID_RESULT em4095_hid_decode(const uint16_t* ticks,
+                                         uint16_t count,
+                                         em4095_hid_card_t* card);
+
+/* 把錄下來的 tick_buffer 逐格餵給 em4100_decoder */
+bool em4100_decode_ticks(const uint16_t* ticks, uint16_t count,
+                         uint64_t* code);
+
+#endif /* #ifndef __em4095_decode_H_ */
@@ -0,0 +1,81 @@
+#include "em4100_decoder.h"
+
+/* 5-bit row (4 data + even parity) 的 parity 表，bit n = popcount(n) & 1 */
+#define EM4100_ROW_PARITY_TABLE 0x96696996UL
+
+void em4100_decoder_reset(em4100_decoder_t* dec) {
+  dec->shift = 0;
+  dec->code = 0;
+  dec->carry = 0;
+  dec->level = 1; /* 假設 Header 為 1 */
+  dec->half = 0;
+  dec->bits = 0;
+  dec->found = false;
+}
+
+/*
+ * EM4100 frame (64 bits)：
+ *   9 bits header (1) | 10 rows * (4 data + 1 even parity) |
+ *   4 bits column parity | 1 stop bit (0)
+ */
+bool em4100_frame_check(uint64_t frame, uint64_t* code) {
+  uint32_t column = 0;
+  uint64_t id = 0;
+
+  if ((frame >> 55) != 0x1FF) return false; /* header */
+  if (frame & 0x01) return false;           /* stop bit */
+
+  for (int row = 0; row < 10; row++) {
+    uint32_t bits = (uint32_t)(frame >> (50 - 5 * row)) & 0x1F;
+    if ((EM4100_ROW_PARITY_TABLE >> bits) & 0x01) return false;
+    column ^= bits >> 1;
+    id = (id << 4) | (bits >> 1);
+  }
+  if (column != ((uint32_t)(frame >> 1) & 0x0F)) return false;
+
+  *code = id;
+  return true;
+}
+
+static bool em4100_decoder_push(em4100_decoder_t* dec, uint8_t bit) {
+  dec->shift = (dec->shift << 1) | bit;
+  if (dec->bits < 64) {
+    dec->bits++;
+    if (dec->bits < 64) return false;
+  }
+  /* 起始 level 是猜的，反相的 bitstream 也一起檢查 */
+  if (em4100_frame_check(dec->shift, &dec->code) ||
+      em4100_frame_check(~dec->shift, &dec->code)) {
+    dec->found = true;
+  }
+  return dec->found;
+}
+
+bool em4100_decoder_feed(em4100_decoder_t* dec, uint32_t ticks) {
+  /* 合併極短雜訊 */
+  ticks += dec->carry;
+  dec->carry = 0;
+  if (ticks < EM4100_GLITCH_TICKS) {
+    dec->carry = ticks;
+    return false;
+  }
+
+  if (ticks > EM4100_LONG_MIN && ticks < EM4100_LONG_MAX) {
+    /* Long Pulse: 翻轉數值 */
+    dec->level ^= 1;
+    dec->half = 0;
+    return em4100_decoder_push(dec, dec->level);
+  }
+  if (ticks > EM4100_SHORT_MIN && ticks < EM4100_SHORT_MAX) {
+    /* Short Pulse: 保持數值，兩個 Short 才確認一個 Bit */
+    if (!dec->half) {
+      dec->half = 1;
+      return false;
+    }
+    dec->half = 0;
+    return em4100_decoder_push(dec, dec->level);
+  }
+  /* 異常長度，重置狀態 */
+  dec->half = 0;
+  return false;
+}
@@ -0,0 +1,45 @@
+#ifndef __em4100_decoder_H_
+
+#define __em4100_decoder_H_
+
+/*
+ * EM4100 串流解碼器
+ *
+ * demod_gpio_handler 每收到一個 edge (ASK, toggle 觸發) 就把兩個 edge 之間的
+ * TIMER3 tick 數 (16MHz) 丟進 em4100_decoder_feed()，解碼器維持 Manchester
+ * 半週期狀態，把解出來的 bit 推進 64-bit shift register，每推一個 bit 就用
+ * 查表做一次 row/column parity 檢查，收滿一個合法 frame 立刻回報。
+ *
+ * 只用到 C 標準型別，不依賴 nrfx / Zephyr。
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* RF/64: 半個 bit 256us (4096 ticks)，一個 bit 512us (8192 ticks) */
+#define EM4100_SHORT_MIN 3000
+#define EM4100_SHORT_MAX 4800
+#define EM4100_LONG_MIN 6500
+#define EM4100_LONG_MAX 9000
+/* 比這個短的 pulse 當作雜訊，併入下一個 edge */
+#define EM4100_GLITCH_TICKS 1500
+
+typedef struct em4100_decoder {
+  uint64_t shift; /* 最近 64 個 bit，最新的在 bit 0 */
+  uint64_t code;  /* 解出的 40-bit 卡號 (10 個 nibble) */
+  uint32_t carry; /* 尚未併入的雜訊 ticks */
+  uint8_t level;  /* 目前的 bit 值 */
+  uint8_t half;   /* 已收到一個 short pulse，等第二個 */
+  uint8_t bits;   /* shift 中有效的 bit 數，最多 64 */
+  bool found;
+} em4100_decoder_t;
+
+void em4100_decoder_reset(em4100_decoder_t* dec);
+
+/* 餵一個 edge 間隔，收到完整且校驗通過的 frame 時回傳 true (可在 ISR 呼叫) */
+bool em4100_decoder_feed(em4100_decoder_t* dec, uint32_t ticks);
+
+/* frame 的 bit 63 為第一個收到的 bit；校驗通過時把 40-bit 卡號寫入 code */
+bool em4100_frame_check(uint64_t frame, uint64_t* code);
+
+#endif /* #ifndef __em4100_decoder_H_ */
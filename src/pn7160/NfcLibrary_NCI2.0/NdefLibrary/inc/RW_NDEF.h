@@ -15,6 +15,8 @@
 #ifndef REMOVE_NDEF_SUPPORT
 
 #define RW_MAX_NDEF_FILE_SIZE 500
+/* Largest tag answer handled by the reader: whole NDEF file plus T4T status word */
+#define RW_MAX_RSP_SIZE (RW_MAX_NDEF_FILE_SIZE + 2)
 
 extern unsigned char NdefBuffer[RW_MAX_NDEF_FILE_SIZE];
 
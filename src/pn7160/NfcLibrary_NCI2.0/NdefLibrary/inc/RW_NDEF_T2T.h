@@ -17,6 +17,11 @@
 void RW_NDEF_T2T_Reset(void);
 void RW_NDEF_T2T_Read_Next(unsigned char *pCmd, unsigned short Cmd_size, unsigned char *Rsp, unsigned short *pRsp_size);
 void RW_NDEF_T2T_Write_Next(unsigned char *pCmd, unsigned short Cmd_size, unsigned char *Rsp, unsigned short *pRsp_size);
+/* true when the tag NAKed GET_VERSION and must be re-activated before the
+ * next RW_NDEF_T2T_Read_Next call */
+bool RW_NDEF_T2T_ReActivateNeeded(void);
+/* true when the last read used NTAG21x FAST_READ */
+bool RW_NDEF_T2T_IsFastRead(void);
 
 #endif
 #endif
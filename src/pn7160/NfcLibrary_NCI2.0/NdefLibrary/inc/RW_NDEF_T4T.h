@@ -17,6 +17,8 @@
 void RW_NDEF_T4T_Reset(void);
 void RW_NDEF_T4T_Read_Next(unsigned char *pCmd, unsigned short Cmd_size, unsigned char *Rsp, unsigned short *pRsp_size);
 void RW_NDEF_T4T_Write_Next(unsigned char *pCmd, unsigned short Cmd_size, unsigned char *Rsp, unsigned short *pRsp_size);
+/* ISO-DEP frame size of the activated card (from FSCI), 0 if unknown */
+void RW_NDEF_T4T_SetFsc(unsigned short Fsc);
 
 #endif
 #endif
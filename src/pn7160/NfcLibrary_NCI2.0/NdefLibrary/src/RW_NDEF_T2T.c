@@ -22,19 +22,41 @@
 
 #define T2T_MAGIC_NUMBER    0xE1
 #define T2T_NDEF_TLV        0x03
+#define T2T_NULL_TLV        0x00
+#define T2T_TERMINATOR_TLV  0xFE
+
+/* NTAG21x commands (NTAG213/215/216 datasheet) */
+#define T2T_GET_VERSION     0x60
+#define T2T_FAST_READ       0x3A
+#define NTAG_VENDOR_NXP     0x04
+#define NTAG_PRODUCT_TYPE   0x04
+
+/* FAST_READ answer (4 bytes per page + NCI status byte) must fit in a single
+ * 255-byte NCI data packet, the largest frame PN7160 hands over to the host */
+#define T2T_FAST_READ_MAX_PAGES 60
+/* First FAST_READ: CC (page 3) + 28 bytes of data area, enough for the
+ * lock/memory control TLVs and the NDEF TLV header */
+#define T2T_FAST_READ_FIRST_PAGES 8
 
 typedef enum
 {
     Initial,
+    Getting_Version,
+    Version_Failed,
     Reading_CC,
     Reading_Data,
     Reading_NDEF,
+    Fast_Reading_Data,
+    Fast_Reading_NDEF,
     Writing_Data
 } RW_NDEF_T2T_state_t;
 
 typedef struct
 {
-    unsigned char BlkNb;
+    unsigned short BlkNb;
+    unsigned short LastBlkNb;
+    unsigned short TlvPtr;
+    unsigned char FastReadPages;
     unsigned short MessagePtr;
     unsigned short MessageSize;
     unsigned char *pMessage;
@@ -42,22 +64,166 @@ typedef struct
 
 static RW_NDEF_T2T_state_t eRW_NDEF_T2T_State = Initial;
 static RW_NDEF_T2T_Ndef_t RW_NDEF_T2T_Ndef;
+static bool RW_NDEF_T2T_ReActivate = false;
+static bool RW_NDEF_T2T_FastRead = false;
 
 void RW_NDEF_T2T_Reset(void)
 {
     eRW_NDEF_T2T_State = Initial;
     RW_NDEF_T2T_Ndef.pMessage = NdefBuffer;
+    RW_NDEF_T2T_ReActivate = false;
+    RW_NDEF_T2T_FastRead = false;
+}
+
+bool RW_NDEF_T2T_ReActivateNeeded(void)
+{
+    return RW_NDEF_T2T_ReActivate;
+}
+
+bool RW_NDEF_T2T_IsFastRead(void)
+{
+    return RW_NDEF_T2T_FastRead;
+}
+
+/* Walk the TLVs in the Size bytes read at offset Base of the data area,
+ * from the one at TlvPtr on. Return the offset in pData of the NDEF message
+ * and set MessageSize, return -1 if there is no NDEF TLV, or -2 if the next
+ * TLV header was not read yet (TlvPtr then gives its offset) */
+static int RW_NDEF_T2T_FindNdef(unsigned char *pData, unsigned short Size, unsigned short Base)
+{
+    unsigned short Tmp;
+
+    /* If not NDEF Type skip TLV */
+    while (RW_NDEF_T2T_Ndef.TlvPtr < (Base + Size))
+    {
+        Tmp = RW_NDEF_T2T_Ndef.TlvPtr - Base;
+        if (pData[Tmp] == T2T_TERMINATOR_TLV) return -1;
+        if (pData[Tmp] == T2T_NULL_TLV)
+        {
+            RW_NDEF_T2T_Ndef.TlvPtr++;
+            continue;
+        }
+        if ((Tmp + 1) >= Size) return -2;
+        if ((pData[Tmp+1] == 0xFF) && ((Tmp + 3) >= Size)) return -2;
+
+        if (pData[Tmp] == T2T_NDEF_TLV)
+        {
+            if(pData[Tmp+1] == 0xFF)
+            {
+                RW_NDEF_T2T_Ndef.MessageSize = (pData[Tmp+2] << 8) + pData[Tmp+3];
+                return Tmp + 4;
+            }
+            RW_NDEF_T2T_Ndef.MessageSize = pData[Tmp+1];
+            return Tmp + 2;
+        }
+
+        if(pData[Tmp+1] == 0xFF) RW_NDEF_T2T_Ndef.TlvPtr += 4 + (pData[Tmp+2] << 8) + pData[Tmp+3];
+        else RW_NDEF_T2T_Ndef.TlvPtr += 2 + pData[Tmp+1];
+    }
+    return -2;
+}
+
+/* Build READ of the 4 blocks holding the next TLV header, return false if
+ * it lies outside of the data area */
+static bool RW_NDEF_T2T_ReadTlv(unsigned char *pCmd, unsigned short *pCmd_size)
+{
+    unsigned short BlkNb = 0x04 + (RW_NDEF_T2T_Ndef.TlvPtr / 4);
+
+    if (BlkNb > RW_NDEF_T2T_Ndef.LastBlkNb) return false;
+
+    RW_NDEF_T2T_Ndef.BlkNb = BlkNb;
+    pCmd[0] = 0x30;
+    pCmd[1] = (unsigned char) BlkNb;
+    *pCmd_size = 2;
+    return true;
+}
+
+/* Store the first NDEF bytes found in the data area, return true if more
+ * bytes are to be read from the tag */
+static bool RW_NDEF_T2T_StartNdef(unsigned char *pData, unsigned short Size)
+{
+    /* If provisioned buffer is not large enough or message is empty, notify the application and stop reading */
+    if ((RW_NDEF_T2T_Ndef.MessageSize > RW_MAX_NDEF_FILE_SIZE) || (RW_NDEF_T2T_Ndef.MessageSize == 0))
+    {
+        if(pRW_NDEF_PullCb != NULL) pRW_NDEF_PullCb(NULL, 0, RW_NDEF_T2T_Ndef.MessageSize);
+        return false;
+    }
+
+    /* Is NDEF read already completed ? */
+    if (RW_NDEF_T2T_Ndef.MessageSize <= Size)
+    {
+        memcpy (RW_NDEF_T2T_Ndef.pMessage, pData, RW_NDEF_T2T_Ndef.MessageSize);
+
+        /* Notify application of the NDEF reception */
+        if(pRW_NDEF_PullCb != NULL) pRW_NDEF_PullCb(RW_NDEF_T2T_Ndef.pMessage, RW_NDEF_T2T_Ndef.MessageSize, RW_NDEF_T2T_Ndef.MessageSize);
+        return false;
+    }
+
+    RW_NDEF_T2T_Ndef.MessagePtr = Size;
+    memcpy (RW_NDEF_T2T_Ndef.pMessage, pData, RW_NDEF_T2T_Ndef.MessagePtr);
+    return true;
+}
+
+/* Build FAST_READ of the next pages still holding NDEF bytes, limited to
+ * the data area and to T2T_FAST_READ_MAX_PAGES */
+static void RW_NDEF_T2T_FastReadNext(unsigned char *pCmd, unsigned short *pCmd_size)
+{
+    unsigned short Left = RW_NDEF_T2T_Ndef.MessageSize - RW_NDEF_T2T_Ndef.MessagePtr;
+    unsigned short Pages = (Left + 3) / 4;
+
+    if (RW_NDEF_T2T_Ndef.BlkNb > RW_NDEF_T2T_Ndef.LastBlkNb) return;
+    if (Pages > T2T_FAST_READ_MAX_PAGES) Pages = T2T_FAST_READ_MAX_PAGES;
+    if ((RW_NDEF_T2T_Ndef.BlkNb + Pages - 1) > RW_NDEF_T2T_Ndef.LastBlkNb)
+        Pages = RW_NDEF_T2T_Ndef.LastBlkNb - RW_NDEF_T2T_Ndef.BlkNb + 1;
+
+    RW_NDEF_T2T_Ndef.FastReadPages = (unsigned char) Pages;
+    pCmd[0] = T2T_FAST_READ;
+    pCmd[1] = RW_NDEF_T2T_Ndef.BlkNb;
+    pCmd[2] = RW_NDEF_T2T_Ndef.BlkNb + Pages - 1;
+    *pCmd_size = 3;
 }
 
 void RW_NDEF_T2T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigned char *pCmd, unsigned short *pCmd_size)
 {
+    int Tmp;
+
     /* By default no further command to be sent */
     *pCmd_size = 0;
 
     switch(eRW_NDEF_T2T_State)
     {
     case Initial:
-        /* Read CC */
+        /* Identify NTAG21x, supporting FAST_READ */
+        pCmd[0] = T2T_GET_VERSION;
+        *pCmd_size = 1;
+        eRW_NDEF_T2T_State = Getting_Version;
+        break;
+
+    case Getting_Version:
+        /* Is NTAG21x ? */
+        if ((Rsp_size == 9) && (pRsp[Rsp_size-1] == 0x00) && (pRsp[1] == NTAG_VENDOR_NXP) && (pRsp[2] == NTAG_PRODUCT_TYPE))
+        {
+            RW_NDEF_T2T_FastRead = true;
+
+            /* Read CC and first data */
+            pCmd[0] = T2T_FAST_READ;
+            pCmd[1] = 0x03;
+            pCmd[2] = 0x03 + T2T_FAST_READ_FIRST_PAGES - 1;
+            *pCmd_size = 3;
+            eRW_NDEF_T2T_State = Fast_Reading_Data;
+        }
+        else
+        {
+            /* Tag NAKed GET_VERSION and went back to IDLE state, it must be
+             * re-activated before going on with READ */
+            RW_NDEF_T2T_ReActivate = true;
+            eRW_NDEF_T2T_State = Version_Failed;
+        }
+        break;
+
+    case Version_Failed:
+        /* Tag re-activated, read CC */
+        RW_NDEF_T2T_ReActivate = false;
         pCmd[0] = 0x30;
         pCmd[1] = 0x03;
         *pCmd_size = 2;
@@ -68,12 +234,12 @@ void RW_NDEF_T2T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigne
         /* Is CC Read and Is Ndef ?*/
         if ((Rsp_size == 17) && (pRsp[Rsp_size-1] == 0x00) && (pRsp[0] == T2T_MAGIC_NUMBER))
         {
-            /* Read First data */
-            pCmd[0] = 0x30;
-            pCmd[1] = 0x04;
-            *pCmd_size = 2;
+            RW_NDEF_T2T_Ndef.LastBlkNb = 0x03 + (pRsp[2] * 2);
+            if (RW_NDEF_T2T_Ndef.LastBlkNb > 0xFF) RW_NDEF_T2T_Ndef.LastBlkNb = 0xFF;
 
-            eRW_NDEF_T2T_State = Reading_Data;
+            /* Read First data */
+            RW_NDEF_T2T_Ndef.TlvPtr = 0;
+            if (RW_NDEF_T2T_ReadTlv(pCmd, pCmd_size)) eRW_NDEF_T2T_State = Reading_Data;
         }
         break;
 
@@ -81,41 +247,18 @@ void RW_NDEF_T2T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigne
         /* Is Read success ?*/
         if ((Rsp_size == 17) && (pRsp[Rsp_size-1] == 0x00))
         {
-            unsigned char Tmp = 0;
-            /* If not NDEF Type skip TLV */
-            while (pRsp[Tmp] != T2T_NDEF_TLV)
+            Tmp = RW_NDEF_T2T_FindNdef(pRsp, Rsp_size-1, (RW_NDEF_T2T_Ndef.BlkNb - 0x04) * 4);
+            if (Tmp == -2)
             {
-                Tmp += 2 + pRsp[Tmp+1];
-                if (Tmp > Rsp_size) return;
+                /* TLV header is further in the data area */
+                RW_NDEF_T2T_ReadTlv(pCmd, pCmd_size);
+                return;
             }
+            if (Tmp < 0) return;
 
-            if(pRsp[Tmp+1] == 0xFF)
+            if (RW_NDEF_T2T_StartNdef(&pRsp[Tmp], (Rsp_size-1) - Tmp))
             {
-                RW_NDEF_T2T_Ndef.MessageSize = (pRsp[Tmp+2] << 8) + pRsp[Tmp+3];
-                Tmp += 2;
-            }
-            else RW_NDEF_T2T_Ndef.MessageSize = pRsp[Tmp+1];
-
-            /* If provisioned buffer is not large enough or message is empty, notify the application and stop reading */
-            if ((RW_NDEF_T2T_Ndef.MessageSize > RW_MAX_NDEF_FILE_SIZE) || (RW_NDEF_T2T_Ndef.MessageSize == 0))
-            {
-                if(pRW_NDEF_PullCb != NULL) pRW_NDEF_PullCb(NULL, 0, RW_NDEF_T2T_Ndef.MessageSize);
-                break;
-            }
-
-            /* Is NDEF read already completed ? */
-            if (RW_NDEF_T2T_Ndef.MessageSize <= ((Rsp_size-1) - Tmp - 2))
-            {
-                memcpy (RW_NDEF_T2T_Ndef.pMessage, &pRsp[Tmp+2], RW_NDEF_T2T_Ndef.MessageSize);
-
-                /* Notify application of the NDEF reception */
-                if(pRW_NDEF_PullCb != NULL) pRW_NDEF_PullCb(RW_NDEF_T2T_Ndef.pMessage, RW_NDEF_T2T_Ndef.MessageSize, RW_NDEF_T2T_Ndef.MessageSize);
-            }
-            else
-            {
-                RW_NDEF_T2T_Ndef.MessagePtr = (Rsp_size-1) - Tmp - 2;
-                memcpy (RW_NDEF_T2T_Ndef.pMessage, &pRsp[Tmp+2], RW_NDEF_T2T_Ndef.MessagePtr);
-                RW_NDEF_T2T_Ndef.BlkNb = 8;
+                RW_NDEF_T2T_Ndef.BlkNb += 4;
 
                 /* Read NDEF content */
                 pCmd[0] = 0x30;
@@ -152,6 +295,64 @@ void RW_NDEF_T2T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigne
         }
         break;
 
+    case Fast_Reading_Data:
+        /* Is CC Read and Is Ndef ?*/
+        if ((Rsp_size == (T2T_FAST_READ_FIRST_PAGES * 4) + 1) && (pRsp[Rsp_size-1] == 0x00) && (pRsp[0] == T2T_MAGIC_NUMBER))
+        {
+            /* CC byte 2 gives the data area size in 8-byte units, FAST_READ
+             * only addresses the first sector */
+            RW_NDEF_T2T_Ndef.LastBlkNb = 0x03 + (pRsp[2] * 2);
+            if (RW_NDEF_T2T_Ndef.LastBlkNb > 0xFF) RW_NDEF_T2T_Ndef.LastBlkNb = 0xFF;
+
+            RW_NDEF_T2T_Ndef.TlvPtr = 0;
+            Tmp = RW_NDEF_T2T_FindNdef(&pRsp[4], (Rsp_size-1) - 4, 0);
+            if (Tmp == -2)
+            {
+                /* NDEF TLV is behind lock/memory control TLVs larger than the
+                 * first FAST_READ span, go on with the READ sequence */
+                if (RW_NDEF_T2T_ReadTlv(pCmd, pCmd_size)) eRW_NDEF_T2T_State = Reading_Data;
+                return;
+            }
+            if (Tmp < 0) return;
+            Tmp += 4;
+
+            if (RW_NDEF_T2T_StartNdef(&pRsp[Tmp], (Rsp_size-1) - Tmp))
+            {
+                RW_NDEF_T2T_Ndef.BlkNb = 0x03 + T2T_FAST_READ_FIRST_PAGES;
+
+                /* Read NDEF content */
+                RW_NDEF_T2T_FastReadNext(pCmd, pCmd_size);
+                eRW_NDEF_T2T_State = Fast_Reading_NDEF;
+            }
+        }
+        break;
+
+    case Fast_Reading_NDEF:
+        /* Is Read success ?*/
+        if ((Rsp_size == (RW_NDEF_T2T_Ndef.FastReadPages * 4) + 1) && (pRsp[Rsp_size-1] == 0x00))
+        {
+            unsigned short Left = RW_NDEF_T2T_Ndef.MessageSize - RW_NDEF_T2T_Ndef.MessagePtr;
+
+            /* Is NDEF read already completed ? */
+            if (Left <= (Rsp_size-1))
+            {
+                memcpy (&RW_NDEF_T2T_Ndef.pMessage[RW_NDEF_T2T_Ndef.MessagePtr], pRsp, Left);
+
+                /* Notify application of the NDEF reception */
+                if(pRW_NDEF_PullCb != NULL) pRW_NDEF_PullCb(RW_NDEF_T2T_Ndef.pMessage, RW_NDEF_T2T_Ndef.MessageSize, RW_NDEF_T2T_Ndef.MessageSize);
+            }
+            else
+            {
+                memcpy (&RW_NDEF_T2T_Ndef.pMessage[RW_NDEF_T2T_Ndef.MessagePtr], pRsp, Rsp_size-1);
+                RW_NDEF_T2T_Ndef.MessagePtr += Rsp_size-1;
+                RW_NDEF_T2T_Ndef.BlkNb += RW_NDEF_T2T_Ndef.FastReadPages;
+
+                /* Read NDEF content */
+                RW_NDEF_T2T_FastReadNext(pCmd, pCmd_size);
+            }
+        }
+        break;
+
     default:
         break;
     }
@@ -29,6 +29,11 @@ const unsigned char RW_NDEF_T4T_OK[] = {0x90, 0x00};
 
 #define WRITE_SZ    54
 
+/* I-block overhead (PCB + CRC) in each ISO-DEP frame of FSC bytes */
+#define T4T_IBLOCK_OVERHEAD 3
+/* Short READ BINARY Le is kept below 256 (Le 0x00) which some cards reject */
+#define T4T_SHORT_LE_MAX    255
+
 typedef enum
 {
     Initial,
@@ -56,6 +61,7 @@ typedef struct
     unsigned short MessagePtr;
     unsigned short MessageSize;
     unsigned char *pMessage;
+    unsigned short Fsc;
 } RW_NDEF_T4T_Ndef_t;
 
 static RW_NDEF_T4T_state_t eRW_NDEF_T4T_State = Initial;
@@ -65,6 +71,58 @@ void RW_NDEF_T4T_Reset(void)
 {
     eRW_NDEF_T4T_State = Initial;
     RW_NDEF_T4T_Ndef.pMessage = NdefBuffer;
+    RW_NDEF_T4T_Ndef.Fsc = 0;
+}
+
+void RW_NDEF_T4T_SetFsc(unsigned short Fsc)
+{
+    RW_NDEF_T4T_Ndef.Fsc = Fsc;
+}
+
+/* Build READ BINARY of the next NDEF chunk. The chunk is the largest the card
+ * (MLe) and the reader (RW_MAX_RSP_SIZE) accept, trimmed so the answer fills
+ * whole ISO-DEP frames when this does not cost an extra READ BINARY. Chunks
+ * over 255 bytes use extended Le, supported by cards advertising MLe > 255 */
+static unsigned short RW_NDEF_T4T_PrepareRead(unsigned char *pCmd)
+{
+    unsigned short Offset = RW_NDEF_T4T_Ndef.MessagePtr + 2;
+    unsigned short Left = RW_NDEF_T4T_Ndef.MessageSize - RW_NDEF_T4T_Ndef.MessagePtr;
+    unsigned short Max = RW_NDEF_T4T_Ndef.MLe;
+    unsigned short Chunk;
+
+    if (Max > (RW_MAX_RSP_SIZE - 2)) Max = RW_MAX_RSP_SIZE - 2;
+    if (Max == 0) Max = 1;
+
+    if (Left <= Max)
+    {
+        Chunk = Left;
+    }
+    else
+    {
+        Chunk = Max;
+        if (RW_NDEF_T4T_Ndef.Fsc > T4T_IBLOCK_OVERHEAD)
+        {
+            unsigned short Inf = RW_NDEF_T4T_Ndef.Fsc - T4T_IBLOCK_OVERHEAD;
+            unsigned short Aligned = ((Max + 2) / Inf) * Inf;
+
+            if ((Aligned > 2) && ((Aligned - 2) < Max) &&
+                (((Left + Aligned - 3) / (Aligned - 2)) == ((Left + Max - 1) / Max)))
+                Chunk = Aligned - 2;
+        }
+    }
+
+    memcpy(pCmd, RW_NDEF_T4T_Read, sizeof(RW_NDEF_T4T_Read));
+    pCmd[2] = (Offset >> 8) & 0x7F;
+    pCmd[3] = Offset & 0xFF;
+    if (Chunk <= T4T_SHORT_LE_MAX)
+    {
+        pCmd[4] = (unsigned char) Chunk;
+        return sizeof(RW_NDEF_T4T_Read);
+    }
+    pCmd[4] = 0x00;
+    pCmd[5] = Chunk >> 8;
+    pCmd[6] = Chunk & 0xFF;
+    return sizeof(RW_NDEF_T4T_Read) + 2;
 }
 
 void RW_NDEF_T4T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigned char *pCmd, unsigned short *pCmd_size)
@@ -164,8 +222,8 @@ void RW_NDEF_T4T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigne
         {
             RW_NDEF_T4T_Ndef.MessageSize = (pRsp[0] << 8) + pRsp[1];
 
-            /* If provisioned buffer is not large enough, notify the application and stop reading */
-            if (RW_NDEF_T4T_Ndef.MessageSize > RW_MAX_NDEF_FILE_SIZE)
+            /* If provisioned buffer is not large enough or message is empty, notify the application and stop reading */
+            if ((RW_NDEF_T4T_Ndef.MessageSize > RW_MAX_NDEF_FILE_SIZE) || (RW_NDEF_T4T_Ndef.MessageSize == 0))
             {
                 if(pRW_NDEF_PullCb != NULL) pRW_NDEF_PullCb(NULL, 0, RW_NDEF_T4T_Ndef.MessageSize);
                 break;
@@ -174,21 +232,23 @@ void RW_NDEF_T4T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigne
             RW_NDEF_T4T_Ndef.MessagePtr = 0;
 
             /* Read NDEF data */
-            memcpy(pCmd, RW_NDEF_T4T_Read, sizeof(RW_NDEF_T4T_Read));
-            pCmd[3] =  2;
-            pCmd[4] = (RW_NDEF_T4T_Ndef.MessageSize > RW_NDEF_T4T_Ndef.MLe-1) ? RW_NDEF_T4T_Ndef.MLe-1 : (unsigned char) RW_NDEF_T4T_Ndef.MessageSize;
-            *pCmd_size = sizeof(RW_NDEF_T4T_Read);
+            *pCmd_size = RW_NDEF_T4T_PrepareRead(pCmd);
             eRW_NDEF_T4T_State = Reading_NDEF;
         }
         break;
 
     case Reading_NDEF:
         /* Is Read Success ?*/
-        if (!memcmp(&pRsp[Rsp_size - 2], RW_NDEF_T4T_OK, sizeof(RW_NDEF_T4T_OK)))
+        if ((Rsp_size > 2) && !memcmp(&pRsp[Rsp_size - 2], RW_NDEF_T4T_OK, sizeof(RW_NDEF_T4T_OK)))
         {
-            memcpy(&RW_NDEF_T4T_Ndef.pMessage[RW_NDEF_T4T_Ndef.MessagePtr], pRsp, Rsp_size - 2);
-            RW_NDEF_T4T_Ndef.MessagePtr += Rsp_size - 2;
-            
+            unsigned short Size = Rsp_size - 2;
+
+            /* Ignore bytes beyond the NDEF message */
+            if (Size > (RW_NDEF_T4T_Ndef.MessageSize - RW_NDEF_T4T_Ndef.MessagePtr))
+                Size = RW_NDEF_T4T_Ndef.MessageSize - RW_NDEF_T4T_Ndef.MessagePtr;
+            memcpy(&RW_NDEF_T4T_Ndef.pMessage[RW_NDEF_T4T_Ndef.MessagePtr], pRsp, Size);
+            RW_NDEF_T4T_Ndef.MessagePtr += Size;
+
             /* Is NDEF message read completed ?*/
             if (RW_NDEF_T4T_Ndef.MessagePtr == RW_NDEF_T4T_Ndef.MessageSize)
             {
@@ -198,10 +258,7 @@ void RW_NDEF_T4T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigne
             else
             {
                 /* Read NDEF data */
-                memcpy(pCmd, RW_NDEF_T4T_Read, sizeof(RW_NDEF_T4T_Read));
-                pCmd[3] =  RW_NDEF_T4T_Ndef.MessagePtr + 2;
-                pCmd[4] = ((RW_NDEF_T4T_Ndef.MessageSize - RW_NDEF_T4T_Ndef.MessagePtr) > RW_NDEF_T4T_Ndef.MLe-1) ? RW_NDEF_T4T_Ndef.MLe-1 : (unsigned char) (RW_NDEF_T4T_Ndef.MessageSize - RW_NDEF_T4T_Ndef.MessagePtr);
-                *pCmd_size = sizeof(RW_NDEF_T4T_Read);
+                *pCmd_size = RW_NDEF_T4T_PrepareRead(pCmd);
             }
         }
         break;
@@ -22,28 +22,58 @@
 #define T5T_ADD_MODE_2BYTE    0xE2
 #define T5T_NDEF_TLV		  0x03
 
+/* CC byte 3 bit 0: READ MULTIPLE BLOCKS supported */
+#define T5T_CC_MBREAD         0x01
+/* GET SYSTEM INFO info flags */
+#define T5T_INFO_DSFID        0x01
+#define T5T_INFO_AFI          0x02
+#define T5T_INFO_MEM_SIZE     0x04
+/* Response flags: error, error code follows */
+#define T5T_RSP_ERROR         0x01
+
+/* READ MULTIPLE BLOCKS answer (flags + data + NCI status byte) must fit in a
+ * single 255-byte NCI data packet, the largest frame PN7160 hands over */
+#define T5T_MAX_FRAME_DATA    253
+/* Data read along with the NDEF TLV header by the first READ MULTIPLE */
+#define T5T_FIRST_READ_BYTES  32
+/* WRITE MULTIPLE BLOCKS command (flags, code, 2-byte address, count) plus
+ * data must fit in a single 255-byte NCI data packet */
+#define T5T_MAX_WRITE_DATA    249
+/* Largest block size a tag can report in GET SYSTEM INFO */
+#define T5T_MAX_BLOCK_SIZE    32
+
 typedef enum
 {
     Initial,
+    Getting_SysInfo,
     Reading_CC,
     Reading_Data,
     Reading_NDEF,
+    Multi_Reading_Data,
+    Multi_Reading_NDEF,
     Writing_Data
 } RW_NDEF_T5T_state_t;
 
 typedef struct
 {
-    unsigned char BlkNb;
+    unsigned short BlkNb;
     unsigned short MessagePtr;
     unsigned short MessageSize;
     unsigned char *pMessage;
     unsigned char AddrMode;
+    unsigned char BlkSize;          /* from GET SYSTEM INFO, 4 if unknown */
+    unsigned short BlkCount;        /* from GET SYSTEM INFO, 0 if unknown */
+    unsigned char MultiBlocks;      /* blocks per READ/WRITE MULTIPLE, 0 if not supported */
+    bool MultiRead;                 /* READ MULTIPLE accepted by the tag */
+    unsigned char PendingBlocks;    /* blocks requested by the last command */
+    unsigned char Skip;             /* CC bytes at the start of the first data block */
+    unsigned char Prefix[T5T_MAX_BLOCK_SIZE];   /* those CC bytes, rewritten as is */
 } RW_NDEF_T5T_Ndef_t;
 
 static RW_NDEF_T5T_state_t eRW_NDEF_T5T_State = Initial;
 static RW_NDEF_T5T_Ndef_t RW_NDEF_T5T_Ndef;
 
-static unsigned short T5T_prepare_read_block(unsigned char blk, unsigned char *pCmd)
+static unsigned short T5T_prepare_read_block(unsigned short blk, unsigned char *pCmd)
 {
 	unsigned short size;
 
@@ -51,48 +81,171 @@ static unsigned short T5T_prepare_read_block(unsigned char blk, unsigned char *p
 	{
 		pCmd[0] = 0x02;
 		pCmd[1] = 0x20;
-		pCmd[2] = blk;
+		pCmd[2] = (unsigned char) blk;
 		size = 3;
 	}
 	else
 	{
+		/* Extended commands take the block number LSB first */
 		pCmd[0] = 0x02;
 		pCmd[1] = 0x30;
-		pCmd[2] = 0x00;
-		pCmd[3] = blk;
+		pCmd[2] = blk & 0xFF;
+		pCmd[3] = (blk >> 8) & 0xFF;
 		size = 4;
 	}
 	return size;
 }
 
-static unsigned short T5T_prepare_write_block(unsigned char blk, unsigned char *pCmd, unsigned char *pData)
+static unsigned short T5T_prepare_read_multiple(unsigned short blk, unsigned char nb, unsigned char *pCmd)
 {
 	unsigned short size;
 
+	RW_NDEF_T5T_Ndef.PendingBlocks = nb;
+	/* Single block READ answers like a READ MULTIPLE of 1 block */
+	if(!RW_NDEF_T5T_Ndef.MultiRead) return T5T_prepare_read_block(blk, pCmd);
+
+	if(RW_NDEF_T5T_Ndef.AddrMode == T5T_ADD_MODE_1BYTE)
+	{
+		pCmd[0] = 0x02;
+		pCmd[1] = 0x23;
+		pCmd[2] = (unsigned char) blk;
+		pCmd[3] = nb - 1;
+		size = 4;
+	}
+	else
+	{
+		pCmd[0] = 0x02;
+		pCmd[1] = 0x33;
+		pCmd[2] = blk & 0xFF;
+		pCmd[3] = (blk >> 8) & 0xFF;
+		pCmd[4] = nb - 1;
+		pCmd[5] = 0x00;
+		size = 6;
+	}
+	return size;
+}
+
+/* Byte Ptr of what is written from the first data block on: the CC bytes
+ * sharing that block, the NDEF TLV header, the message, then padding */
+static unsigned char T5T_write_byte(unsigned short Ptr)
+{
+	if (Ptr < RW_NDEF_T5T_Ndef.Skip) return RW_NDEF_T5T_Ndef.Prefix[Ptr];
+	Ptr -= RW_NDEF_T5T_Ndef.Skip;
+	if (Ptr == 0) return T5T_NDEF_TLV;
+	if (Ptr == 1) return (unsigned char) RW_NdefMessage_size;
+	Ptr -= 2;
+	return (Ptr < RW_NdefMessage_size) ? pRW_NdefMessage[Ptr] : 0x00;
+}
+
+static unsigned short T5T_prepare_write_block(unsigned short blk, unsigned char *pCmd, unsigned short ptr)
+{
+	unsigned short size;
+	unsigned char i;
+
 	if(RW_NDEF_T5T_Ndef.AddrMode == T5T_ADD_MODE_1BYTE)
 	{
 		pCmd[0] = 0x02;
 		pCmd[1] = 0x21;
-		pCmd[2] = blk;
-		memcpy(&pCmd[3], pData, 4);
-		size = 7;
+		pCmd[2] = (unsigned char) blk;
+		size = 3;
 	}
 	else
 	{
 		pCmd[0] = 0x02;
 		pCmd[1] = 0x31;
-		pCmd[2] = 0x00;
-		pCmd[3] = blk;
-		memcpy(&pCmd[4], pData, 4);
-		size = 8;
+		pCmd[2] = blk & 0xFF;
+		pCmd[3] = (blk >> 8) & 0xFF;
+		size = 4;
 	}
-	return size;
+	for (i = 0; i < RW_NDEF_T5T_Ndef.BlkSize; i++) pCmd[size + i] = T5T_write_byte(ptr + i);
+	return size + RW_NDEF_T5T_Ndef.BlkSize;
+}
+
+static unsigned short T5T_prepare_write_multiple(unsigned short blk, unsigned char nb, unsigned char *pCmd, unsigned short ptr)
+{
+	unsigned short size;
+	unsigned short i;
+
+	if(RW_NDEF_T5T_Ndef.AddrMode == T5T_ADD_MODE_1BYTE)
+	{
+		pCmd[0] = 0x02;
+		pCmd[1] = 0x24;
+		pCmd[2] = (unsigned char) blk;
+		pCmd[3] = nb - 1;
+		size = 4;
+	}
+	else
+	{
+		pCmd[0] = 0x02;
+		pCmd[1] = 0x34;
+		pCmd[2] = blk & 0xFF;
+		pCmd[3] = (blk >> 8) & 0xFF;
+		pCmd[4] = nb - 1;
+		pCmd[5] = 0x00;
+		size = 6;
+	}
+	for (i = 0; i < (nb * RW_NDEF_T5T_Ndef.BlkSize); i++) pCmd[size + i] = T5T_write_byte(ptr + i);
+	return size + (nb * RW_NDEF_T5T_Ndef.BlkSize);
+}
+
+/* Parse GET SYSTEM INFO answer for the memory size */
+static void T5T_parse_sysinfo(unsigned char *pRsp, unsigned short Rsp_size)
+{
+    unsigned short Tmp = 10;    /* flags, info flags, UID */
+
+    if ((Rsp_size < 12) || (pRsp[Rsp_size-1] != 0x00) || (pRsp[0] & T5T_RSP_ERROR)) return;
+    if (!(pRsp[1] & T5T_INFO_MEM_SIZE)) return;
+    if (pRsp[1] & T5T_INFO_DSFID) Tmp++;
+    if (pRsp[1] & T5T_INFO_AFI) Tmp++;
+    if ((Tmp + 2) >= Rsp_size) return;
+
+    RW_NDEF_T5T_Ndef.BlkCount = pRsp[Tmp] + 1;
+    RW_NDEF_T5T_Ndef.BlkSize = (pRsp[Tmp+1] & 0x1F) + 1;
+    RW_NDEF_T5T_Ndef.MultiBlocks = T5T_MAX_FRAME_DATA / RW_NDEF_T5T_Ndef.BlkSize;
+}
+
+/* Build READ MULTIPLE of the next blocks still holding NDEF bytes, limited to
+ * the tag memory and to the PN7160 frame */
+static void T5T_read_multiple_next(unsigned char *pCmd, unsigned short *pCmd_size)
+{
+    unsigned short Left = RW_NDEF_T5T_Ndef.MessageSize - RW_NDEF_T5T_Ndef.MessagePtr;
+    unsigned short Nb = (Left + RW_NDEF_T5T_Ndef.BlkSize - 1) / RW_NDEF_T5T_Ndef.BlkSize;
+
+    if (Nb > RW_NDEF_T5T_Ndef.MultiBlocks) Nb = RW_NDEF_T5T_Ndef.MultiBlocks;
+    if (RW_NDEF_T5T_Ndef.BlkCount != 0)
+    {
+        /* GET SYSTEM INFO reports at most 256 blocks on larger tags */
+        if ((RW_NDEF_T5T_Ndef.AddrMode == T5T_ADD_MODE_1BYTE) || (RW_NDEF_T5T_Ndef.BlkCount < 256))
+        {
+            if (RW_NDEF_T5T_Ndef.BlkNb >= RW_NDEF_T5T_Ndef.BlkCount) return;
+            if ((RW_NDEF_T5T_Ndef.BlkNb + Nb) > RW_NDEF_T5T_Ndef.BlkCount) Nb = RW_NDEF_T5T_Ndef.BlkCount - RW_NDEF_T5T_Ndef.BlkNb;
+        }
+    }
+    *pCmd_size = T5T_prepare_read_multiple(RW_NDEF_T5T_Ndef.BlkNb, (unsigned char) Nb, pCmd);
 }
 
 void RW_NDEF_T5T_Reset(void)
 {
     eRW_NDEF_T5T_State = Initial;
     RW_NDEF_T5T_Ndef.pMessage = NdefBuffer;
+    RW_NDEF_T5T_Ndef.BlkSize = 4;
+    RW_NDEF_T5T_Ndef.BlkCount = 0;
+    RW_NDEF_T5T_Ndef.MultiBlocks = 0;
+    RW_NDEF_T5T_Ndef.MultiRead = true;
+}
+
+/* READ MULTIPLE is optional in ISO15693 even when the CC advertises it, and
+ * some tags reject large block counts: go on with single block READ from
+ * the block that failed. Return true if the READ was built */
+static bool T5T_read_fallback(unsigned char *pRsp, unsigned short Rsp_size, unsigned char *pCmd, unsigned short *pCmd_size)
+{
+    if (!RW_NDEF_T5T_Ndef.MultiRead) return false;
+    if ((Rsp_size < 2) || (pRsp[Rsp_size-1] != 0x00) || !(pRsp[0] & T5T_RSP_ERROR)) return false;
+
+    RW_NDEF_T5T_Ndef.MultiRead = false;
+    RW_NDEF_T5T_Ndef.MultiBlocks = 1;
+    *pCmd_size = T5T_prepare_read_multiple(RW_NDEF_T5T_Ndef.BlkNb, 1, pCmd);
+    return true;
 }
 
 void RW_NDEF_T5T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigned char *pCmd, unsigned short *pCmd_size)
@@ -103,20 +256,54 @@ void RW_NDEF_T5T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigne
     switch(eRW_NDEF_T5T_State)
     {
     case Initial:
+        /* Get block size and count */
+        RW_NDEF_T5T_Ndef.AddrMode = T5T_ADD_MODE_1BYTE;
+        pCmd[0] = 0x02;
+        pCmd[1] = 0x2B;
+        *pCmd_size = 2;
+        eRW_NDEF_T5T_State = Getting_SysInfo;
+        break;
+
+    case Getting_SysInfo:
+        T5T_parse_sysinfo(pRsp, Rsp_size);
+
         /* Read CC */
-		RW_NDEF_T5T_Ndef.AddrMode = T5T_ADD_MODE_1BYTE;
 		*pCmd_size = T5T_prepare_read_block(0, pCmd);
         eRW_NDEF_T5T_State = Reading_CC;
         break;
 
     case Reading_CC:
         /* Is CC Read and Is Ndef ?*/
-        if ((Rsp_size == 6) && (pRsp[Rsp_size-1] == 0x00) && ((pRsp[1] == T5T_ADD_MODE_1BYTE) || (pRsp[1] == T5T_ADD_MODE_2BYTE)))
+        if ((Rsp_size == (RW_NDEF_T5T_Ndef.BlkSize + 2)) && (pRsp[Rsp_size-1] == 0x00) && ((pRsp[1] == T5T_ADD_MODE_1BYTE) || (pRsp[1] == T5T_ADD_MODE_2BYTE)))
         {
 			RW_NDEF_T5T_Ndef.AddrMode = pRsp[1];
-			/* Read First data */
-			*pCmd_size = T5T_prepare_read_block(1, pCmd);
-            eRW_NDEF_T5T_State = Reading_Data;
+
+			if ((RW_NDEF_T5T_Ndef.MultiBlocks != 0) && (pRsp[4] & T5T_CC_MBREAD))
+			{
+				/* CC is 8 bytes long when its memory size byte is 0 */
+				unsigned char CcSize = (pRsp[3] == 0) ? 8 : 4;
+				unsigned short Nb;
+
+				RW_NDEF_T5T_Ndef.BlkNb = CcSize / RW_NDEF_T5T_Ndef.BlkSize;
+				RW_NDEF_T5T_Ndef.Skip = CcSize % RW_NDEF_T5T_Ndef.BlkSize;
+				Nb = (RW_NDEF_T5T_Ndef.Skip + T5T_FIRST_READ_BYTES + RW_NDEF_T5T_Ndef.BlkSize - 1) / RW_NDEF_T5T_Ndef.BlkSize;
+				if (Nb > RW_NDEF_T5T_Ndef.MultiBlocks) Nb = RW_NDEF_T5T_Ndef.MultiBlocks;
+				if (RW_NDEF_T5T_Ndef.BlkCount != 0)
+				{
+					if (RW_NDEF_T5T_Ndef.BlkNb >= RW_NDEF_T5T_Ndef.BlkCount) break;
+					if ((RW_NDEF_T5T_Ndef.BlkNb + Nb) > RW_NDEF_T5T_Ndef.BlkCount) Nb = RW_NDEF_T5T_Ndef.BlkCount - RW_NDEF_T5T_Ndef.BlkNb;
+				}
+
+				/* Read first data blocks */
+				*pCmd_size = T5T_prepare_read_multiple(RW_NDEF_T5T_Ndef.BlkNb, (unsigned char) Nb, pCmd);
+				eRW_NDEF_T5T_State = Multi_Reading_Data;
+			}
+			else if (Rsp_size == 6)
+			{
+				/* Read First data */
+				*pCmd_size = T5T_prepare_read_block(1, pCmd);
+				eRW_NDEF_T5T_State = Reading_Data;
+			}
         }
         break;
 
@@ -181,11 +368,109 @@ void RW_NDEF_T5T_Read_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigne
         }
         break;
 
+    case Multi_Reading_Data:
+        if (T5T_read_fallback(pRsp, Rsp_size, pCmd, pCmd_size)) break;
+
+        /* Is Read success ?*/
+        if ((Rsp_size == (RW_NDEF_T5T_Ndef.PendingBlocks * RW_NDEF_T5T_Ndef.BlkSize) + 2) && (pRsp[Rsp_size-1] == 0x00) && !(pRsp[0] & T5T_RSP_ERROR))
+        {
+            unsigned char *pData = &pRsp[1 + RW_NDEF_T5T_Ndef.Skip];
+            unsigned short Size = (Rsp_size - 2) - RW_NDEF_T5T_Ndef.Skip;
+            unsigned short Tmp;
+
+            if ((Size < 4) || (pData[0] != T5T_NDEF_TLV)) break;
+            if (pData[1] == 0xFF)
+            {
+                RW_NDEF_T5T_Ndef.MessageSize = (pData[2] << 8) + pData[3];
+                Tmp = 4;
+            }
+            else
+            {
+                RW_NDEF_T5T_Ndef.MessageSize = pData[1];
+                Tmp = 2;
+            }
+
+            /* If provisioned buffer is not large enough or message is empty, notify the application and stop reading */
+            if ((RW_NDEF_T5T_Ndef.MessageSize > RW_MAX_NDEF_FILE_SIZE) || (RW_NDEF_T5T_Ndef.MessageSize == 0))
+            {
+                if(pRW_NDEF_PullCb != NULL) pRW_NDEF_PullCb(NULL, 0, RW_NDEF_T5T_Ndef.MessageSize);
+                break;
+            }
+
+            /* Is NDEF read already completed ? */
+            if (RW_NDEF_T5T_Ndef.MessageSize <= (Size - Tmp))
+            {
+                memcpy (RW_NDEF_T5T_Ndef.pMessage, &pData[Tmp], RW_NDEF_T5T_Ndef.MessageSize);
+
+                /* Notify application of the NDEF reception */
+                if(pRW_NDEF_PullCb != NULL) pRW_NDEF_PullCb(RW_NDEF_T5T_Ndef.pMessage, RW_NDEF_T5T_Ndef.MessageSize, RW_NDEF_T5T_Ndef.MessageSize);
+            }
+            else
+            {
+                RW_NDEF_T5T_Ndef.MessagePtr = Size - Tmp;
+                memcpy (RW_NDEF_T5T_Ndef.pMessage, &pData[Tmp], RW_NDEF_T5T_Ndef.MessagePtr);
+                RW_NDEF_T5T_Ndef.BlkNb += RW_NDEF_T5T_Ndef.PendingBlocks;
+
+                /* Read NDEF content */
+                T5T_read_multiple_next(pCmd, pCmd_size);
+                eRW_NDEF_T5T_State = Multi_Reading_NDEF;
+            }
+        }
+        break;
+
+    case Multi_Reading_NDEF:
+        if (T5T_read_fallback(pRsp, Rsp_size, pCmd, pCmd_size)) break;
+
+        /* Is Read success ?*/
+        if ((Rsp_size == (RW_NDEF_T5T_Ndef.PendingBlocks * RW_NDEF_T5T_Ndef.BlkSize) + 2) && (pRsp[Rsp_size-1] == 0x00) && !(pRsp[0] & T5T_RSP_ERROR))
+        {
+            unsigned short Left = RW_NDEF_T5T_Ndef.MessageSize - RW_NDEF_T5T_Ndef.MessagePtr;
+
+            /* Is NDEF read already completed ? */
+            if (Left <= (Rsp_size - 2))
+            {
+                memcpy (&RW_NDEF_T5T_Ndef.pMessage[RW_NDEF_T5T_Ndef.MessagePtr], &pRsp[1], Left);
+
+                /* Notify application of the NDEF reception */
+                if(pRW_NDEF_PullCb != NULL) pRW_NDEF_PullCb(RW_NDEF_T5T_Ndef.pMessage, RW_NDEF_T5T_Ndef.MessageSize, RW_NDEF_T5T_Ndef.MessageSize);
+            }
+            else
+            {
+                memcpy (&RW_NDEF_T5T_Ndef.pMessage[RW_NDEF_T5T_Ndef.MessagePtr], &pRsp[1], Rsp_size - 2);
+                RW_NDEF_T5T_Ndef.MessagePtr += Rsp_size - 2;
+                RW_NDEF_T5T_Ndef.BlkNb += RW_NDEF_T5T_Ndef.PendingBlocks;
+
+                /* Read NDEF content */
+                T5T_read_multiple_next(pCmd, pCmd_size);
+            }
+        }
+        break;
+
     default:
         break;
     }
 }
 
+/* Build the write of the next NDEF bytes: WRITE MULTIPLE while the tag
+ * accepts it, WRITE SINGLE otherwise */
+static void T5T_write_next(unsigned char *pCmd, unsigned short *pCmd_size)
+{
+    unsigned short Left = (RW_NDEF_T5T_Ndef.Skip + 2 + RW_NdefMessage_size) - RW_NDEF_T5T_Ndef.MessagePtr;
+    unsigned short Nb = (Left + RW_NDEF_T5T_Ndef.BlkSize - 1) / RW_NDEF_T5T_Ndef.BlkSize;
+
+    if (Nb > RW_NDEF_T5T_Ndef.MultiBlocks) Nb = RW_NDEF_T5T_Ndef.MultiBlocks;
+    if (Nb > 1)
+    {
+        *pCmd_size = T5T_prepare_write_multiple(RW_NDEF_T5T_Ndef.BlkNb, (unsigned char) Nb, pCmd, RW_NDEF_T5T_Ndef.MessagePtr);
+        RW_NDEF_T5T_Ndef.PendingBlocks = (unsigned char) Nb;
+    }
+    else
+    {
+        *pCmd_size = T5T_prepare_write_block(RW_NDEF_T5T_Ndef.BlkNb, pCmd, RW_NDEF_T5T_Ndef.MessagePtr);
+        RW_NDEF_T5T_Ndef.PendingBlocks = 1;
+    }
+}
+
 void RW_NDEF_T5T_Write_Next(unsigned char *pRsp, unsigned short Rsp_size, unsigned char *pCmd, unsigned short *pCmd_size)
 {
     /* By default no further command to be sent */
@@ -194,38 +479,70 @@ void RW_NDEF_T5T_Write_Next(unsigned char *pRsp, unsigned short Rsp_size, unsign
     switch(eRW_NDEF_T5T_State)
     {
     case Initial:
+        /* Get block size */
+        RW_NDEF_T5T_Ndef.AddrMode = T5T_ADD_MODE_1BYTE;
+        pCmd[0] = 0x02;
+        pCmd[1] = 0x2B;
+        *pCmd_size = 2;
+        eRW_NDEF_T5T_State = Getting_SysInfo;
+        break;
+
+    case Getting_SysInfo:
+        T5T_parse_sysinfo(pRsp, Rsp_size);
+
         /* Read CC */
-		RW_NDEF_T5T_Ndef.AddrMode = T5T_ADD_MODE_1BYTE;
 		*pCmd_size = T5T_prepare_read_block(0, pCmd);
         eRW_NDEF_T5T_State = Reading_CC;
         break;
 
     case Reading_CC:
         /* Is CC Read and Is Ndef */
-        if ((Rsp_size == 6) && (pRsp[Rsp_size-1] == 0x00) && ((pRsp[1] == T5T_ADD_MODE_1BYTE) || (pRsp[1] == T5T_ADD_MODE_2BYTE)))
+        if ((Rsp_size == (RW_NDEF_T5T_Ndef.BlkSize + 2)) && (pRsp[Rsp_size-1] == 0x00) && ((pRsp[1] == T5T_ADD_MODE_1BYTE) || (pRsp[1] == T5T_ADD_MODE_2BYTE)))
         {
 			RW_NDEF_T5T_Ndef.AddrMode = pRsp[1];
             /* Is size enough ? */
             if ((pRsp[3]*8 >= RW_NdefMessage_size) && (0xFF >= RW_NdefMessage_size))
             {
-				unsigned char data[4] = {0x03};
-				data[1] = (uint8_t) RW_NdefMessage_size;
-                memcpy(&data[2], pRW_NdefMessage, 2);
+				unsigned short Nb = T5T_MAX_WRITE_DATA / RW_NDEF_T5T_Ndef.BlkSize;
+
+				/* 4-byte CC: the TLV starts in the block holding CC byte 4, the
+				 * CC bytes sharing it are written back unchanged */
+				RW_NDEF_T5T_Ndef.BlkNb = 4 / RW_NDEF_T5T_Ndef.BlkSize;
+				RW_NDEF_T5T_Ndef.Skip = 4 % RW_NDEF_T5T_Ndef.BlkSize;
+				memcpy(RW_NDEF_T5T_Ndef.Prefix, &pRsp[1], RW_NDEF_T5T_Ndef.Skip);
+				RW_NDEF_T5T_Ndef.MessagePtr = 0;
+
+				/* Blocks per WRITE MULTIPLE: as many as fit the NCI packet,
+				 * rounded down to a power of 2 like tag limits (4 on ST25DV) */
+				RW_NDEF_T5T_Ndef.MultiBlocks = 1;
+				while ((RW_NDEF_T5T_Ndef.MultiBlocks * 2) <= Nb) RW_NDEF_T5T_Ndef.MultiBlocks *= 2;
+
 				/* Write First data */
-				*pCmd_size = T5T_prepare_write_block(1, pCmd, data);
-                RW_NDEF_T5T_Ndef.MessagePtr = 2;
-                RW_NDEF_T5T_Ndef.BlkNb = 2;
+				T5T_write_next(pCmd, pCmd_size);
                 eRW_NDEF_T5T_State = Writing_Data;
             }
         }
         break;
 
     case Writing_Data:
+        /* Is WRITE MULTIPLE rejected ? */
+        if ((RW_NDEF_T5T_Ndef.PendingBlocks > 1) && !((Rsp_size == 2) && (pRsp[0] == 0x00) && (pRsp[Rsp_size-1] == 0x00)))
+        {
+            /* Write the same blocks again, half as many per command, down to
+             * WRITE SINGLE on tags not supporting it (ICODE SLIX) */
+            RW_NDEF_T5T_Ndef.MultiBlocks = RW_NDEF_T5T_Ndef.PendingBlocks / 2;
+            T5T_write_next(pCmd, pCmd_size);
+            break;
+        }
+
         /* Is Write success ?*/
         if ((Rsp_size == 2) && (pRsp[Rsp_size-1] == 0x00))
         {
+            RW_NDEF_T5T_Ndef.MessagePtr += RW_NDEF_T5T_Ndef.PendingBlocks * RW_NDEF_T5T_Ndef.BlkSize;
+            RW_NDEF_T5T_Ndef.BlkNb += RW_NDEF_T5T_Ndef.PendingBlocks;
+
             /* Is NDEF write already completed ? */
-            if (RW_NdefMessage_size <= RW_NDEF_T5T_Ndef.MessagePtr)
+            if ((RW_NDEF_T5T_Ndef.Skip + 2 + RW_NdefMessage_size) <= RW_NDEF_T5T_Ndef.MessagePtr)
             {
                 /* Notify application of the NDEF send completion */
                 if(pRW_NDEF_PushCb != NULL) pRW_NDEF_PushCb(pRW_NdefMessage, RW_NdefMessage_size);
@@ -233,9 +550,7 @@ void RW_NDEF_T5T_Write_Next(unsigned char *pRsp, unsigned short Rsp_size, unsign
             else
             {
                 /* Write NDEF content */
-				*pCmd_size = T5T_prepare_write_block(RW_NDEF_T5T_Ndef.BlkNb, pCmd, pRW_NdefMessage+RW_NDEF_T5T_Ndef.MessagePtr);
-                RW_NDEF_T5T_Ndef.MessagePtr+=4;
-                RW_NDEF_T5T_Ndef.BlkNb++;
+                T5T_write_next(pCmd, pCmd_size);
             }
         }
         break;
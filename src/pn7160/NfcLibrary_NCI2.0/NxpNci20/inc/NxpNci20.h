@@ -26,7 +26,9 @@
 
 #ifndef REMOVE_RW_SUPPORT
 #include <RW_NDEF.h>
+#include <RW_NDEF_T2T.h>
 #include <RW_NDEF_T3T.h>
+#include <RW_NDEF_T4T.h>
 #endif  // #ifndef REMOVE_RW_SUPPORT
 
 #define NXPNCI_SUCCESS NFC_SUCCESS
@@ -357,21 +357,69 @@ bool NxpNci_ReaderTagCmd(unsigned char* pCommand, unsigned char CommandSize,
 }
 
 #ifndef REMOVE_NDEF_SUPPORT
+/* NDEF 讀取時間：卡片 activate 後開始讀到讀取結束 */
+static NxpNci_ReadStats_t NxpNci_ReadStats;
+
+void NxpNci_GetReadStats(NxpNci_ReadStats_t* pStats) {
+  *pStats = NxpNci_ReadStats;
+}
+
+void NxpNci_ResetReadStats(void) {
+  memset(&NxpNci_ReadStats, 0, sizeof(NxpNci_ReadStats));
+}
+
+/* ISO-DEP 卡片的 frame size (FSC)，由 ATS T0 / ATQB Protocol Info 的 FSCI 換算 */
+static uint16_t NxpNci_GetFsc(NxpNci_RfIntf_t* pRfIntf) {
+  static const uint16_t FscTable[] = {16,  24,  32,   40,   48,   64,  96,
+                                      128, 256, 512, 1024, 2048, 4096};
+  uint8_t fsci = 2; /* ISO14443-4 default when T0 is absent */
+
+  if ((pRfIntf->ModeTech & ~MODE_LISTEN) == TECH_PASSIVE_NFCA) {
+    /* RATS Response starts with T0 (TL excluded) */
+    if (pRfIntf->Info.NFC_APP.RatsLen > 0)
+      fsci = pRfIntf->Info.NFC_APP.Rats[0] & 0x0F;
+  } else if ((pRfIntf->ModeTech & ~MODE_LISTEN) == TECH_PASSIVE_NFCB) {
+    /* SENSB_RES without its first byte: Protocol Info byte 2 high nibble */
+    if (pRfIntf->Info.NFC_BPP.SensResLen > 9)
+      fsci = pRfIntf->Info.NFC_BPP.SensRes[9] >> 4;
+  }
+  if (fsci >= sizeof(FscTable) / sizeof(FscTable[0]))
+    fsci = sizeof(FscTable) / sizeof(FscTable[0]) - 1;
+  return FscTable[fsci];
+}
+
 static void NxpNci_ReadNdef(NxpNci_RfIntf_t RfIntf) {
+  /* Chained answers, e.g. T4T READ BINARY up to RW_MAX_RSP_SIZE */
+  static uint8_t Rsp[RW_MAX_RSP_SIZE];
   uint8_t Answer[MAX_NCI_FRAME_SIZE] = {0, 0};
   uint16_t AnswerSize;
   uint8_t Cmd[MAX_NCI_FRAME_SIZE] = {0, 0};
   uint16_t CmdSize = 0;
+  uint8_t* pRsp = &Answer[3];
+  uint16_t RspSize = 0;
+  uint32_t start = k_cycle_get_32();
+  uint32_t exchanges = 0;
+  uint32_t bytes = 0;
+  uint32_t us;
 
   RW_NDEF_Reset(RfIntf.Protocol);
+  if (RfIntf.Protocol == PROT_ISODEP) {
+    RW_NDEF_T4T_SetFsc(NxpNci_GetFsc(&RfIntf));
+  }
 
   while (1) {
-    RW_NDEF_Read_Next(&Answer[3], Answer[2], &Cmd[3],
-                      (unsigned short*)&CmdSize);
+    RW_NDEF_Read_Next(pRsp, RspSize, &Cmd[3], (unsigned short*)&CmdSize);
     if (CmdSize == 0) {
+      /* T2T 不支援 GET_VERSION 時會回到 IDLE，重新 activate 後改用 READ */
+      if ((RfIntf.Protocol == PROT_T2T) && RW_NDEF_T2T_ReActivateNeeded() &&
+          (NxpNci_ReaderReActivate(&RfIntf) == NXPNCI_SUCCESS)) {
+        RspSize = 0;
+        continue;
+      }
       /* End of the Read operation */
       break;
     } else {
+      exchanges++;
       /* Compute and send DATA_PACKET */
       Cmd[0] = 0x00;
       Cmd[1] = (CmdSize & 0xFF00) >> 8;
@@ -380,25 +428,52 @@ static void NxpNci_ReadNdef(NxpNci_RfIntf_t RfIntf) {
       NxpNci_HostTransceive(Cmd, CmdSize + 3, Answer, sizeof(Answer),
                             &AnswerSize);
       NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize, TIMEOUT_1S);
+      pRsp = &Answer[3];
+      RspSize = Answer[2];
 
-      /* Manage chaining in case of T4T */
-      if ((RfIntf.Interface = INTF_ISODEP) && Answer[0] == 0x10) {
-        uint8_t tmp[MAX_NCI_FRAME_SIZE];
-        uint8_t tmpSize = 0;
+      /* Manage chaining (NCI segmented DATA_PACKET) */
+      if (Answer[0] == 0x10) {
+        bool overflow = false;
+
+        RspSize = 0;
         while (Answer[0] == 0x10) {
-          memcpy(&tmp[tmpSize], &Answer[3], Answer[2]);
-          tmpSize += Answer[2];
+          if ((RspSize + Answer[2]) <= sizeof(Rsp)) {
+            memcpy(&Rsp[RspSize], &Answer[3], Answer[2]);
+          } else {
+            overflow = true;
+          }
+          RspSize += Answer[2];
           NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
                                   TIMEOUT_100MS);
         }
-        memcpy(&tmp[tmpSize], &Answer[3], Answer[2]);
-        tmpSize += Answer[2];
+        if (overflow || ((RspSize + Answer[2]) > sizeof(Rsp))) {
+          /* Answer larger than expected, let the state machine stop */
+          RspSize = 0;
+        } else {
+          memcpy(&Rsp[RspSize], &Answer[3], Answer[2]);
+          RspSize += Answer[2];
+        }
         /* Compute all chained frame into one unique answer */
-        memcpy(&Answer[3], tmp, tmpSize);
-        Answer[2] = tmpSize;
+        pRsp = Rsp;
       }
+      bytes += RspSize;
     }
   }
+
+  us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+  NxpNci_ReadStats.last_us = us;
+  NxpNci_ReadStats.last_exchanges = exchanges;
+  NxpNci_ReadStats.last_bytes = bytes;
+  NxpNci_ReadStats.last_fast_read =
+      (RfIntf.Protocol == PROT_T2T) && RW_NDEF_T2T_IsFastRead();
+  if ((NxpNci_ReadStats.count == 0) || (us < NxpNci_ReadStats.min_us)) {
+    NxpNci_ReadStats.min_us = us;
+  }
+  if (us > NxpNci_ReadStats.max_us) {
+    NxpNci_ReadStats.max_us = us;
+  }
+  NxpNci_ReadStats.total_us += us;
+  NxpNci_ReadStats.count++;
 }
 
 static void NxpNci_WriteNdef(NxpNci_RfIntf_t RfIntf) {
@@ -429,7 +504,34 @@ static void NxpNci_WriteNdef(NxpNci_RfIntf_t RfIntf) {
 }
 #endif  // #ifndef REMOVE_NDEF_SUPPORT
 
-static void NxpNci_PresenceCheck(NxpNci_RfIntf_t RfIntf) {
+#ifndef CONFIG_PN7160_PRESENCE_CHECK_INTERVAL_MS
+#define CONFIG_PN7160_PRESENCE_CHECK_INTERVAL_MS 100
+#endif
+#ifndef CONFIG_PN7160_PRESENCE_LED_BLINK_MS
+#define CONFIG_PN7160_PRESENCE_LED_BLINK_MS 125
+#endif
+
+/* 卡片還在場時由 timer 閃 LED，presence check 本身不再 sleep 控制 LED */
+static void NxpNci_PresenceLedHandler(struct k_timer* timer) {
+  ARG_UNUSED(timer);
+  gpio_pin_toggle_dt(&PORT_STATUS_LED);
+}
+
+static K_TIMER_DEFINE(NxpNci_PresenceLedTimer, NxpNci_PresenceLedHandler,
+                      NULL);
+static K_SEM_DEFINE(NxpNci_PresenceAbortSem, 0, 1);
+static NxpNci_RemovalCallback_t* pNxpNci_RemovalCb;
+
+void NxpNci_RegisterRemovalCallback(void* pCb) {
+  pNxpNci_RemovalCb = (NxpNci_RemovalCallback_t*)pCb;
+}
+
+void NxpNci_AbortPresenceCheck(void) { k_sem_give(&NxpNci_PresenceAbortSem); }
+
+void NxpNci_ClearPresenceAbort(void) { k_sem_reset(&NxpNci_PresenceAbortSem); }
+
+/* Probe the tag once, return true while it answers */
+static bool NxpNci_PresenceProbe(NxpNci_RfIntf_t* pRfIntf) {
   bool status;
   uint8_t i;
   uint8_t Answer[MAX_NCI_FRAME_SIZE];
@@ -445,104 +547,91 @@ static void NxpNci_PresenceCheck(NxpNci_RfIntf_t RfIntf) {
   uint8_t NCIDeactivate[] = {0x21, 0x06, 0x01, 0x01};
   uint8_t NCISelectMIFARE[] = {0x21, 0x04, 0x03, 0x01, 0x80, 0x80};
 
-  switch (RfIntf.Protocol) {
+  switch (pRfIntf->Protocol) {
     case PROT_T1T:
-      do {
-        k_msleep(500);
-        NxpNci_HostTransceive(NCIPresCheckT1T, sizeof(NCIPresCheckT1T), Answer,
-                              sizeof(Answer), &AnswerSize);
-        NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
-                                TIMEOUT_100MS);
-      } while ((Answer[0] == 0x00) && (Answer[1] == 0x00));
-      break;
+      NxpNci_HostTransceive(NCIPresCheckT1T, sizeof(NCIPresCheckT1T), Answer,
+                            sizeof(Answer), &AnswerSize);
+      NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
+                              TIMEOUT_100MS);
+      return (Answer[0] == 0x00) && (Answer[1] == 0x00);
 
     case PROT_T2T:
-      do {
-        gpio_pin_set_dt(&PORT_STATUS_LED, HIGH);
-        k_msleep(125);
-        gpio_pin_set_dt(&PORT_STATUS_LED, LOW);
-        k_msleep(125);
-        gpio_pin_set_dt(&PORT_STATUS_LED, HIGH);
-        k_msleep(125);
-        gpio_pin_set_dt(&PORT_STATUS_LED, LOW);
-        k_msleep(125);
-        NxpNci_HostTransceive(NCIPresCheckT2T, sizeof(NCIPresCheckT2T), Answer,
-                              sizeof(Answer), &AnswerSize);
-        NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
-                                TIMEOUT_100MS);
-      } while ((Answer[0] == 0x00) && (Answer[1] == 0x00) &&
-               (Answer[2] == 0x11));
-      break;
+      NxpNci_HostTransceive(NCIPresCheckT2T, sizeof(NCIPresCheckT2T), Answer,
+                            sizeof(Answer), &AnswerSize);
+      NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
+                              TIMEOUT_100MS);
+      return (Answer[0] == 0x00) && (Answer[1] == 0x00) &&
+             (Answer[2] == 0x11);
 
     case PROT_T3T:
-      do {
-        k_msleep(500);
-        NxpNci_HostTransceive(NCIPresCheckT3T, sizeof(NCIPresCheckT3T), Answer,
-                              sizeof(Answer), &AnswerSize);
-        NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
-                                TIMEOUT_100MS);
-      } while ((Answer[0] == 0x61) && (Answer[1] == 0x08) &&
-               ((Answer[3] == 0x00) || (Answer[4] > 0x00)));
-      break;
+      NxpNci_HostTransceive(NCIPresCheckT3T, sizeof(NCIPresCheckT3T), Answer,
+                            sizeof(Answer), &AnswerSize);
+      NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
+                              TIMEOUT_100MS);
+      return (Answer[0] == 0x61) && (Answer[1] == 0x08) &&
+             ((Answer[3] == 0x00) || (Answer[4] > 0x00));
 
     case PROT_ISODEP:
-      do {
-        gpio_pin_set_dt(&PORT_STATUS_LED, HIGH);
-        k_msleep(125);
-        gpio_pin_set_dt(&PORT_STATUS_LED, LOW);
-        k_msleep(125);
-        gpio_pin_set_dt(&PORT_STATUS_LED, HIGH);
-        k_msleep(125);
-        gpio_pin_set_dt(&PORT_STATUS_LED, LOW);
-        k_msleep(125);
-        NxpNci_HostTransceive(NCIPresCheckIsoDep, sizeof(NCIPresCheckIsoDep),
-                              Answer, sizeof(Answer), &AnswerSize);
-        NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
-                                TIMEOUT_100MS);
-      } while ((Answer[0] == 0x6F) && (Answer[1] == 0x11) &&
-               (Answer[2] == 0x01) && (Answer[3] == 0x01));
-      break;
+      /* PN7160 ISO-DEP presence check (empty I-block / R(NAK)) */
+      NxpNci_HostTransceive(NCIPresCheckIsoDep, sizeof(NCIPresCheckIsoDep),
+                            Answer, sizeof(Answer), &AnswerSize);
+      NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
+                              TIMEOUT_100MS);
+      return (Answer[0] == 0x6F) && (Answer[1] == 0x11) &&
+             (Answer[2] == 0x01) && (Answer[3] == 0x01);
 
     case PROT_T5T:
-      do {
-        k_msleep(500);
-        for (i = 0; i < 8; i++)
-          NCIPresCheckIso15693[i + 6] = RfIntf.Info.NFC_VPP.ID[7 - i];
-        NxpNci_HostTransceive(NCIPresCheckIso15693,
-                              sizeof(NCIPresCheckIso15693), Answer,
-                              sizeof(Answer), &AnswerSize);
-        status = NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
-                                         TIMEOUT_100MS);
-      } while ((status == NXPNCI_SUCCESS) && (Answer[0] == 0x00) &&
-               (Answer[1] == 0x00) && (Answer[AnswerSize - 1] == 0x00));
-      break;
+      for (i = 0; i < 8; i++)
+        NCIPresCheckIso15693[i + 6] = pRfIntf->Info.NFC_VPP.ID[7 - i];
+      NxpNci_HostTransceive(NCIPresCheckIso15693, sizeof(NCIPresCheckIso15693),
+                            Answer, sizeof(Answer), &AnswerSize);
+      status = NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
+                                       TIMEOUT_100MS);
+      return (status == NXPNCI_SUCCESS) && (Answer[0] == 0x00) &&
+             (Answer[1] == 0x00) && (Answer[AnswerSize - 1] == 0x00);
 
     case PROT_MIFARE:
-      do {
-        gpio_pin_set_dt(&PORT_STATUS_LED, HIGH);
-        k_msleep(125);
-        gpio_pin_set_dt(&PORT_STATUS_LED, HIGH);
-        k_msleep(125);
-        gpio_pin_set_dt(&PORT_STATUS_LED, LOW);
-        k_msleep(125);
-        gpio_pin_set_dt(&PORT_STATUS_LED, HIGH);
-        k_msleep(125);
-        /* Deactivate target */
-        NxpNci_HostTransceive(NCIDeactivate, sizeof(NCIDeactivate), Answer,
-                              sizeof(Answer), &AnswerSize);
-        NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
-                                TIMEOUT_100MS);
-        /* Reactivate target */
-        NxpNci_HostTransceive(NCISelectMIFARE, sizeof(NCISelectMIFARE), Answer,
-                              sizeof(Answer), &AnswerSize);
-        NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
-                                TIMEOUT_100MS);
-      } while ((Answer[0] == 0x61) && (Answer[1] == 0x05));
-      break;
+      /* Deactivate target */
+      NxpNci_HostTransceive(NCIDeactivate, sizeof(NCIDeactivate), Answer,
+                            sizeof(Answer), &AnswerSize);
+      NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
+                              TIMEOUT_100MS);
+      /* Reactivate target */
+      NxpNci_HostTransceive(NCISelectMIFARE, sizeof(NCISelectMIFARE), Answer,
+                            sizeof(Answer), &AnswerSize);
+      NxpNci_WaitForReception(Answer, sizeof(Answer), &AnswerSize,
+                              TIMEOUT_100MS);
+      return (Answer[0] == 0x61) && (Answer[1] == 0x05);
 
     default:
       /* Nothing to do */
+      return false;
+  }
+}
+
+static void NxpNci_PresenceCheck(NxpNci_RfIntf_t RfIntf) {
+  bool removed = false;
+
+  /* Abort 訊號不在這裡清除：呼叫端檢查停止條件之前已用
+   * NxpNci_ClearPresenceAbort() 清過，之後送來的 abort 必須保留 */
+  k_timer_start(&NxpNci_PresenceLedTimer,
+                K_MSEC(CONFIG_PN7160_PRESENCE_LED_BLINK_MS),
+                K_MSEC(CONFIG_PN7160_PRESENCE_LED_BLINK_MS));
+
+  /* 每個 interval 探測一次；NxpNci_AbortPresenceCheck 會立刻打斷等待 */
+  while (k_sem_take(&NxpNci_PresenceAbortSem,
+                    K_MSEC(CONFIG_PN7160_PRESENCE_CHECK_INTERVAL_MS)) != 0) {
+    if (!NxpNci_PresenceProbe(&RfIntf)) {
+      removed = true;
       break;
+    }
+  }
+
+  k_timer_stop(&NxpNci_PresenceLedTimer);
+  gpio_pin_set_dt(&PORT_STATUS_LED, LOW);
+
+  if (removed && (pNxpNci_RemovalCb != NULL)) {
+    pNxpNci_RemovalCb(&RfIntf);
   }
 }
 
@@ -12,6 +12,7 @@
  *                          arising from its use.
  */
 #include <stdbool.h>
+#include <stdint.h>
 /***** NFC dedicated interface ****************************************/
 
 /*
@@ -225,12 +226,67 @@ void RW_NDEF_RegisterPullCallback(void* pCb);
  *  o READ_NDEF: extract NDEF message from the tag, previously registered
  * callback function will be called whenever complete NDEF message is found. o
  * WRITE_NDEF: write previously registered NDEF message to the tag o
- * PRESENCE_CHECK: perform presence check until tag has been removed (function
- * is blocking until card is removed)
+ * PRESENCE_CHECK: probe the tag every CONFIG_PN7160_PRESENCE_CHECK_INTERVAL_MS
+ * until it has been removed (removal callback is then called) or
+ * NxpNci_AbortPresenceCheck() is called
  */
 void NxpNci_ProcessReaderMode(NxpNci_RfIntf_t RfIntf,
                               NxpNci_RW_Operation_t Operation);
 
+#ifndef REMOVE_NDEF_SUPPORT
+/*
+ * NDEF read timing, from the start of READ_NDEF operation on an activated tag
+ * to the end of the read (NCI round trips to the tag included)
+ */
+typedef struct {
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t total_us;
+  uint32_t last_us;
+  uint32_t last_exchanges; /* tag commands sent by the last read */
+  uint32_t last_bytes;     /* bytes received from the tag by the last read */
+  bool last_fast_read;     /* last read used NTAG21x FAST_READ */
+} NxpNci_ReadStats_t;
+
+/*
+ * Get NDEF read timing statistics
+ * - pStats: filled with statistics since boot or last reset
+ */
+void NxpNci_GetReadStats(NxpNci_ReadStats_t* pStats);
+
+/*
+ * Clear NDEF read timing statistics
+ */
+void NxpNci_ResetReadStats(void);
+#endif  // #ifndef REMOVE_NDEF_SUPPORT
+
+/*
+ * Callback called when the tag under PRESENCE_CHECK has been removed
+ * - pRfIntf: removed NFC remote device properties
+ */
+typedef void NxpNci_RemovalCallback_t(NxpNci_RfIntf_t* pRfIntf);
+
+/*
+ * Register function called when a tag leaves the field during PRESENCE_CHECK
+ * - pCb: pointer to function to be called back when tag has been removed
+ */
+void NxpNci_RegisterRemovalCallback(void* pCb);
+
+/*
+ * Stop a running PRESENCE_CHECK operation without waiting for tag removal
+ * (the removal callback is not called), may be called from any thread.
+ * An abort requested before PRESENCE_CHECK starts makes it return at once
+ */
+void NxpNci_AbortPresenceCheck(void);
+
+/*
+ * Drop a pending abort request. Call it before testing the condition that
+ * the aborting thread clears before calling NxpNci_AbortPresenceCheck(),
+ * so that an abort issued after the test is not lost
+ */
+void NxpNci_ClearPresenceAbort(void);
+
 /*
  * Perform RAW transceive operation (send then receive) with the remote tag
  * - pCommand: pointer to the command to send
@@ -11,6 +11,9 @@
  * copyright or trademark. NXP must not be liable for any loss or damage
  *                          arising from its use.
  */
+#ifndef TML_H_
+#define TML_H_
+
 #include <stdint.h>
 
 #define TIMEOUT_INFINITE 0
@@ -24,3 +27,17 @@ extern void tml_Send(uint8_t* pBuffer, uint16_t BufferLen,
                      uint16_t* pBytesSent);
 extern void tml_Receive(uint8_t* pBuffer, uint16_t BufferLen, uint16_t* pBytes,
                         uint16_t timeout);
+
+/* NCI 往返時間統計 (Command 送出到 PN7160 IRQ 拉高) */
+typedef struct {
+  uint32_t count;
+  uint32_t timeouts;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t total_us;
+} tml_rtt_stats_t;
+
+void tml_GetRttStats(tml_rtt_stats_t* pStats);
+void tml_ResetRttStats(void);
+
+#endif /* TML_H_ */
@@ -13,16 +13,38 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 #include <tool.h>
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/drivers/i2c.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
 
 #include "driver_config.h"
+#include "tml.h"
 #include "types.h"
 
+/* PN7160 有資料要給 Host 時拉高 IRQ，由 GPIO 中斷釋放 */
+static K_SEM_DEFINE(tml_irq_sem, 0, 1);
+static struct gpio_callback tml_irq_cb;
+static bool tml_irq_enabled;
+
+/* NCI 往返時間：tml_Send 到 IRQ 拉高。RTT 只有幾百 us，k_cycle_get_32()
+ * 在 nRF52840 上是 32.768kHz RTC (一格約 30us)，改用 DWT cycle counter */
+static tml_rtt_stats_t tml_rtt;
+static timing_t tml_tx_ts;
+static bool tml_rtt_pending;
+
+static void tml_IrqHandler(const struct device* dev, struct gpio_callback* cb,
+                           uint32_t pins) {
+  k_sem_give(&tml_irq_sem);
+}
+
 static uint8_t tml_Init(void) {
+  timing_init();
+  timing_start();
   /* I2C */
   if (!device_is_ready(pn7160_i2c.bus)) {
     printk("[PN7150] I2C bus %s is not ready!\n\r", pn7160_i2c.bus->name);
@@ -37,6 +59,19 @@ static uint8_t tml_Init(void) {
       printk("[PN7150] IRQ setting input fail\n\r");
     }
     printk("[PN7150] IRQ setting input Success\n\r");
+
+    /* tml_Connect 可能被呼叫多次，callback 只註冊一次 */
+    if (!tml_irq_enabled) {
+      gpio_init_callback(&tml_irq_cb, tml_IrqHandler, BIT(pn7160_irq.pin));
+      if ((gpio_add_callback(pn7160_irq.port, &tml_irq_cb) == 0) &&
+          (gpio_pin_interrupt_configure_dt(&pn7160_irq,
+                                           GPIO_INT_EDGE_TO_ACTIVE) == 0)) {
+        tml_irq_enabled = true;
+      } else {
+        /* 退回輪詢 */
+        printk("[PN7150] IRQ interrupt setting fail, polling\n\r");
+      }
+    }
   }
   /* Configure GPIO for RESET pin */
   if (device_is_ready(pn7160_reset.port)) {
@@ -117,7 +152,58 @@ static uint8_t tml_Rx(uint8_t* pBuff, uint16_t buffLen, uint16_t* pBytesRead) {
   return ret;
 }
 
+static void tml_RttUpdate(bool received) {
+  timing_t now;
+  uint32_t us;
+
+  if (!tml_rtt_pending) {
+    return;
+  }
+  tml_rtt_pending = false;
+  if (!received) {
+    tml_rtt.timeouts++;
+    return;
+  }
+  now = timing_counter_get();
+  us = (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&tml_tx_ts, &now)) /
+                  NSEC_PER_USEC);
+  if ((tml_rtt.count == 0) || (us < tml_rtt.min_us)) {
+    tml_rtt.min_us = us;
+  }
+  if (us > tml_rtt.max_us) {
+    tml_rtt.max_us = us;
+  }
+  tml_rtt.total_us += us;
+  tml_rtt.count++;
+}
+
 static uint8_t tml_WaitForRx(uint16_t timeout) {
+  if (tml_irq_enabled) {
+    int64_t deadline = k_uptime_get() + ((timeout == 0) ? 3000 : timeout);
+
+    for (;;) {
+      int64_t remain;
+
+      /* 先清掉舊的 give 再看腳位，IRQ 已經是 High 就不用等 */
+      k_sem_reset(&tml_irq_sem);
+      if (gpio_pin_get_dt(&pn7160_irq) != LOW) {
+        tml_RttUpdate(true);
+        return SUCCESS;
+      }
+      remain = deadline - k_uptime_get();
+      if ((remain <= 0) ||
+          (k_sem_take(&tml_irq_sem, K_MSEC(remain)) != 0)) {
+        break;
+      }
+    }
+    if (gpio_pin_get_dt(&pn7160_irq) != LOW) {
+      tml_RttUpdate(true);
+      return SUCCESS;
+    }
+    tml_RttUpdate(false);
+    return (timeout == 0) ? 0xFF : ERROR;
+  }
+
   if (timeout == 0) {
     int16_t to = 3000; /* 3 seconds */
     while (gpio_pin_get_dt(&pn7160_irq) == LOW) {
@@ -125,6 +211,7 @@ static uint8_t tml_WaitForRx(uint16_t timeout) {
       to -= 1;
       if (to <= 0) {
         // printk("IRQ Timeout (3s)!\n");
+        tml_RttUpdate(false);
         return 0xFF;
       }
     }
@@ -135,10 +222,12 @@ static uint8_t tml_WaitForRx(uint16_t timeout) {
       to -= 1;
       if (to <= 0) {
         // printk("IRQ Timeout (%dms)!\n", timeout);
+        tml_RttUpdate(false);
         return ERROR;
       }
     }
   }
+  tml_RttUpdate(true);
   return SUCCESS;
 }
 
@@ -154,6 +243,8 @@ void tml_Send(uint8_t* pBuffer, uint16_t BufferLen, uint16_t* pBytesSent) {
     *pBytesSent = 0;
   } else {
     *pBytesSent = BufferLen;
+    tml_tx_ts = timing_counter_get();
+    tml_rtt_pending = true;
   }
 }
 
@@ -168,3 +259,7 @@ void tml_Receive(uint8_t* pBuffer, uint16_t BufferLen, uint16_t* pBytes,
   } else
     tml_Rx(pBuffer, BufferLen, pBytes);
 }
+
+void tml_GetRttStats(tml_rtt_stats_t* pStats) { *pStats = tml_rtt; }
+
+void tml_ResetRttStats(void) { memset(&tml_rtt, 0, sizeof(tml_rtt)); }
@@ -65,6 +65,15 @@ unsigned mode = 0
 #endif  // ifdef RW_SUPPORT
     ;
 
+#ifndef REMOVE_RW_SUPPORT
+/* Card removal callback - called from the presence check as soon as the
+ * card stops answering, discovery is restarted right after */
+static void CardRemoved_Cb(NxpNci_RfIntf_t* pRfIntf) {
+  (void)pRfIntf;
+  PRINTF("[PN7150] CARD REMOVED\n");
+}
+#endif  // #ifndef REMOVE_RW_SUPPORT
+
 #ifdef RW_SUPPORT
 #ifdef RW_RAW_EXCHANGE
 void PCD_MIFARE_scenario(void) {
@@ -321,10 +330,13 @@ void task_nfc_reader(NxpNci_RfIntf_t RfIntf) {
 
       // case PROT_ISO15693:
       case PROT_T5T:
-#ifdef RW_RAW_EXCHANGE
+#ifndef RW_RAW_EXCHANGE
+        /* Process NDEF message read */
+        NxpNci_ProcessReaderMode(RfIntf, READ_NDEF);
+#else   // ifndef RW_RAW_EXCHANGE
         /* Run dedicated scenario to demonstrate ISO15693 card management */
         PCD_ISO15693_scenario();
-#endif  // ifdef RW_RAW_EXCHANGE
+#endif  // ifndef RW_RAW_EXCHANGE
         break;
 
       case PROT_MIFARE:
@@ -364,11 +376,13 @@ void task_nfc_reader(NxpNci_RfIntf_t RfIntf) {
     k_msleep(100);
   }
 
-  /* Wait for card removal - 但只在 nfc_run_flag 為 true 時 */
+  /* Wait for card removal - 但只在 nfc_run_flag 為 true 時。
+   * 先清掉舊的 abort 再檢查旗標："stop" 先清旗標再 abort，所以兩者
+   * 的任何交錯都不會讓 presence check 錯過停止要求 */
+  NxpNci_ClearPresenceAbort();
   if (nfc_run_flag && nfc_mode != 2) {
     NxpNci_ProcessReaderMode(RfIntf, PRESENCE_CHECK);
   }
-  PRINTF("[PN7150] CARD REMOVED\n");
 
   /* 如果 nfc_run_flag 為 false，不重新啟動發現 */
   if (!nfc_run_flag) {
@@ -531,6 +545,11 @@ void task_nfc(void) {
   RW_NDEF_RegisterPullCallback(NdefPull_Cb);
 #endif  // ifdef RW_SUPPORT
 
+#ifndef REMOVE_RW_SUPPORT
+  /* Register callback for removal of remote cards */
+  NxpNci_RegisterRemovalCallback(CardRemoved_Cb);
+#endif  // #ifndef REMOVE_RW_SUPPORT
+
   /* Open connection to NXPNCI device */
   if (NxpNci_Connect() == NFC_ERROR) {
     PRINTF("Error: cannot connect to NXPNCI device\n");
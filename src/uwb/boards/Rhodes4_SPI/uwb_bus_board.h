@@ -59,6 +59,15 @@ typedef struct {
    * 直接使用 Zephyr 的 semaphore 結構。
    */
   void* mIrqWaitSem;
+  /* 最近一次 UWBS IRQ (Active) 觸發時的 phOsalUwb_GetCycles()，量測延遲用 */
+  volatile uint32_t mIrqCycles;
+
+  /* UWBS IRQ 回到 Inactive 時由 ISR 釋放，寫入前用來等待 UWBS Ready */
+  void* mReadyWaitSem;
+
+  /* uwb_bus_data_tx_sg_start() 的 Buffer 描述，須保留到傳輸完成 */
+  struct spi_buf mTxBufs[2];
+  struct spi_buf_set mTxSet;
 
 } uwb_bus_board_ctx_t;
 
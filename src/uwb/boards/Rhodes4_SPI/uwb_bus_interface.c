@@ -16,6 +16,7 @@
 
 /* System includes */
 
+#include <nrfx.h>
 #include <stdint.h>
 #include <uwb_bus_board.h>
 #include <uwb_bus_interface.h>
@@ -35,6 +36,122 @@
 /* This semaphore is signaled when SPI write is completed successfully*/
 void* mSpiTransferSem = NULL;
 
+/* Result of the last transfer started with uwb_bus_spi_transceive_start();
+ * written from the SPI ISR in asynchronous mode */
+static volatile int mSpiTransferResult;
+
+#if defined(CONFIG_UWB_TML_SPI_ASYNC)
+/* Set when a transfer is handed to the driver, cleared by its completion
+ * callback. While set, EasyDMA may still read tx and write rx buffers. */
+static volatile bool mSpiTransferPending;
+
+/* SPI Driver 完成傳輸後在中斷中呼叫，喚醒等待中的執行緒 */
+static void uwb_bus_spi_xfer_done(const struct device* dev, int result,
+                                  void* data) {
+  ARG_UNUSED(dev);
+  ARG_UNUSED(data);
+  mSpiTransferResult = result;
+  mSpiTransferPending = false;
+  phOsalUwb_ProduceSemaphore(mSpiTransferSem);
+}
+
+/* Zephyr 的 SPI API 無法取消進行中的非同步傳輸 (強制 uninit 會讓 driver
+ * 的 context lock 永遠不被釋放)，只能等 Callback。等不到時保留
+ * mSpiTransferPending，之後的傳輸都會失敗，直到 Callback 出現為止。 */
+static bool uwb_bus_spi_xfer_drain(void) {
+  uint32_t waited = 0;
+
+  while (mSpiTransferPending && waited < MAX_UWBS_SPI_TRANSFER_TIMEOUT) {
+    (void)phOsalUwb_ConsumeSemaphore_WithTimeout(mSpiTransferSem, 10);
+    waited += 10;
+  }
+  return !mSpiTransferPending;
+}
+#endif
+
+uwb_bus_status_t uwb_bus_spi_transceive_start(uwb_bus_board_ctx_t* pCtx,
+                                              const struct spi_buf_set* tx,
+                                              const struct spi_buf_set* rx) {
+  int ret;
+
+  if (pCtx == NULL) {
+    LOG_ERR("uwbs bus context is NULL");
+    return kUWB_bus_Status_FAILED;
+  }
+
+#if defined(CONFIG_UWB_TML_SPI_ASYNC)
+  /* * 非同步模式:
+   * 交給 SPIM EasyDMA 後立即返回，呼叫端可以先做別的事，再呼叫
+   * uwb_bus_spi_transceive_wait() 在 mSpiTransferSem 上睡眠等待完成。
+   */
+  if (mSpiTransferPending && !uwb_bus_spi_xfer_drain()) {
+    LOG_ERR("SPI async transfer still pending, bus unavailable");
+    return kUWB_bus_Status_FAILED;
+  }
+  /* 清掉前一次逾時後才到的 Callback 所留下的訊號 (semaphore limit 為 1) */
+  (void)phOsalUwb_ConsumeSemaphore_WithTimeout(mSpiTransferSem, 0);
+
+  mSpiTransferPending = true;
+  ret = spi_transceive_cb(pCtx->spi.bus, &pCtx->spi.config, tx, rx,
+                          uwb_bus_spi_xfer_done, NULL);
+  if (ret < 0) {
+    mSpiTransferPending = false;
+    LOG_ERR("SPI async transfer start failed: %d", ret);
+    return kUWB_bus_Status_FAILED;
+  }
+#else
+  /* 同步模式: Driver 內部阻塞直到傳輸完成，結果留給 wait 回報 */
+  ret = spi_transceive_dt(&pCtx->spi, tx, rx);
+  mSpiTransferResult = ret;
+#endif
+  return kUWB_bus_Status_OK;
+}
+
+uwb_bus_status_t uwb_bus_spi_transceive_wait(uwb_bus_board_ctx_t* pCtx) {
+  int ret;
+
+  if (pCtx == NULL) {
+    LOG_ERR("uwbs bus context is NULL");
+    return kUWB_bus_Status_FAILED;
+  }
+
+#if defined(CONFIG_UWB_TML_SPI_ASYNC)
+  /* 傳輸期間 CPU 可以讓給 Shell / NFC / EM4095 等執行緒 */
+  if (phOsalUwb_ConsumeSemaphore_WithTimeout(
+          mSpiTransferSem, MAX_UWBS_SPI_TRANSFER_TIMEOUT) !=
+      UWBSTATUS_SUCCESS) {
+    /* 逾時也不能直接返回：呼叫端會重用 Buffer，而 EasyDMA 仍可能在寫 */
+    LOG_ERR("SPI async transfer timed out");
+    if (!uwb_bus_spi_xfer_drain()) {
+      LOG_ERR("SPI async transfer did not complete");
+    }
+    return kUWB_bus_Status_FAILED;
+  }
+#endif
+  ret = mSpiTransferResult;
+
+  if (ret < 0) {
+    LOG_ERR("SPI transfer failed: %d", ret);
+    return kUWB_bus_Status_FAILED;
+  }
+  return kUWB_bus_Status_OK;
+}
+
+uwb_bus_status_t uwb_bus_spi_transceive(uwb_bus_board_ctx_t* pCtx,
+                                        const struct spi_buf_set* tx,
+                                        const struct spi_buf_set* rx) {
+  if (uwb_bus_spi_transceive_start(pCtx, tx, rx) != kUWB_bus_Status_OK) {
+    return kUWB_bus_Status_FAILED;
+  }
+  return uwb_bus_spi_transceive_wait(pCtx);
+}
+
+bool uwb_bus_dma_readable(const void* pBuf) {
+  /* SPIM EasyDMA 只能存取 Data RAM。回傳 false 時 (例如 flash 上的 FW
+   * image)，uwb_fwdl_ram.c 會先把每個 HBCI chunk 複製到 RAM staging buffer */
+  return nrfx_is_in_ram(pBuf);
+}
+
 uwb_bus_status_t uwb_bus_init(uwb_bus_board_ctx_t* pCtx) {
   if (pCtx == NULL) {
     LOG_ERR("uwbs bus context is NULL");
@@ -84,6 +201,21 @@ uwb_bus_status_t uwb_bus_init(uwb_bus_board_ctx_t* pCtx) {
     return kUWB_bus_Status_FAILED;
   }
 
+#if defined(CONFIG_UWB_TML_SPI_ASYNC)
+  /* mSpiTransferSem: 非同步 SPI 傳輸完成時由 Callback 通知 */
+  if (mSpiTransferSem == NULL &&
+      phOsalUwb_CreateSemaphore(&mSpiTransferSem, 0) != UWBSTATUS_SUCCESS) {
+    LOG_ERR("Error: could not create mSpiTransferSem");
+    return kUWB_bus_Status_FAILED;
+  }
+#endif
+
+  /* mReadyWaitSem: IRQ 拉低 (UWBS Ready) 時由 ISR 通知寫入端 */
+  if (phOsalUwb_CreateSemaphore(&pCtx->mReadyWaitSem, 0) != UWBSTATUS_SUCCESS) {
+    LOG_ERR("Error: could not create mReadyWaitSem");
+    return kUWB_bus_Status_FAILED;
+  }
+
   return kUWB_bus_Status_OK;
 }
 
@@ -120,6 +252,13 @@ uwb_bus_status_t uwb_bus_deinit(uwb_bus_board_ctx_t* pCtx) {
     pCtx->mIrqWaitSem = NULL;
   }
 
+  if (pCtx->mReadyWaitSem != NULL) {
+    phOsalUwb_ProduceSemaphore(pCtx->mReadyWaitSem);
+    phOsalUwb_Delay(2);
+    phOsalUwb_DeleteSemaphore(&pCtx->mReadyWaitSem);
+    pCtx->mReadyWaitSem = NULL;
+  }
+
   /* 清除 Context 記憶體 (memset) */
   /* 注意：這會把包含 SPI/GPIO spec 在內的所有資料清空 */
   phOsalUwb_SetMemory(pCtx, 0, sizeof(uwb_bus_board_ctx_t));
@@ -21,8 +21,14 @@ extern eRhodes4Revision gRhodesV4_Rev;
 static uwbs_io_callback
     mCallbacks[FSL_FEATURE_PINT_NUMBER_OF_CONNECTED_OUTPUTS];
 
+/* CE / RTC_SYNC 只在第一次 init 時設為 Inactive。之後 phTmlUwb_Init
+ * (UwbApi_ShutDown -> UwbApi_Init) 不能再拉低 CE，否則 SR1xx 斷電，RAM
+ * 中已下載的 FW 跟著消失，warm start 就不可能成功。 */
+static bool mOutputsConfigured;
+
 void uwb_bus_io_irq_cb(void* args) {
   uwb_bus_board_ctx_t* pCtx = (uwb_bus_board_ctx_t*)args;
+  pCtx->mIrqCycles = phOsalUwb_GetCycles();
   // Signal TML read task
   phOsalUwb_ProduceSemaphore(pCtx->mIrqWaitSem);
 }
@@ -36,6 +42,17 @@ static void zephyr_gpio_wrapper_uwb(const struct device* dev,
   uwb_bus_board_ctx_t* pCtx =
       CONTAINER_OF(cb, uwb_bus_board_ctx_t, irq_cb_struct);
 
+  /* IRQ 設定為雙邊觸發:
+   * - Active   : UWBS 有資料要送，呼叫上層 callback (通知 TML 讀取)
+   * - Inactive : UWBS 已 Ready，通知等待寫入的執行緒
+   */
+  if (gpio_pin_get_dt(&pCtx->gpio_irq) <= 0) {
+    if (pCtx->mReadyWaitSem != NULL) {
+      phOsalUwb_ProduceSemaphore(pCtx->mReadyWaitSem);
+    }
+    return;
+  }
+
   /* 呼叫儲存的目標函式 */
   if (pCtx->target_cb_UWB.fn) {
     pCtx->target_cb_UWB.fn(pCtx->target_cb_UWB.args);
@@ -76,17 +93,20 @@ uwb_bus_status_t uwb_bus_io_init(uwb_bus_board_ctx_t* pCtx) {
   /* 建議也在這裡一併初始化，避免後續 io_val_set 操作未配置的腳位 */
   pCtx->gpio_ce =
       (struct gpio_dt_spec)GPIO_DT_SPEC_GET_OR(DT_ALIAS(uwbcegpio), gpios, {0});
-  if (pCtx->gpio_ce.port && device_is_ready(pCtx->gpio_ce.port)) {
+  if (!mOutputsConfigured && pCtx->gpio_ce.port &&
+      device_is_ready(pCtx->gpio_ce.port)) {
     /* 預設輸出為 Low (Inactive) */
     gpio_pin_configure_dt(&pCtx->gpio_ce, GPIO_OUTPUT_INACTIVE);
   }
 
   pCtx->gpio_sync = (struct gpio_dt_spec)GPIO_DT_SPEC_GET_OR(
       DT_ALIAS(uwbsyncgpio), gpios, {0});
-  if (pCtx->gpio_sync.port && device_is_ready(pCtx->gpio_sync.port)) {
+  if (!mOutputsConfigured && pCtx->gpio_sync.port &&
+      device_is_ready(pCtx->gpio_sync.port)) {
     /* 預設輸出為 Low (Inactive) */
     gpio_pin_configure_dt(&pCtx->gpio_sync, GPIO_OUTPUT_INACTIVE);
   }
+  mOutputsConfigured = true;
 
   /* 4. 呼叫 Enable 流程 (註冊中斷 Callback) */
   uwb_bus_io_uwbs_irq_enable(pCtx);
@@ -129,9 +149,11 @@ uwb_bus_status_t uwb_bus_io_irq_en(uwb_bus_board_ctx_t* pCtx, uwbs_io_t irqPin,
       storage_cb = &pCtx->target_cb_UWB;
       wrapper_fn = zephyr_gpio_wrapper_uwb;
 
-      /* NXP Code: kPINT_PinIntEnableRiseEdge -> Rising Edge */
-      /* 使用 EDGE_TO_ACTIVE 會自動參考 Device Tree 的 Active High/Low 設定 */
-      trigger_flags = GPIO_INT_EDGE_TO_ACTIVE;
+      /* NXP Code: kPINT_PinIntEnableRiseEdge -> Rising Edge
+       * 另外需要 Inactive 邊緣來得知 UWBS Ready (寫入前的 handshake)，
+       * 因此使用雙邊觸發，由 zephyr_gpio_wrapper_uwb 依電位分派。
+       */
+      trigger_flags = GPIO_INT_EDGE_BOTH;
       break;
 
     case kUWBS_IO_I_VENUS_IRQ:
@@ -324,4 +346,25 @@ uwb_bus_status_t uwb_bus_io_irq_wait(uwb_bus_board_ctx_t* pCtx,
     return kUWB_bus_Status_FAILED;
   }
   return kUWB_bus_Status_OK;
-}
\ No newline at end of file
+}
+
+uwb_bus_status_t uwb_bus_io_ready_wait(uwb_bus_board_ctx_t* pCtx,
+                                       uint32_t timeout_ms) {
+  if (pCtx == NULL) {
+    LOG_E("uwbs bus context is NULL");
+    return kUWB_bus_Status_FAILED;
+  }
+
+  /* 清掉先前殘留的 Ready 訊號，再檢查目前電位，避免錯過邊緣 */
+  (void)phOsalUwb_ConsumeSemaphore_WithTimeout(pCtx->mReadyWaitSem, 0);
+  if (gpio_pin_get_dt(&pCtx->gpio_irq) <= 0) {
+    return kUWB_bus_Status_OK;
+  }
+
+  if (phOsalUwb_ConsumeSemaphore_WithTimeout(pCtx->mReadyWaitSem,
+                                             timeout_ms) != UWBSTATUS_SUCCESS) {
+    LOG_D("uwb_bus_io_ready_wait timed out");
+    return kUWB_bus_Status_FAILED;
+  }
+  return kUWB_bus_Status_OK;
+}
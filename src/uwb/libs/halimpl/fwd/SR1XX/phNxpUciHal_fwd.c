@@ -22,6 +22,10 @@
 #include <phNxpUciHal_utils.h>
 #include <phTmlUwb_transport.h>
 
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+
 #include "phNxpLogApis_UwbApi.h"
 #include "phUwb_BuildConfig.h"
 #include "uwb_fwdl_provider.h"
@@ -36,6 +40,71 @@ phHbci_MosiApdu_t gphHbci_MosiApdu;
 phHbci_MisoApdu_t gphHbci_MisoApdu;
 Options_t gOpts;
 
+/* 最近一次 HBCI 下載的大小與耗時 (phHbci_Master 前後)。下載要好幾百 ms，
+ * 用 k_uptime_get_32() (RTC) 量到 ms 就夠，不是 us 等級的 benchmark */
+static uint32_t gFwDlBytes;
+static uint32_t gFwDlMs;
+
+/******************************************************************************
+ * Function         phNxpUciHal_fw_download_stats
+ *
+ * Description      Reports size and duration of the last HBCI download.
+ *
+ * Returns          None
+ *
+ ******************************************************************************/
+void phNxpUciHal_fw_download_stats(uint32_t* pBytes, uint32_t* pMs) {
+  *pBytes = gFwDlBytes;
+  *pMs = gFwDlMs;
+}
+
+#if IS_ENABLED(CONFIG_UWB_FWDL_CACHE)
+/*
+ * 最近一次成功下載到 SR1xx 的 FW image。Helios 只有在 init() 拉 CE 時才會
+ * 回到 HBCI，UwbApi_ShutDown 不會斷電，所以只要下次 UwbApi_Init 給的是同一份
+ * image (位址、大小、CRC32 都相同)，晶片上跑的就仍是這份 FW。
+ */
+static struct {
+  const uint8_t* pImage;
+  uint32_t dwSize;
+  uint32_t dwCrc;
+  bool bValid;
+} gFwCache;
+
+/******************************************************************************
+ * Function         phNxpUciHal_fw_cache_match
+ *
+ * Description      Checks whether the image selected by uwb_fwdl_getFwImage()
+ *                  is the one last downloaded to the UWBS.
+ *
+ * Returns          TRUE when address, size and CRC32 all match
+ *
+ ******************************************************************************/
+bool phNxpUciHal_fw_cache_match(void) {
+  if (!gFwCache.bValid || (fwdlCtx.fwImgPtr != gFwCache.pImage) ||
+      (fwdlCtx.fwSize != gFwCache.dwSize)) {
+    return FALSE;
+  }
+  /* image 可能放在 RAM (由 provider 載入)，每次都重新計算 CRC */
+  if (crc32_ieee(fwdlCtx.fwImgPtr, fwdlCtx.fwSize) != gFwCache.dwCrc) {
+    NXPLOG_UWB_FWDNLD_D("FW image CRC changed since last download");
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/******************************************************************************
+ * Function         phNxpUciHal_fw_cache_invalidate
+ *
+ * Description      Forgets the cached image, forcing the next init to run a
+ *                  full download.
+ *
+ * Returns          None
+ *
+ ******************************************************************************/
+void phNxpUciHal_fw_cache_invalidate(void) { gFwCache.bValid = FALSE; }
+#endif  // CONFIG_UWB_FWDL_CACHE
+
 /*************************************************************************************/
 /*   LOCAL FUNCTIONS */
 /*************************************************************************************/
@@ -428,6 +497,7 @@ uint8_t phHbci_CalcLrc(uint8_t* pBuf, uint16_t bufSz) {
  ******************************************************************************/
 int phNxpUciHal_fw_download() {
   uint32_t err = 0;
+  uint32_t startMs;
   phHbci_General_Command_t cmd;
 
   NXPLOG_UWB_FWDNLD_D(
@@ -457,6 +527,14 @@ int phNxpUciHal_fw_download() {
     NXPLOG_UWB_FWDNLD_D("HIF Image mode.");
   }
 
+#if IS_ENABLED(CONFIG_UWB_FWDL_CACHE)
+  /* uwb_fwdl_downloadFw() 會移動 fwImgPtr，先記下 image 再開始下載 */
+  gFwCache.bValid = FALSE;
+  gFwCache.pImage = fwdlCtx.fwImgPtr;
+  gFwCache.dwSize = fwdlCtx.fwSize;
+  gFwCache.dwCrc = crc32_ieee(fwdlCtx.fwImgPtr, fwdlCtx.fwSize);
+#endif  // CONFIG_UWB_FWDL_CACHE
+
   phTmlUwb_set_hbci_mode();
   gphHbci_MisoApdu.payload =
       (uint8_t*)phOsalUwb_GetMemory(PHHBCI_MAX_LEN_PAYLOAD_MISO);
@@ -464,11 +542,25 @@ int phNxpUciHal_fw_download() {
     NXPLOG_UWB_FWDNLD_E("Unable to allocate buffer");
     return 1;
   }
+  gFwDlBytes = fwdlCtx.fwSize;
+  startMs = k_uptime_get_32();
   if (phHbci_Success != phHbci_Master(cmd)) {
     NXPLOG_UWB_FWDNLD_E("Failure!");
     err = 1;
   }
+  gFwDlMs = k_uptime_get_32() - startMs;
   phTmlUwb_set_uci_mode();
+  if (err == 0) {
+    NXPLOG_UWB_FWDNLD_I("FW download: %u bytes in %u ms (%u KiB/s)",
+                        gFwDlBytes, gFwDlMs,
+                        gFwDlMs ? (uint32_t)((uint64_t)gFwDlBytes * 1000U /
+                                             1024U / gFwDlMs)
+                                : 0U);
+  }
+
+#if IS_ENABLED(CONFIG_UWB_FWDL_CACHE)
+  gFwCache.bValid = (err == 0);
+#endif  // CONFIG_UWB_FWDL_CACHE
   
   /* Warm-up delay after switching from HBCI to UCI mode
    * This allows the antenna system and calibration circuits to stabilize
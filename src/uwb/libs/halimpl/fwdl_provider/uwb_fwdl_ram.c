@@ -18,6 +18,8 @@
 #if (0 == UWB_BOARD_ENABLE_EXT_FLASH_BASED_FW_DOWNLOAD)
 /* RAM Based FW Download */
 #include <phTmlUwb_transport.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
 
 #include "UwbAdaptation.h"
 #include "phNxpLogApis_UwbApi.h"
@@ -44,73 +46,174 @@ UWBStatus_t uwb_fwdl_getFwImage(phUwbFWImageContext_t* pfwImageCtx) {
   return kUWBSTATUS_SUCCESS;
 }
 
+/*
+ * 一個 HBCI data segment：Header (CLS/INS/LEN) 先送出並等 ACK，接著送 data
+ * 與 LRC。LRC 涵蓋 Header 與 data，所以下一個 segment 可以在目前這個還在
+ * 傳輸、或 Helios 還在處理時就先準備好。
+ */
+typedef struct uwb_fwdl_chunk {
+  const uint8_t* pTx; /* 送出的 data，可能是 staging buffer 或 image 本身 */
+  uint32_t dataSz;
+  uint16_t len; /* Header 的 LEN 欄位 */
+  uint8_t lrc;
+} uwb_fwdl_chunk_t;
+
+/* 複製 data 並同時累加 byte sum (LRC 用)，pDst 為 NULL 時只計算 sum。
+ * 每次處理 4 bytes (memcpy 讓 Cortex-M4 產生非對齊的 LDR/STR)，兩個累加器
+ * 各放兩個 16-bit lane，最多 256 個 word 就折疊一次以免 lane 溢位。 */
+static uint8_t uwb_fwdl_copySum(uint8_t* pDst, const uint8_t* pSrc,
+                                uint32_t len) {
+  uint8_t sum = 0;
+
+  while (len >= 4U) {
+    uint32_t words = MIN(len / 4U, 256U);
+    uint32_t even = 0;
+    uint32_t odd = 0;
+
+    for (uint32_t i = 0; i < words; i++) {
+      uint32_t w;
+      memcpy(&w, pSrc, sizeof(w));
+      if (pDst != NULL) {
+        memcpy(pDst, &w, sizeof(w));
+        pDst += sizeof(w);
+      }
+      pSrc += sizeof(w);
+      even += w & 0x00FF00FFU;
+      odd += (w >> 8) & 0x00FF00FFU;
+    }
+    sum = (uint8_t)(sum + (even & 0xFFFFU) + (even >> 16) + (odd & 0xFFFFU) +
+                    (odd >> 16));
+    len -= words * 4U;
+  }
+
+  while (len--) {
+    if (pDst != NULL) {
+      *pDst++ = *pSrc;
+    }
+    sum = (uint8_t)(sum + *pSrc++);
+  }
+  return sum;
+}
+
+/* 從 image 取出下一個 segment；Helios 看得到的 image 直接送出，否則先搬到
+ * pStage (Data RAM) 再送 */
+static void uwb_fwdl_prepareChunk(uwb_fwdl_provider_t* pCtx,
+                                  uwb_fwdl_chunk_t* pChunk, uint8_t* pStage) {
+  uint8_t sum;
+
+  if (pCtx->fwSize > PHHBCI_MAX_LEN_DATA_MOSI) {
+    pChunk->dataSz = PHHBCI_MAX_LEN_DATA_MOSI;
+    pChunk->len = PHHBCI_APDU_SEG_FLAG;
+  } else {
+    pChunk->dataSz = pCtx->fwSize;
+    pChunk->len =
+        (uint16_t)(pCtx->fwSize ? (pCtx->fwSize + PHHBCI_LEN_LRC) : 0);
+  }
+  if (pChunk->dataSz == 0) {
+    pChunk->pTx = NULL;
+    pChunk->lrc = 0;
+    return;
+  }
+
+  sum = (uint8_t)(pCtx->uwb_fwdl_MosiApdu.cls + pCtx->uwb_fwdl_MosiApdu.ins +
+                  (pChunk->len & 0x00FF) + ((pChunk->len & 0xFF00) >> 8));
+  if (phTmlUwb_hbci_dma_readable(pCtx->fwImgPtr)) {
+    pChunk->pTx = pCtx->fwImgPtr;
+    sum = (uint8_t)(sum + uwb_fwdl_copySum(NULL, pCtx->fwImgPtr,
+                                           pChunk->dataSz));
+  } else {
+    pChunk->pTx = pStage;
+    sum = (uint8_t)(sum + uwb_fwdl_copySum(pStage, pCtx->fwImgPtr,
+                                           pChunk->dataSz));
+  }
+  /* 與 phHbci_CalcLrc() 相同：sum 的二補數 */
+  pChunk->lrc = (uint8_t)(0U - sum);
+
+  pCtx->fwImgPtr += pChunk->dataSz;
+  pCtx->fwSize -= pChunk->dataSz;
+}
+
+static bool uwb_fwdl_isAck(uwb_fwdl_provider_t* pCtx) {
+  if ((pCtx->uwb_fwdl_MisoApdu.cls !=
+       (uint8_t)(phHbci_Class_General | phHbci_SubClass_Ack)) ||
+      (pCtx->uwb_fwdl_MisoApdu.ins != (uint8_t)phHbci_Valid_APDU)) {
+    NXPLOG_UWB_FWDNLD_E("ERROR: NACK (CLS = 0x%02x, INS = 0x%02x)",
+                        pCtx->uwb_fwdl_MisoApdu.cls,
+                        pCtx->uwb_fwdl_MisoApdu.ins);
+    return FALSE;
+  }
+  return TRUE;
+}
+
 UWBStatus_t uwb_fwdl_downloadFw(uwb_fwdl_provider_t* pCtx) {
   NXPLOG_UWB_FWDNLD_D("uwb_fwdl_downloadFw Enter");
-  uint8_t ackCls, ackIns;
-  uint16_t lrc;
-  uint32_t dataSz, payloadSz;
+  UWBStatus_t status = kUWBSTATUS_FAILED;
+  uwb_fwdl_chunk_t chunk[2];
+  uint8_t* pStage[2];
+  uint8_t cur = 0;
+  uint8_t next;
   size_t rcvLen = 0;
 
-  ackCls = (uint8_t)(phHbci_Class_General | phHbci_SubClass_Ack);
-  ackIns = (uint8_t)phHbci_Valid_APDU;
-
-  do {
-    if (pCtx->fwSize > PHHBCI_MAX_LEN_DATA_MOSI) {
-      dataSz = PHHBCI_MAX_LEN_DATA_MOSI;
-      payloadSz = PHHBCI_APDU_SEG_FLAG;
-    } else {
-      lrc = pCtx->fwSize ? PHHBCI_LEN_LRC : 0;
-      dataSz = pCtx->fwSize;
-      payloadSz = (uint32_t)(dataSz + lrc);
-    }
-    pCtx->uwb_fwdl_MosiApdu.len = (uint16_t)payloadSz;
+  /* 第二個 staging buffer 讓下一個 segment 可以在目前的還在 DMA 傳輸時
+   * 準備；配置失敗時退回單一 buffer，等傳輸完成才準備下一個 */
+  pStage[0] = pCtx->uwb_fwdl_MosiApdu.payload;
+  pStage[1] = (uint8_t*)phOsalUwb_GetMemory(PHHBCI_MAX_LEN_DATA_MOSI);
+
+  uwb_fwdl_prepareChunk(pCtx, &chunk[cur], pStage[cur]);
+  for (;;) {
+    bool more = FALSE;
+
+    next = (pStage[1] != NULL) ? (uint8_t)(cur ^ 1U) : cur;
+
+    pCtx->uwb_fwdl_MosiApdu.len = chunk[cur].len;
     rcvLen = PHHBCI_MAX_LEN_DATA_MISO;
     (void)phTmlUwb_hbci_transcive((uint8_t*)&pCtx->uwb_fwdl_MosiApdu,
                                   PHHBCI_LEN_HDR,
                                   (uint8_t*)&pCtx->uwb_fwdl_MisoApdu, &rcvLen);
     pCtx->uwb_fwdl_MisoApdu.len = (uint16_t)rcvLen;
-    if ((pCtx->uwb_fwdl_MisoApdu.cls != ackCls) ||
-        (pCtx->uwb_fwdl_MisoApdu.ins != ackIns)) {
-      NXPLOG_UWB_FWDNLD_E("ERROR: NACK (CLS = 0x%02x, INS = 0x%02x)",
-                          pCtx->uwb_fwdl_MisoApdu.cls,
-                          pCtx->uwb_fwdl_MisoApdu.ins);
-      return kUWBSTATUS_FAILED;
+    if (!uwb_fwdl_isAck(pCtx)) {
+      goto exit;
     }
 
-    if (dataSz) {
-      pCtx->uwb_fwdl_MosiApdu.payload[0] = pCtx->uwb_fwdl_MosiApdu.cls;
-      pCtx->uwb_fwdl_MosiApdu.payload[1] = pCtx->uwb_fwdl_MosiApdu.ins;
-      pCtx->uwb_fwdl_MosiApdu.payload[2] = pCtx->uwb_fwdl_MosiApdu.len & 0x00FF;
-      pCtx->uwb_fwdl_MosiApdu.payload[3] =
-          (pCtx->uwb_fwdl_MosiApdu.len & 0xFF00) >> 8;
-
-      phOsalUwb_MemCopy(&pCtx->uwb_fwdl_MosiApdu.payload[PHHBCI_LEN_HDR],
-                        pCtx->fwImgPtr, dataSz);
-
-      pCtx->uwb_fwdl_MosiApdu.payload[PHHBCI_LEN_HDR + dataSz] = phHbci_CalcLrc(
-          pCtx->uwb_fwdl_MosiApdu.payload, (uint16_t)(PHHBCI_LEN_HDR + dataSz));
-
-      pCtx->fwImgPtr += dataSz;
-      pCtx->fwSize -= dataSz;
+    if (chunk[cur].dataSz) {
+      if (phTmlUwb_hbci_write_start(chunk[cur].pTx, chunk[cur].dataSz,
+                                    &chunk[cur].lrc, PHHBCI_LEN_LRC) !=
+          UWBSTATUS_SUCCESS) {
+        goto exit;
+      }
+      /* 兩個 buffer：傳輸進行中就準備下一個 segment */
+      if ((next != cur) && pCtx->fwSize) {
+        uwb_fwdl_prepareChunk(pCtx, &chunk[next], pStage[next]);
+        more = TRUE;
+      }
+      if (phTmlUwb_hbci_write_wait() != UWBSTATUS_SUCCESS) {
+        goto exit;
+      }
+      /* 單一 buffer：傳輸完成後，趁 Helios 處理這個 segment 時準備 */
+      if ((next == cur) && pCtx->fwSize) {
+        uwb_fwdl_prepareChunk(pCtx, &chunk[next], pStage[next]);
+        more = TRUE;
+      }
 
-      payloadSz = (uint16_t)(dataSz + PHHBCI_LEN_LRC);
       rcvLen = PHHBCI_MAX_LEN_DATA_MISO;
-      (void)phTmlUwb_hbci_transcive(
-          (uint8_t*)&pCtx->uwb_fwdl_MosiApdu.payload[PHHBCI_LEN_HDR],
-          (uint16_t)payloadSz, (uint8_t*)&pCtx->uwb_fwdl_MisoApdu, &rcvLen);
+      (void)phTmlUwb_hbci_read((uint8_t*)&pCtx->uwb_fwdl_MisoApdu, &rcvLen);
       pCtx->uwb_fwdl_MisoApdu.len = (uint16_t)rcvLen;
-      if ((pCtx->uwb_fwdl_MisoApdu.cls != ackCls) ||
-          (pCtx->uwb_fwdl_MisoApdu.ins != ackIns)) {
-        NXPLOG_UWB_FWDNLD_E("ERROR: NACK (CLS = 0x%02x, INS = 0x%02x)",
-                            pCtx->uwb_fwdl_MisoApdu.cls,
-                            pCtx->uwb_fwdl_MisoApdu.ins);
-
-        return kUWBSTATUS_FAILED;
+      if (!uwb_fwdl_isAck(pCtx)) {
+        goto exit;
       }
     }
-  } while (pCtx->fwSize);
+    if (!more) {
+      break;
+    }
+    cur = next;
+  }
 
-  return kUWBSTATUS_SUCCESS;
+  status = kUWBSTATUS_SUCCESS;
+exit:
+  if (pStage[1] != NULL) {
+    phOsalUwb_FreeMemory(pStage[1]);
+  }
+  return status;
 }
 #endif  // UWBIOT_UWBD_SR1XXT
 #endif  // UWB_BLD_CFG_FW_DNLD_DIRECTLY_FROM_HOST
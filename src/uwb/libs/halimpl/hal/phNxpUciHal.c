@@ -31,6 +31,9 @@
 #if UWBIOT_UWBD_SR1XXT_SR2XXT
 #include <UwbApi_Types_Proprietary.h>
 #endif
+#if UWBIOT_UWBD_SR1XXT
+#include "uci_ext_defs.h"
+#endif
 
 #include "phUwbStatus.h"
 
@@ -87,7 +90,6 @@ phNxpUciHal_Control_t nxpucihal_ctrl;
 bool uwb_debug_enabled = TRUE;
 uint32_t uwbTimeoutTimerId = 0;
 
-static uint8_t Rx_data[UCI_MAX_DATA_LEN];
 static const unsigned char nxp_config_block_names[] = {
     UWB_NXP_CORE_CONFIG_BLOCK_1, UWB_NXP_CORE_CONFIG_BLOCK_2,
     UWB_NXP_CORE_CONFIG_BLOCK_3, UWB_NXP_CORE_CONFIG_BLOCK_4,
@@ -105,13 +107,101 @@ static OSAL_TASK_RETURN_TYPE phNxpUciHal_client_thread(void* arg);
 extern int phNxpUciHal_fw_download(void);
 /* For cases when HDLL Boot is done, but FW Downlaod is skipped for SR2XX */
 extern int phNxpUciHal_fw_download_SKIP_SR2XX(void);
+#if UWBIOT_UWBD_SR1XXT
+extern void phNxpUciHal_fw_download_stats(uint32_t* pBytes, uint32_t* pMs);
+#endif  // UWBIOT_UWBD_SR1XXT
 static tHAL_UWB_STATUS phNxpUciHal_uwb_reset(void);
 
+/* FW download 略過/執行的統計，由 uwb_stats fwdl 顯示 */
+static phNxpUciHal_FwCacheStats_t gFwCacheStats;
+
+/* client thread 的排隊延遲與批次統計，由 uwb_stats dispatch 顯示 */
+static phOsalUwb_DispatchStats_t gHalDispatchStats;
+
+#if UWBIOT_UWBD_SR1XXT && IS_ENABLED(CONFIG_UWB_FWDL_CACHE)
+extern bool phNxpUciHal_fw_cache_match(void);
+extern void phNxpUciHal_fw_cache_invalidate(void);
+
+/* 最近一次 CORE_GET_DEVICE_INFO 回應中的 FW 版本 (major, minor, rc) */
+static uint8_t gFwRunningVersion[UWBD_VERSION_LENGTH_MAX];
+static bool gFwRunningVersionValid;
+/* 最近一次完整下載後 UWBS 回報的 FW 版本 */
+static uint8_t gFwCachedVersion[UWBD_VERSION_LENGTH_MAX];
+
+static void phNxpUciHal_parse_fw_version(const uint8_t* p_rsp,
+                                         uint16_t rsp_len);
+static bool phNxpUciHal_fw_warm_start(void);
+static UWBSTATUS phNxpUciHal_read_fw_version(void);
+#endif  // UWBIOT_UWBD_SR1XXT && CONFIG_UWB_FWDL_CACHE
+
+/******************************************************************************
+ * Function         phNxpUciHal_dispatch_msg
+ *
+ * Description      Handles one message posted to the HAL client thread.
+ *
+ * Returns          void
+ *
+ ******************************************************************************/
+static void phNxpUciHal_dispatch_msg(phNxpUciHal_Control_t* p_nxpucihal_ctrl,
+                                     phLibUwb_Message_t* pMsg) {
+  switch (pMsg->eMsgType) {
+    case PH_LIBUWB_DEFERREDCALL_MSG: {
+      phLibUwb_DeferredCall_t* deferCall =
+          (phLibUwb_DeferredCall_t*)(pMsg->pMsgData);
+
+      REENTRANCE_LOCK();
+      if (deferCall->pCallback != NULL) {
+        deferCall->pCallback(deferCall->pParameter);
+      }
+      REENTRANCE_UNLOCK();
+
+      break;
+    }
+
+    case UCI_HAL_OPEN_CPLT_MSG: {
+      REENTRANCE_LOCK();
+      if (nxpucihal_ctrl.p_uwb_stack_cback != NULL) {
+        /* Send the event */
+        (*nxpucihal_ctrl.p_uwb_stack_cback)(HAL_UWB_OPEN_CPLT_EVT,
+                                            HAL_UWB_STATUS_OK);
+      }
+      REENTRANCE_UNLOCK();
+      break;
+    }
+
+    case UCI_HAL_CLOSE_CPLT_MSG: {
+      REENTRANCE_LOCK();
+      p_nxpucihal_ctrl->thread_running = 0;
+      if (nxpucihal_ctrl.p_uwb_stack_cback != NULL) {
+        /* Send the event */
+        (*nxpucihal_ctrl.p_uwb_stack_cback)(HAL_UWB_CLOSE_CPLT_EVT,
+                                            HAL_UWB_STATUS_OK);
+        phOsalUwb_ProduceSemaphore(p_nxpucihal_ctrl->halClientSemaphore);
+      }
+      REENTRANCE_UNLOCK();
+      break;
+    }
+
+    case UCI_HAL_ERROR_MSG: {
+      REENTRANCE_LOCK();
+      if (nxpucihal_ctrl.p_uwb_stack_cback != NULL) {
+        /* Send the event */
+        (*nxpucihal_ctrl.p_uwb_stack_cback)(HAL_UWB_ERROR_EVT,
+                                            HAL_UWB_ERROR_EVT);
+      }
+      REENTRANCE_UNLOCK();
+      break;
+    }
+  }
+}
+
 /******************************************************************************
  * Function         phNxpUciHal_client_thread
  *
  * Description      This function is a thread handler which handles all TML and
- *                  UCI messages.
+ *                  UCI messages. Each wakeup drains up to
+ *                  CONFIG_UWB_DISPATCH_BUDGET messages before blocking
+ *                  on the queue again.
  *
  * Returns          void
  *
@@ -119,6 +209,7 @@ static tHAL_UWB_STATUS phNxpUciHal_uwb_reset(void);
 static OSAL_TASK_RETURN_TYPE phNxpUciHal_client_thread(void* arg) {
   phNxpUciHal_Control_t* p_nxpucihal_ctrl = (phNxpUciHal_Control_t*)arg;
   phLibUwb_Message_t msg;
+  uint32_t count;
 
   NXPLOG_UCIHAL_D("thread started");
 
@@ -139,56 +230,22 @@ static OSAL_TASK_RETURN_TYPE phNxpUciHal_client_thread(void* arg) {
       break;
     }
 
-    switch (msg.eMsgType) {
-      case PH_LIBUWB_DEFERREDCALL_MSG: {
-        phLibUwb_DeferredCall_t* deferCall =
-            (phLibUwb_DeferredCall_t*)(msg.pMsgData);
-
-        REENTRANCE_LOCK();
-        if (deferCall->pCallback != NULL) {
-          deferCall->pCallback(deferCall->pParameter);
-        }
-        REENTRANCE_UNLOCK();
-
-        break;
-      }
-
-      case UCI_HAL_OPEN_CPLT_MSG: {
-        REENTRANCE_LOCK();
-        if (nxpucihal_ctrl.p_uwb_stack_cback != NULL) {
-          /* Send the event */
-          (*nxpucihal_ctrl.p_uwb_stack_cback)(HAL_UWB_OPEN_CPLT_EVT,
-                                              HAL_UWB_STATUS_OK);
-        }
-        REENTRANCE_UNLOCK();
-        break;
-      }
-
-      case UCI_HAL_CLOSE_CPLT_MSG: {
-        REENTRANCE_LOCK();
-        p_nxpucihal_ctrl->thread_running = 0;
-        if (nxpucihal_ctrl.p_uwb_stack_cback != NULL) {
-          /* Send the event */
-          (*nxpucihal_ctrl.p_uwb_stack_cback)(HAL_UWB_CLOSE_CPLT_EVT,
-                                              HAL_UWB_STATUS_OK);
-          phOsalUwb_ProduceSemaphore(p_nxpucihal_ctrl->halClientSemaphore);
-        }
-        REENTRANCE_UNLOCK();
-        break;
-      }
-
-      case UCI_HAL_ERROR_MSG: {
-        REENTRANCE_LOCK();
-        if (nxpucihal_ctrl.p_uwb_stack_cback != NULL) {
-          /* Send the event */
-          (*nxpucihal_ctrl.p_uwb_stack_cback)(HAL_UWB_ERROR_EVT,
-                                              HAL_UWB_ERROR_EVT);
-        }
-        REENTRANCE_UNLOCK();
-        break;
-      }
+    /* 已在佇列中的訊息一次處理完，佇列空了才回去睡 */
+    count = 0;
+    do {
+      phOsalUwb_DispatchStatsMessage(&gHalDispatchStats, &msg);
+      phNxpUciHal_dispatch_msg(p_nxpucihal_ctrl, &msg);
+      count++;
+    } while ((p_nxpucihal_ctrl->thread_running == 1) &&
+             (count < CONFIG_UWB_DISPATCH_BUDGET) &&
+             (phOsalUwb_msgrcv(p_nxpucihal_ctrl->gDrvCfg.nClientId, &msg,
+                               NO_DELAY) == UWBSTATUS_SUCCESS));
+    phOsalUwb_DispatchStatsBatch(&gHalDispatchStats, count);
+
+    /* 用完額度仍有訊息時讓同優先權的執行緒先跑 */
+    if (count == CONFIG_UWB_DISPATCH_BUDGET) {
+      k_yield();
     }
-    k_usleep(100);
   }
 
   NXPLOG_UCIHAL_D("NxpUciHal thread stopped");
@@ -554,9 +611,23 @@ static void phNxpUciHal_read_complete(void* pContext,
     if (nxpucihal_ctrl.hal_ext_enabled == 1) {
       nxpucihal_ctrl.isSkipPacket = 1;
       if (mt == UCI_MT_RSP << UCI_MT_SHIFT) {
+        /* pBuff 在 callback 結束後就還給 TML，等待中的呼叫端只能讀副本 */
+        nxpucihal_ctrl.rsp_len =
+            (nxpucihal_ctrl.rx_data_len < sizeof(nxpucihal_ctrl.rsp_data))
+                ? nxpucihal_ctrl.rx_data_len
+                : (uint16_t)sizeof(nxpucihal_ctrl.rsp_data);
+        phOsalUwb_MemCopy(nxpucihal_ctrl.rsp_data, nxpucihal_ctrl.p_rx_data,
+                          nxpucihal_ctrl.rsp_len);
         if (nxpucihal_ctrl.p_rx_data[UCI_RESPONSE_STATUS_OFFSET] ==
             UWBSTATUS_SUCCESS) {
           nxpucihal_ctrl.ext_cb_data.status = UWBSTATUS_SUCCESS;
+#if UWBIOT_UWBD_SR1XXT && IS_ENABLED(CONFIG_UWB_FWDL_CACHE)
+          /* pBuff 在 callback 結束後就還給 TML，版本要在這裡取出 */
+          if ((gid == UCI_GID_CORE) && (oid == UCI_MSG_CORE_DEVICE_INFO)) {
+            phNxpUciHal_parse_fw_version(nxpucihal_ctrl.p_rx_data,
+                                         nxpucihal_ctrl.rx_data_len);
+          }
+#endif
         } else if ((gid == UCI_GID_PROPRIETARY) &&
                    (oid == UCI_DBG_GET_ERROR_LOG_CMD)) {
           nxpucihal_ctrl.ext_cb_data.status = UWBSTATUS_SUCCESS;
@@ -580,6 +651,7 @@ static void phNxpUciHal_read_complete(void* pContext,
                                                  nxpucihal_ctrl.p_rx_data);
       }
     }
+    nxpucihal_ctrl.p_rx_data = NULL;
   } else {
     NXPLOG_UCIHAL_E("read error status = 0x%x", pInfo->wStatus);
   }
@@ -593,9 +665,11 @@ static void phNxpUciHal_read_complete(void* pContext,
       nxpucihal_ctrl.fw_dwnld_mode = FALSE;
     }
   }
-  /* Read again because read must be pending always.*/
+  /* Read again because read must be pending always. The TML reader keeps
+   * listening, so this only confirms it; pInfo->pBuff is released to the TML
+   * receive ring once this function returns. */
   status = phTmlUwb_Read(
-      Rx_data, UCI_MAX_DATA_LEN,
+      NULL, UCI_MAX_DATA_LEN,
       (pphTmlUwb_TransactCompletionCb_t)&phNxpUciHal_read_complete, NULL);
   if (status != UWBSTATUS_PENDING) {
     NXPLOG_UCIHAL_E("read status error status = %x", status);
@@ -714,16 +788,16 @@ int phNxpUciHal_ioctl(long arg, tHAL_UWB_IOCTL* p_data) {
         }
         phFwCrashLogInfo_t* fwLogInfo = (phFwCrashLogInfo_t*)p_data->pCrashInfo;
         if (fwLogInfo->logLen >=
-            (size_t)(nxpucihal_ctrl.p_rx_data[UCI_RESPONSE_LEN_OFFSET])) {
-          fwLogInfo->logLen = nxpucihal_ctrl.p_rx_data[UCI_RESPONSE_LEN_OFFSET];
+            (size_t)(nxpucihal_ctrl.rsp_data[UCI_RESPONSE_LEN_OFFSET])) {
+          fwLogInfo->logLen = nxpucihal_ctrl.rsp_data[UCI_RESPONSE_LEN_OFFSET];
           phOsalUwb_MemCopy(
               fwLogInfo->pLog,
-              &nxpucihal_ctrl.p_rx_data[UCI_RESPONSE_STATUS_OFFSET],
+              &nxpucihal_ctrl.rsp_data[UCI_RESPONSE_STATUS_OFFSET],
               (uint32_t)fwLogInfo->logLen);
           return UWBSTATUS_SUCCESS;
         } else {
           fwLogInfo->logLen =
-              (size_t)nxpucihal_ctrl.p_rx_data[UCI_RESPONSE_LEN_OFFSET] - 1;
+              (size_t)nxpucihal_ctrl.rsp_data[UCI_RESPONSE_LEN_OFFSET] - 1;
           NXPLOG_UCIHAL_E(
               "%s : Not Enough buffer to copy FW crash log required buffer "
               "size is %d",
@@ -812,6 +886,7 @@ int phNxpUciHal_applyVendorConfig() {
  ******************************************************************************/
 int phNxpUciHal_uwbDeviceInit(BOOLEAN recovery) {
   int status;
+  uint32_t startMs = k_uptime_get_32();
   NXPLOG_UCIHAL_D(" Start FW download");
   nxpucihal_ctrl.fw_dwnld_mode = TRUE; /* system in FW download mode*/
   nxpucihal_ctrl.uwb_dev_status = UWB_UCI_DEVICE_ERROR;
@@ -822,6 +897,29 @@ int phNxpUciHal_uwbDeviceInit(BOOLEAN recovery) {
     NXPLOG_UCIHAL_E("Semaphore creation failed");
     return UWBSTATUS_FAILED;
   }
+#if UWBIOT_UWBD_SR1XXT && IS_ENABLED(CONFIG_UWB_FWDL_CACHE)
+  if ((recovery == FALSE) && phNxpUciHal_fw_warm_start()) {
+    uint32_t elapsedMs;
+
+    /* Warm reset 後已是 READY，只需重新套用 vendor config */
+    if (phNxpUciHal_applyVendorConfig() != UWBSTATUS_OK) {
+      NXPLOG_UCIHAL_E("%s: Apply Vendor config Failed", __FUNCTION__);
+    }
+    uwb_device_initialized = TRUE;
+    status = UWBSTATUS_SUCCESS;
+
+    elapsedMs = k_uptime_get_32() - startMs;
+    gFwCacheStats.dwSkips++;
+    gFwCacheStats.dwLastWarmInitMs = elapsedMs;
+    if (gFwCacheStats.dwLastFullInitMs > elapsedMs) {
+      gFwCacheStats.qwSavedMs += gFwCacheStats.dwLastFullInitMs - elapsedMs;
+    }
+    LOG_I("FW %02X.%02X.%02X already running, download skipped (%u ms)",
+          gFwCachedVersion[0], gFwCachedVersion[1], gFwCachedVersion[2],
+          elapsedMs);
+    goto clean_and_return;
+  }
+#endif  // UWBIOT_UWBD_SR1XXT && CONFIG_UWB_FWDL_CACHE
   if (recovery == TRUE) {
     (void)phTmlUwb_reset(0);
     /* Add delay to allow all async tasks (Threads) to exit before restarting */
@@ -876,7 +974,7 @@ int phNxpUciHal_uwbDeviceInit(BOOLEAN recovery) {
     }
 
     status = phTmlUwb_Read(
-        Rx_data, UCI_MAX_DATA_LEN,
+        NULL, UCI_MAX_DATA_LEN,
         (pphTmlUwb_TransactCompletionCb_t)&phNxpUciHal_read_complete, NULL);
     if (status != UWBSTATUS_PENDING) {
       NXPLOG_UCIHAL_E("read status error status = %x", status);
@@ -967,6 +1065,23 @@ int phNxpUciHal_uwbDeviceInit(BOOLEAN recovery) {
     if (phNxpUciHal_applyVendorConfig() != UWBSTATUS_OK) {
       NXPLOG_UCIHAL_E("%s: Apply Vendor config Failed", __FUNCTION__);
     }
+#endif  // UWBIOT_UWBD_SR1XXT
+#if UWBIOT_UWBD_SR1XXT
+#if IS_ENABLED(CONFIG_UWB_FWDL_CACHE)
+    /* 記下剛下載的 FW 版本，下次 init 的 warm check 用來比對 */
+    if (phNxpUciHal_read_fw_version() == UWBSTATUS_SUCCESS) {
+      phOsalUwb_MemCopy(gFwCachedVersion, gFwRunningVersion,
+                        sizeof(gFwCachedVersion));
+    } else {
+      phNxpUciHal_fw_cache_invalidate();
+    }
+#endif  // CONFIG_UWB_FWDL_CACHE
+    gFwCacheStats.dwDownloads++;
+    phNxpUciHal_fw_download_stats(&gFwCacheStats.dwLastDlBytes,
+                                  &gFwCacheStats.dwLastDlMs);
+    gFwCacheStats.dwLastFullInitMs = k_uptime_get_32() - startMs;
+    LOG_I("FW downloaded, device ready in %u ms",
+          gFwCacheStats.dwLastFullInitMs);
 #endif  // UWBIOT_UWBD_SR1XXT
     uwb_device_initialized = TRUE;
   }
@@ -994,6 +1109,171 @@ static tHAL_UWB_STATUS phNxpUciHal_uwb_reset() {
   return UWBSTATUS_SUCCESS;
 }
 
+#if UWBIOT_UWBD_SR1XXT && IS_ENABLED(CONFIG_UWB_FWDL_CACHE)
+/******************************************************************************
+ * Function         phNxpUciHal_parse_fw_version
+ *
+ * Description      Extracts the FW version TLV from a CORE_GET_DEVICE_INFO
+ *                  response.
+ *
+ * Returns          None
+ *
+ ******************************************************************************/
+static void phNxpUciHal_parse_fw_version(const uint8_t* p_rsp,
+                                         uint16_t rsp_len) {
+  /* status 之後是 UCI/MAC/PHY/test 版本 (各 2 bytes) 與 extended 長度 */
+  uint16_t index = UCI_RESPONSE_PAYLOAD_OFFSET + 8 + 1;
+
+  while ((index + 2) <= rsp_len) {
+    uint8_t paramId = p_rsp[index++];
+    uint8_t length = p_rsp[index++];
+
+    if ((index + length) > rsp_len) {
+      break;
+    }
+    if ((paramId == UCI_EXT_PARAM_ID_FW_VERSION) &&
+        (length == UWBD_VERSION_LENGTH_MAX)) {
+      phOsalUwb_MemCopy(gFwRunningVersion, &p_rsp[index], length);
+      gFwRunningVersionValid = TRUE;
+      return;
+    }
+    index = (uint16_t)(index + length);
+  }
+}
+
+/******************************************************************************
+ * Function         phNxpUciHal_read_fw_version
+ *
+ * Description      Sends CORE_GET_DEVICE_INFO and waits for the FW version of
+ *                  the running UWBS firmware.
+ *
+ * Returns          UWBSTATUS_SUCCESS when the version was received
+ *
+ ******************************************************************************/
+static UWBSTATUS phNxpUciHal_read_fw_version(void) {
+  uint8_t buffer[] = {0x20, UCI_MSG_CORE_DEVICE_INFO, 0x00, 0x00};
+
+  gFwRunningVersionValid = FALSE;
+  if (phNxpUciHal_send_ext_cmd(sizeof(buffer), buffer) != UWBSTATUS_SUCCESS) {
+    return UWBSTATUS_FAILED;
+  }
+  return gFwRunningVersionValid ? UWBSTATUS_SUCCESS : UWBSTATUS_FAILED;
+}
+
+/******************************************************************************
+ * Function         phNxpUciHal_fw_warm_start
+ *
+ * Description      Brings up a UWBS that still runs the firmware downloaded
+ *                  by a previous init: checks the cached image, resets the
+ *                  device with CORE_DEVICE_RESET instead of toggling CE and
+ *                  compares the reported FW version. On any mismatch the
+ *                  reader is stopped again so a full download can follow.
+ *
+ * Returns          TRUE when the download can be skipped
+ *
+ ******************************************************************************/
+static bool phNxpUciHal_fw_warm_start(void) {
+  UWBSTATUS status;
+
+  if (!phNxpUciHal_fw_cache_match()) {
+    NXPLOG_UCIHAL_D("FW cache miss, full download");
+    return FALSE;
+  }
+
+  status = phTmlUwb_Read(
+      NULL, UCI_MAX_DATA_LEN,
+      (pphTmlUwb_TransactCompletionCb_t)&phNxpUciHal_read_complete, NULL);
+  if (status != UWBSTATUS_PENDING) {
+    NXPLOG_UCIHAL_E("read status error status = %x", status);
+    goto fallback;
+  }
+  if (phNxpUciHal_uwb_reset() != UWBSTATUS_OK) {
+    NXPLOG_UCIHAL_E("%s: warm reset failed", __FUNCTION__);
+    goto fallback;
+  }
+  if ((phOsalUwb_ConsumeSemaphore_WithTimeout(
+           nxpucihal_ctrl.dev_status_ntf_wait.sem,
+           HAL_MAX_DEVICE_ST_NTF_TIMEOUT) != UWBSTATUS_SUCCESS) ||
+      (nxpucihal_ctrl.uwb_dev_status != UWB_UCI_DEVICE_READY)) {
+    NXPLOG_UCIHAL_E("%s: device not ready after warm reset", __FUNCTION__);
+    goto fallback;
+  }
+  if (phNxpUciHal_read_fw_version() != UWBSTATUS_SUCCESS) {
+    goto fallback;
+  }
+  if (phOsalUwb_MemCompare(gFwRunningVersion, gFwCachedVersion,
+                           sizeof(gFwCachedVersion)) != 0) {
+    NXPLOG_UCIHAL_E("%s: running FW %02X.%02X.%02X is not the cached one",
+                    __FUNCTION__, gFwRunningVersion[0], gFwRunningVersion[1],
+                    gFwRunningVersion[2]);
+    goto fallback;
+  }
+  return TRUE;
+
+fallback:
+  gFwCacheStats.dwWarmFailures++;
+  phTmlUwb_ReadAbort();
+  phNxpUciHal_fw_cache_invalidate();
+  return FALSE;
+}
+#endif  // UWBIOT_UWBD_SR1XXT && CONFIG_UWB_FWDL_CACHE
+
+/******************************************************************************
+ * Function         phNxpUciHal_GetFwCacheStats
+ *
+ * Description      Returns a snapshot of the FW download cache counters
+ *
+ * Returns          None
+ *
+ ******************************************************************************/
+void phNxpUciHal_GetFwCacheStats(phNxpUciHal_FwCacheStats_t* pStats) {
+  if (pStats != NULL) {
+    *pStats = gFwCacheStats;
+  }
+}
+
+/******************************************************************************
+ * Function         phNxpUciHal_ResetFwCacheStats
+ *
+ * Description      Clears the FW download cache counters
+ *
+ * Returns          None
+ *
+ ******************************************************************************/
+void phNxpUciHal_ResetFwCacheStats(void) {
+  /* 保留最近一次完整下載的時間，作為之後計算節省時間的基準 */
+  uint32_t lastFullInitMs = gFwCacheStats.dwLastFullInitMs;
+
+  phOsalUwb_SetMemory(&gFwCacheStats, 0, sizeof(gFwCacheStats));
+  gFwCacheStats.dwLastFullInitMs = lastFullInitMs;
+}
+
+/******************************************************************************
+ * Function         phNxpUciHal_GetDispatchStats
+ *
+ * Description      Copies the client thread dispatch counters.
+ *
+ * Returns          None
+ *
+ ******************************************************************************/
+void phNxpUciHal_GetDispatchStats(phOsalUwb_DispatchStats_t* pStats) {
+  if (pStats != NULL) {
+    *pStats = gHalDispatchStats;
+  }
+}
+
+/******************************************************************************
+ * Function         phNxpUciHal_ResetDispatchStats
+ *
+ * Description      Clears the client thread dispatch counters.
+ *
+ * Returns          None
+ *
+ ******************************************************************************/
+void phNxpUciHal_ResetDispatchStats(void) {
+  phOsalUwb_DispatchStatsReset(&gHalDispatchStats);
+}
+
 /******************************************************************************
  * Function         phNxpUciHal_SetOperatingMode
  *
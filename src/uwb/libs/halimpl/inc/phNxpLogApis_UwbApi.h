@@ -75,7 +75,19 @@ LOG_MODULE_DECLARE(UWBAPI);
 #undef LOG_I
 #undef LOG_D
 
-#if defined(ENABLE_UCI_CMD_LOGGING) && (ENABLE_UCI_CMD_LOGGING == ENABLED)
+#if defined(CONFIG_UWB_TRACE)
+/* * 寫進 phNxpUciHal_Trace ring，不在呼叫端格式化或輸出；
+ * 用 "uwb_trace dump" 事後查看，或 "uwb_trace stream on" 由 drain thread 輸出。
+ * Message 只存指標，必須是字串常數。
+ */
+#include "phNxpUciHal_Trace.h"
+#define LOG_TX(Message, Array, Size)                     \
+  phNxpUciHal_TraceWrite(PH_NXPUCIHAL_TRACE_TX, Message, \
+                         (const uint8_t*)(Array), (uint16_t)(Size))
+#define LOG_RX(Message, Array, Size)                     \
+  phNxpUciHal_TraceWrite(PH_NXPUCIHAL_TRACE_RX, Message, \
+                         (const uint8_t*)(Array), (uint16_t)(Size))
+#elif defined(ENABLE_UCI_CMD_LOGGING) && (ENABLE_UCI_CMD_LOGGING == ENABLED)
 /* * Zephyr Hexdump API 格式: LOG_HEXDUMP_INF(data_ptr, length, message_str)
  * 這會先印出 Message，然後換行印出美觀的 Hex Dump。
  */
@@ -116,7 +128,7 @@ LOG_MODULE_DECLARE(UWBAPI);
 #endif
 
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_E(...)                                \
+#define UWB_LOG_E(...)                            \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -126,8 +138,8 @@ LOG_MODULE_DECLARE(UWBAPI);
     }                                             \
   } while (0)
 #else
-#define LOG_E(...) \
-  do {             \
+#define UWB_LOG_E(...) \
+  do {                 \
   } while (0)
 #endif
 #define LOG_X8_E(VALUE) SHELL_LOG_PRINT("E: %s=0x%02X", #VALUE, VALUE)
@@ -137,7 +149,7 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_X32_E(VALUE) SHELL_LOG_PRINT("E: %s=0x%08X", #VALUE, VALUE)
 #define LOG_U32_E(VALUE) SHELL_LOG_PRINT("E: %s=%u", #VALUE, VALUE)
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_AU8_E(ARRAY, LEN)                     \
+#define UWB_LOG_AU8_E(ARRAY, LEN)                 \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -146,7 +158,7 @@ LOG_MODULE_DECLARE(UWBAPI);
       LOG_HEXDUMP_ERR(ARRAY, LEN, #ARRAY);        \
     }                                             \
   } while (0)
-#define LOG_MAU8_E(MESSAGE, ARRAY, LEN)           \
+#define UWB_LOG_MAU8_E(MESSAGE, ARRAY, LEN)       \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -156,16 +168,16 @@ LOG_MODULE_DECLARE(UWBAPI);
     }                                             \
   } while (0)
 #else
-#define LOG_AU8_E(ARRAY, LEN) \
-  do {                        \
+#define UWB_LOG_AU8_E(ARRAY, LEN) \
+  do {                            \
   } while (0)
-#define LOG_MAU8_E(MESSAGE, ARRAY, LEN) \
-  do {                                  \
+#define UWB_LOG_MAU8_E(MESSAGE, ARRAY, LEN) \
+  do {                                      \
   } while (0)
 #endif
 
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_W(...)                                \
+#define UWB_LOG_W(...)                            \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -175,8 +187,8 @@ LOG_MODULE_DECLARE(UWBAPI);
     }                                             \
   } while (0)
 #else
-#define LOG_W(...) \
-  do {             \
+#define UWB_LOG_W(...) \
+  do {                 \
   } while (0)
 #endif
 #define LOG_X8_W(VALUE) SHELL_LOG_PRINT("W: %s=0x%02X", #VALUE, VALUE)
@@ -186,7 +198,7 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_X32_W(VALUE) SHELL_LOG_PRINT("W: %s=0x%08X", #VALUE, VALUE)
 #define LOG_U32_W(VALUE) SHELL_LOG_PRINT("W: %s=%u", #VALUE, VALUE)
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_AU8_W(ARRAY, LEN)                     \
+#define UWB_LOG_AU8_W(ARRAY, LEN)                 \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -195,7 +207,7 @@ LOG_MODULE_DECLARE(UWBAPI);
       LOG_HEXDUMP_WRN(ARRAY, LEN, #ARRAY);        \
     }                                             \
   } while (0)
-#define LOG_MAU8_W(MESSAGE, ARRAY, LEN)           \
+#define UWB_LOG_MAU8_W(MESSAGE, ARRAY, LEN)       \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -205,16 +217,16 @@ LOG_MODULE_DECLARE(UWBAPI);
     }                                             \
   } while (0)
 #else
-#define LOG_AU8_W(ARRAY, LEN) \
-  do {                        \
+#define UWB_LOG_AU8_W(ARRAY, LEN) \
+  do {                            \
   } while (0)
-#define LOG_MAU8_W(MESSAGE, ARRAY, LEN) \
-  do {                                  \
+#define UWB_LOG_MAU8_W(MESSAGE, ARRAY, LEN) \
+  do {                                      \
   } while (0)
 #endif
 
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_I(...)                                \
+#define UWB_LOG_I(...)                            \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -224,8 +236,8 @@ LOG_MODULE_DECLARE(UWBAPI);
     }                                             \
   } while (0)
 #else
-#define LOG_I(...) \
-  do {             \
+#define UWB_LOG_I(...) \
+  do {                 \
   } while (0)
 #endif
 #define LOG_X8_I(VALUE) SHELL_LOG_PRINT("I: %s=0x%02X", #VALUE, VALUE)
@@ -235,7 +247,7 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_X32_I(VALUE) SHELL_LOG_PRINT("I: %s=0x%08X", #VALUE, VALUE)
 #define LOG_U32_I(VALUE) SHELL_LOG_PRINT("I: %s=%u", #VALUE, VALUE)
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_AU8_I(ARRAY, LEN)                     \
+#define UWB_LOG_AU8_I(ARRAY, LEN)                 \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -244,7 +256,7 @@ LOG_MODULE_DECLARE(UWBAPI);
       LOG_HEXDUMP_INF(ARRAY, LEN, #ARRAY);        \
     }                                             \
   } while (0)
-#define LOG_MAU8_I(MESSAGE, ARRAY, LEN)           \
+#define UWB_LOG_MAU8_I(MESSAGE, ARRAY, LEN)       \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -254,16 +266,16 @@ LOG_MODULE_DECLARE(UWBAPI);
     }                                             \
   } while (0)
 #else
-#define LOG_AU8_I(ARRAY, LEN) \
-  do {                        \
+#define UWB_LOG_AU8_I(ARRAY, LEN) \
+  do {                            \
   } while (0)
-#define LOG_MAU8_I(MESSAGE, ARRAY, LEN) \
-  do {                                  \
+#define UWB_LOG_MAU8_I(MESSAGE, ARRAY, LEN) \
+  do {                                      \
   } while (0)
 #endif
 
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_D(...)                                \
+#define UWB_LOG_D(...)                            \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -273,8 +285,8 @@ LOG_MODULE_DECLARE(UWBAPI);
     }                                             \
   } while (0)
 #else
-#define LOG_D(...) \
-  do {             \
+#define UWB_LOG_D(...) \
+  do {                 \
   } while (0)
 #endif
 #define LOG_X8_D(VALUE) SHELL_LOG_PRINT("D: %s=0x%02X", #VALUE, VALUE)
@@ -284,7 +296,7 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_X32_D(VALUE) SHELL_LOG_PRINT("D: %s=0x%08X", #VALUE, VALUE)
 #define LOG_U32_D(VALUE) SHELL_LOG_PRINT("D: %s=%u", #VALUE, VALUE)
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_AU8_D(ARRAY, LEN)                     \
+#define UWB_LOG_AU8_D(ARRAY, LEN)                 \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -293,7 +305,7 @@ LOG_MODULE_DECLARE(UWBAPI);
       LOG_HEXDUMP_DBG(ARRAY, LEN, #ARRAY);        \
     }                                             \
   } while (0)
-#define LOG_MAU8_D(MESSAGE, ARRAY, LEN)           \
+#define UWB_LOG_MAU8_D(MESSAGE, ARRAY, LEN)       \
   do {                                            \
     const struct shell* sh_ptr = g_uwb_shell_ptr; \
     if (sh_ptr != NULL) {                         \
@@ -303,11 +315,11 @@ LOG_MODULE_DECLARE(UWBAPI);
     }                                             \
   } while (0)
 #else
-#define LOG_AU8_D(ARRAY, LEN) \
-  do {                        \
+#define UWB_LOG_AU8_D(ARRAY, LEN) \
+  do {                            \
   } while (0)
-#define LOG_MAU8_D(MESSAGE, ARRAY, LEN) \
-  do {                                  \
+#define UWB_LOG_MAU8_D(MESSAGE, ARRAY, LEN) \
+  do {                                      \
   } while (0)
 #endif
 
@@ -328,7 +340,7 @@ LOG_MODULE_DECLARE(UWBAPI);
 /* Error Level (E) */
 /* ------------------------------------------------------------------------- */
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_E(fmt, ...)         \
+#define UWB_LOG_E(fmt, ...)     \
   do {                          \
     printk("E: ");              \
     printk(fmt, ##__VA_ARGS__); \
@@ -342,12 +354,12 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_U32_E(VALUE) printk("E: %s=%u\n", #VALUE, VALUE)
 
 /* Hex Dump Error */
-#define LOG_AU8_E(ARRAY, LEN) PRINTK_HEXDUMP("E: ", #ARRAY, ARRAY, LEN)
-#define LOG_MAU8_E(MESSAGE, ARRAY, LEN) \
+#define UWB_LOG_AU8_E(ARRAY, LEN) PRINTK_HEXDUMP("E: ", #ARRAY, ARRAY, LEN)
+#define UWB_LOG_MAU8_E(MESSAGE, ARRAY, LEN) \
   PRINTK_HEXDUMP("E: ", MESSAGE, ARRAY, LEN)
 #else
-#define LOG_E(fmt, ...) \
-  do {                  \
+#define UWB_LOG_E(fmt, ...) \
+  do {                      \
   } while (0)
 #define LOG_X8_E(VALUE) \
   do {                  \
@@ -367,11 +379,11 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_U32_E(VALUE) \
   do {                   \
   } while (0)
-#define LOG_AU8_E(ARRAY, LEN) \
-  do {                        \
+#define UWB_LOG_AU8_E(ARRAY, LEN) \
+  do {                            \
   } while (0)
-#define LOG_MAU8_E(MESSAGE, ARRAY, LEN) \
-  do {                                  \
+#define UWB_LOG_MAU8_E(MESSAGE, ARRAY, LEN) \
+  do {                                      \
   } while (0)
 #endif
 
@@ -379,7 +391,7 @@ LOG_MODULE_DECLARE(UWBAPI);
 /* Warning Level (W) */
 /* ------------------------------------------------------------------------- */
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_W(fmt, ...)         \
+#define UWB_LOG_W(fmt, ...)     \
   do {                          \
     printk("W: ");              \
     printk(fmt, ##__VA_ARGS__); \
@@ -393,12 +405,12 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_U32_W(VALUE) printk("W: %s=%u\n", #VALUE, VALUE)
 
 /* Hex Dump Warning */
-#define LOG_AU8_W(ARRAY, LEN) PRINTK_HEXDUMP("W: ", #ARRAY, ARRAY, LEN)
-#define LOG_MAU8_W(MESSAGE, ARRAY, LEN) \
+#define UWB_LOG_AU8_W(ARRAY, LEN) PRINTK_HEXDUMP("W: ", #ARRAY, ARRAY, LEN)
+#define UWB_LOG_MAU8_W(MESSAGE, ARRAY, LEN) \
   PRINTK_HEXDUMP("W: ", MESSAGE, ARRAY, LEN)
 #else
-#define LOG_W(fmt, ...) \
-  do {                  \
+#define UWB_LOG_W(fmt, ...) \
+  do {                      \
   } while (0)
 #define LOG_X8_W(VALUE) \
   do {                  \
@@ -418,11 +430,11 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_U32_W(VALUE) \
   do {                   \
   } while (0)
-#define LOG_AU8_W(ARRAY, LEN) \
-  do {                        \
+#define UWB_LOG_AU8_W(ARRAY, LEN) \
+  do {                            \
   } while (0)
-#define LOG_MAU8_W(MESSAGE, ARRAY, LEN) \
-  do {                                  \
+#define UWB_LOG_MAU8_W(MESSAGE, ARRAY, LEN) \
+  do {                                      \
   } while (0)
 #endif
 
@@ -430,7 +442,7 @@ LOG_MODULE_DECLARE(UWBAPI);
 /* Info Level (I) */
 /* ------------------------------------------------------------------------- */
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_I(fmt, ...)         \
+#define UWB_LOG_I(fmt, ...)     \
   do {                          \
     printk("I: ");              \
     printk(fmt, ##__VA_ARGS__); \
@@ -444,12 +456,12 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_U32_I(VALUE) printk("I: %s=%u\n", #VALUE, VALUE)
 
 /* Hex Dump Info */
-#define LOG_AU8_I(ARRAY, LEN) PRINTK_HEXDUMP("I: ", #ARRAY, ARRAY, LEN)
-#define LOG_MAU8_I(MESSAGE, ARRAY, LEN) \
+#define UWB_LOG_AU8_I(ARRAY, LEN) PRINTK_HEXDUMP("I: ", #ARRAY, ARRAY, LEN)
+#define UWB_LOG_MAU8_I(MESSAGE, ARRAY, LEN) \
   PRINTK_HEXDUMP("I: ", MESSAGE, ARRAY, LEN)
 #else
-#define LOG_I(fmt, ...) \
-  do {                  \
+#define UWB_LOG_I(fmt, ...) \
+  do {                      \
   } while (0)
 #define LOG_X8_I(VALUE) \
   do {                  \
@@ -469,11 +481,11 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_U32_I(VALUE) \
   do {                   \
   } while (0)
-#define LOG_AU8_I(ARRAY, LEN) \
-  do {                        \
+#define UWB_LOG_AU8_I(ARRAY, LEN) \
+  do {                            \
   } while (0)
-#define LOG_MAU8_I(MESSAGE, ARRAY, LEN) \
-  do {                                  \
+#define UWB_LOG_MAU8_I(MESSAGE, ARRAY, LEN) \
+  do {                                      \
   } while (0)
 #endif
 
@@ -481,7 +493,7 @@ LOG_MODULE_DECLARE(UWBAPI);
 /* Debug Level (D) */
 /* ------------------------------------------------------------------------- */
 #if CONFIG_UWB_LOG_ENABLED
-#define LOG_D(fmt, ...)         \
+#define UWB_LOG_D(fmt, ...)     \
   do {                          \
     printk("D: ");              \
     printk(fmt, ##__VA_ARGS__); \
@@ -495,12 +507,12 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_U32_D(VALUE) printk("D: %s=%u\n", #VALUE, VALUE)
 
 /* Hex Dump Debug */
-#define LOG_AU8_D(ARRAY, LEN) PRINTK_HEXDUMP("D: ", #ARRAY, ARRAY, LEN)
-#define LOG_MAU8_D(MESSAGE, ARRAY, LEN) \
+#define UWB_LOG_AU8_D(ARRAY, LEN) PRINTK_HEXDUMP("D: ", #ARRAY, ARRAY, LEN)
+#define UWB_LOG_MAU8_D(MESSAGE, ARRAY, LEN) \
   PRINTK_HEXDUMP("D: ", MESSAGE, ARRAY, LEN)
 #else
-#define LOG_D(fmt, ...) \
-  do {                  \
+#define UWB_LOG_D(fmt, ...) \
+  do {                      \
   } while (0)
 #define LOG_X8_D(VALUE) \
   do {                  \
@@ -520,80 +532,254 @@ LOG_MODULE_DECLARE(UWBAPI);
 #define LOG_U32_D(VALUE) \
   do {                   \
   } while (0)
-#define LOG_AU8_D(ARRAY, LEN) \
-  do {                        \
+#define UWB_LOG_AU8_D(ARRAY, LEN) \
+  do {                            \
   } while (0)
-#define LOG_MAU8_D(MESSAGE, ARRAY, LEN) \
-  do {                                  \
+#define UWB_LOG_MAU8_D(MESSAGE, ARRAY, LEN) \
+  do {                                      \
   } while (0)
 #endif
 #endif
 /*
- * These are the Legacy macros used for logging.
- * Do not use further.
+ * 依模組、依等級在編譯期決定要不要產生 log：
+ * CONFIG_<module>_LOG_LEVEL (Kconfig "UWB Configuration" 底下的
+ * Zephyr log level template) 低於某等級時，該等級的巨集直接展開成
+ * UWB_LOG_NOP，參數不會被求值，format 字串也不會進到 image。
+ * CONFIG_UWB_LOG_ENABLED=n 時 UWB_LOG_E/W/I/D 本身就是空的。
  */
-#define NXPLOG_UWBAPI_E LOG_E
-#define NXPLOG_UWBAPI_W LOG_W
-#define NXPLOG_UWBAPI_I LOG_I
-#define NXPLOG_UWBAPI_D LOG_D
-
-#define NXPLOG_APP_D LOG_D
-#define NXPLOG_APP_I LOG_I
-#define NXPLOG_APP_E LOG_E
-#define NXPLOG_APP_W LOG_W
-
-#define UCI_TRACE_E LOG_E
-#define UCI_TRACE_W LOG_W
-#define UCI_TRACE_I LOG_I
-#define UCI_TRACE_D LOG_D
-
-#define NXPLOG_UCIX_E LOG_E
-#define NXPLOG_UCIX_W LOG_W
-#define NXPLOG_UCIX_I LOG_I
-#define NXPLOG_UCIX_D LOG_D
+#define UWB_LOG_NOP(...) \
+  do {                   \
+  } while (0)
 
-/*
- * These are the Legacy macros used for logging.
- * Do not use further.
- */
-#define NXPLOG_UWB_TML_E LOG_E
-#define NXPLOG_UWB_TML_W LOG_W
-#define NXPLOG_UWB_TML_I LOG_I
-#define NXPLOG_UWB_TML_D LOG_D
+#ifndef CONFIG_UWB_API_LOG_LEVEL
+#define CONFIG_UWB_API_LOG_LEVEL 0
+#endif
+#ifndef CONFIG_UWB_APP_LOG_LEVEL
+#define CONFIG_UWB_APP_LOG_LEVEL 0
+#endif
+#ifndef CONFIG_UWB_UCI_LOG_LEVEL
+#define CONFIG_UWB_UCI_LOG_LEVEL 0
+#endif
+#ifndef CONFIG_UWB_HAL_LOG_LEVEL
+#define CONFIG_UWB_HAL_LOG_LEVEL 0
+#endif
+#ifndef CONFIG_UWB_TML_LOG_LEVEL
+#define CONFIG_UWB_TML_LOG_LEVEL 0
+#endif
+#ifndef CONFIG_UWB_FWDL_LOG_LEVEL
+#define CONFIG_UWB_FWDL_LOG_LEVEL 0
+#endif
 
-/*
- * These are the Legacy macros used for logging.
- * Do not use further.
- */
-#define NXPLOG_UCIX_E LOG_E
-#define NXPLOG_UCIX_W LOG_W
-#define NXPLOG_UCIX_I LOG_I
-#define NXPLOG_UCIX_D LOG_D
+/* UWB API：LOG_E/W/I/D、hexdump 與 NXPLOG_UWBAPI_* */
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_ERR
+#define LOG_E UWB_LOG_E
+#else
+#define LOG_E UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_WRN
+#define LOG_W UWB_LOG_W
+#else
+#define LOG_W UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_INF
+#define LOG_I UWB_LOG_I
+#else
+#define LOG_I UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_DBG
+#define LOG_D UWB_LOG_D
+#else
+#define LOG_D UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_ERR
+#define LOG_AU8_E UWB_LOG_AU8_E
+#else
+#define LOG_AU8_E UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_WRN
+#define LOG_AU8_W UWB_LOG_AU8_W
+#else
+#define LOG_AU8_W UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_INF
+#define LOG_AU8_I UWB_LOG_AU8_I
+#else
+#define LOG_AU8_I UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_DBG
+#define LOG_AU8_D UWB_LOG_AU8_D
+#else
+#define LOG_AU8_D UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_ERR
+#define LOG_MAU8_E UWB_LOG_MAU8_E
+#else
+#define LOG_MAU8_E UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_WRN
+#define LOG_MAU8_W UWB_LOG_MAU8_W
+#else
+#define LOG_MAU8_W UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_INF
+#define LOG_MAU8_I UWB_LOG_MAU8_I
+#else
+#define LOG_MAU8_I UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_DBG
+#define LOG_MAU8_D UWB_LOG_MAU8_D
+#else
+#define LOG_MAU8_D UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_ERR
+#define NXPLOG_UWBAPI_E UWB_LOG_E
+#else
+#define NXPLOG_UWBAPI_E UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_WRN
+#define NXPLOG_UWBAPI_W UWB_LOG_W
+#else
+#define NXPLOG_UWBAPI_W UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_INF
+#define NXPLOG_UWBAPI_I UWB_LOG_I
+#else
+#define NXPLOG_UWBAPI_I UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_API_LOG_LEVEL >= LOG_LEVEL_DBG
+#define NXPLOG_UWBAPI_D UWB_LOG_D
+#else
+#define NXPLOG_UWBAPI_D UWB_LOG_NOP
+#endif
 
-/*
- * These are the Legacy macros used for logging.
- * Do not use further.
- */
-#define NXPLOG_UCIHAL_E LOG_E
-#define NXPLOG_UCIHAL_W LOG_W
-#define NXPLOG_UCIHAL_I LOG_I
-#define NXPLOG_UCIHAL_D LOG_D
+/* Application / demos */
+#if CONFIG_UWB_APP_LOG_LEVEL >= LOG_LEVEL_ERR
+#define NXPLOG_APP_E UWB_LOG_E
+#else
+#define NXPLOG_APP_E UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_APP_LOG_LEVEL >= LOG_LEVEL_WRN
+#define NXPLOG_APP_W UWB_LOG_W
+#else
+#define NXPLOG_APP_W UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_APP_LOG_LEVEL >= LOG_LEVEL_INF
+#define NXPLOG_APP_I UWB_LOG_I
+#else
+#define NXPLOG_APP_I UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_APP_LOG_LEVEL >= LOG_LEVEL_DBG
+#define NXPLOG_APP_D UWB_LOG_D
+#else
+#define NXPLOG_APP_D UWB_LOG_NOP
+#endif
 
-/*
- * These are the Legacy macros used for logging.
- * Do not use further.
- */
-#define NXPLOG_UWB_FWDNLD_E LOG_E
-#define NXPLOG_UWB_FWDNLD_W LOG_W
-#define NXPLOG_UWB_FWDNLD_I LOG_I
-#define NXPLOG_UWB_FWDNLD_D LOG_D
+/* uci-core */
+#if CONFIG_UWB_UCI_LOG_LEVEL >= LOG_LEVEL_ERR
+#define UCI_TRACE_E UWB_LOG_E
+#else
+#define UCI_TRACE_E UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_UCI_LOG_LEVEL >= LOG_LEVEL_WRN
+#define UCI_TRACE_W UWB_LOG_W
+#else
+#define UCI_TRACE_W UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_UCI_LOG_LEVEL >= LOG_LEVEL_INF
+#define UCI_TRACE_I UWB_LOG_I
+#else
+#define UCI_TRACE_I UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_UCI_LOG_LEVEL >= LOG_LEVEL_DBG
+#define UCI_TRACE_D UWB_LOG_D
+#else
+#define UCI_TRACE_D UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_UCI_LOG_LEVEL >= LOG_LEVEL_ERR
+#define NXPLOG_UCIX_E UWB_LOG_E
+#else
+#define NXPLOG_UCIX_E UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_UCI_LOG_LEVEL >= LOG_LEVEL_WRN
+#define NXPLOG_UCIX_W UWB_LOG_W
+#else
+#define NXPLOG_UCIX_W UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_UCI_LOG_LEVEL >= LOG_LEVEL_INF
+#define NXPLOG_UCIX_I UWB_LOG_I
+#else
+#define NXPLOG_UCIX_I UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_UCI_LOG_LEVEL >= LOG_LEVEL_DBG
+#define NXPLOG_UCIX_D UWB_LOG_D
+#else
+#define NXPLOG_UCIX_D UWB_LOG_NOP
+#endif
+
+/* HAL */
+#if CONFIG_UWB_HAL_LOG_LEVEL >= LOG_LEVEL_ERR
+#define NXPLOG_UCIHAL_E UWB_LOG_E
+#else
+#define NXPLOG_UCIHAL_E UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_HAL_LOG_LEVEL >= LOG_LEVEL_WRN
+#define NXPLOG_UCIHAL_W UWB_LOG_W
+#else
+#define NXPLOG_UCIHAL_W UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_HAL_LOG_LEVEL >= LOG_LEVEL_INF
+#define NXPLOG_UCIHAL_I UWB_LOG_I
+#else
+#define NXPLOG_UCIHAL_I UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_HAL_LOG_LEVEL >= LOG_LEVEL_DBG
+#define NXPLOG_UCIHAL_D UWB_LOG_D
+#else
+#define NXPLOG_UCIHAL_D UWB_LOG_NOP
+#endif
+
+/* TML */
+#if CONFIG_UWB_TML_LOG_LEVEL >= LOG_LEVEL_ERR
+#define NXPLOG_UWB_TML_E UWB_LOG_E
+#else
+#define NXPLOG_UWB_TML_E UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_TML_LOG_LEVEL >= LOG_LEVEL_WRN
+#define NXPLOG_UWB_TML_W UWB_LOG_W
+#else
+#define NXPLOG_UWB_TML_W UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_TML_LOG_LEVEL >= LOG_LEVEL_INF
+#define NXPLOG_UWB_TML_I UWB_LOG_I
+#else
+#define NXPLOG_UWB_TML_I UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_TML_LOG_LEVEL >= LOG_LEVEL_DBG
+#define NXPLOG_UWB_TML_D UWB_LOG_D
+#else
+#define NXPLOG_UWB_TML_D UWB_LOG_NOP
+#endif
+
+/* FW download */
+#if CONFIG_UWB_FWDL_LOG_LEVEL >= LOG_LEVEL_ERR
+#define NXPLOG_UWB_FWDNLD_E UWB_LOG_E
+#else
+#define NXPLOG_UWB_FWDNLD_E UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_FWDL_LOG_LEVEL >= LOG_LEVEL_WRN
+#define NXPLOG_UWB_FWDNLD_W UWB_LOG_W
+#else
+#define NXPLOG_UWB_FWDNLD_W UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_FWDL_LOG_LEVEL >= LOG_LEVEL_INF
+#define NXPLOG_UWB_FWDNLD_I UWB_LOG_I
+#else
+#define NXPLOG_UWB_FWDNLD_I UWB_LOG_NOP
+#endif
+#if CONFIG_UWB_FWDL_LOG_LEVEL >= LOG_LEVEL_DBG
+#define NXPLOG_UWB_FWDNLD_D UWB_LOG_D
+#else
+#define NXPLOG_UWB_FWDNLD_D UWB_LOG_NOP
+#endif
 
-/*
- * These are the Legacy macros used for logging.
- * Do not use further.
- */
-#define UCI_TRACE_E LOG_E
-#define UCI_TRACE_W LOG_W
-#define UCI_TRACE_I LOG_I
-#define UCI_TRACE_D LOG_D
 #endif /* _PHNXPLOG_UWBAPI_H */
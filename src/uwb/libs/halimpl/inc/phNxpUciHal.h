@@ -51,10 +51,15 @@ typedef struct phNxpUciHal_Control {
   uint8_t thread_running;     /* Thread running if set to 1, else set to 0 */
   phLibUwb_sConfig_t gDrvCfg; /* Driver config data */
 
-  /* Rx data */
+  /* Rx data, only valid inside the read callback: it points into a TML
+   * receive ring slot that is reused once the callback returns */
   uint8_t* p_rx_data;
   uint16_t rx_data_len;
 
+  /* Copy of the last response to a HAL internal (ext) command */
+  uint8_t rsp_data[UCI_MAX_PACKET_LEN];
+  uint16_t rsp_len;
+
   /* libuwb-uci callbacks */
   uwb_stack_callback_t* p_uwb_stack_cback;
   uwb_stack_data_callback_t* p_uwb_stack_data_cback;
@@ -20,6 +20,7 @@
 
 typedef uint8_t uwb_event_t;
 typedef uint8_t uwb_status_t;
+#include "phOsalUwb_Queue.h"
 #include "uwb_hal_api.h"
 #include "uwb_types.h"
 /*`
@@ -41,6 +42,21 @@ typedef void(uwb_stack_data_callback_t)(uint16_t data_len, uint8_t* p_data);
  */
 typedef void(phHalAppDataCb)(uint8_t* recvBuf, uint16_t dataLen);
 
+/*
+ * FW download cache counters. A full init downloads the firmware over HBCI;
+ * a skipped one only warm resets a UWBS that still runs the cached image.
+ */
+typedef struct phNxpUciHal_FwCacheStats {
+  uint32_t dwDownloads;      /* inits that ran a full download */
+  uint32_t dwSkips;          /* inits that skipped the download */
+  uint32_t dwWarmFailures;   /* warm checks that fell back to a download */
+  uint32_t dwLastFullInitMs; /* last init with download, until device ready */
+  uint32_t dwLastWarmInitMs; /* last init without download */
+  uint64_t qwSavedMs;        /* sum of (full - warm) over all skips */
+  uint32_t dwLastDlBytes;    /* size of the last HBCI download */
+  uint32_t dwLastDlMs;       /* wire time of the last HBCI download (RTC) */
+} phNxpUciHal_FwCacheStats_t;
+
 /* NXP HAL functions */
 int phNxpUciHal_open(uwb_stack_callback_t* p_cback,
                      uwb_stack_data_callback_t* p_data_cback);
@@ -51,4 +67,8 @@ int phNxpUciHal_ioctl(long arg, tHAL_UWB_IOCTL* p_data);
 int phNxpUciHal_applyVendorConfig();
 int phNxpUciHal_uwbDeviceInit(BOOLEAN recovery);
 void phNxpUciHal_SetOperatingMode(Uwb_operation_mode_t mode);
+void phNxpUciHal_GetFwCacheStats(phNxpUciHal_FwCacheStats_t* pStats);
+void phNxpUciHal_ResetFwCacheStats(void);
+void phNxpUciHal_GetDispatchStats(phOsalUwb_DispatchStats_t* pStats);
+void phNxpUciHal_ResetDispatchStats(void);
 #endif /* _PHNXPUCIHAL_ADAPTATION_H_ */
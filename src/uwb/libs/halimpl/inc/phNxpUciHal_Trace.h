@@ -0,0 +1,144 @@
+/*
+ * UCI TX/RX 二進位 trace ring。
+ *
+ * LOG_TX/LOG_RX 在 TML reader、HAL client thread 這些 hot path 上呼叫，
+ * 直接 shell_print/LOG_HEXDUMP 會經過 RS485 shell (DE busy-wait)，
+ * 讓封包時序整個跑掉。開啟 CONFIG_UWB_TRACE 時改為把封包寫進固定大小
+ * 的 ring：寫入端只做一次 atomic_inc + memcpy，不取 lock、不進 kernel，
+ * 格式化與輸出交給低優先權的 drain thread 或事後用 "uwb_trace dump"。
+ */
+#ifndef _PHNXPUCIHAL_TRACE_H_
+#define _PHNXPUCIHAL_TRACE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/shell/shell.h>
+
+#ifndef CONFIG_UWB_TRACE_RECORDS
+#define CONFIG_UWB_TRACE_RECORDS 64
+#endif
+#ifndef CONFIG_UWB_TRACE_BYTES
+#define CONFIG_UWB_TRACE_BYTES 32
+#endif
+#ifndef CONFIG_UWB_TRACE_DRAIN_PERIOD_MS
+#define CONFIG_UWB_TRACE_DRAIN_PERIOD_MS 50
+#endif
+
+#define PH_NXPUCIHAL_TRACE_TX 0
+#define PH_NXPUCIHAL_TRACE_RX 1
+
+/* ring 中的一筆紀錄；bytes 超過 CONFIG_UWB_TRACE_BYTES 的部分只記長度 */
+typedef struct phNxpUciHal_TraceRec {
+  uint32_t dwSeq;      /* 寫入序號，從 0 開始連續遞增 */
+  uint32_t dwCycles;   /* 寫入時的 k_cycle_get_32() */
+  const char* pTag;    /* LOG_TX/LOG_RX 的 Message (必須是字串常數) */
+  uint16_t wLength;    /* 原始封包長度 */
+  uint8_t bDir;        /* PH_NXPUCIHAL_TRACE_TX / PH_NXPUCIHAL_TRACE_RX */
+  uint8_t aData[CONFIG_UWB_TRACE_BYTES];
+} phNxpUciHal_TraceRec_t;
+
+typedef struct phNxpUciHal_TraceStats {
+  uint32_t dwWritten;    /* 總寫入筆數 (含已被覆蓋的) */
+  uint32_t dwStreamed;   /* drain thread 已輸出的筆數 */
+  uint32_t dwStreamLost; /* drain thread 來不及輸出就被覆蓋的筆數 */
+  uint16_t wRecords;     /* ring 容量 */
+  uint16_t wBytes;       /* 每筆保留的 payload bytes */
+  bool bStreaming;
+} phNxpUciHal_TraceStats_t;
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceWrite
+**
+** Description      Appends one UCI packet to the trace ring. Lock-free and
+**                  safe from any thread; the oldest record is overwritten
+**                  when the ring is full.
+**
+** Returns          None
+**
+*******************************************************************************/
+void phNxpUciHal_TraceWrite(uint8_t bDir, const char* pTag,
+                            const uint8_t* pData, uint16_t wLength);
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceHead
+**
+** Description      Returns the sequence number the next record will get.
+**
+** Returns          Number of records written since boot
+**
+*******************************************************************************/
+uint32_t phNxpUciHal_TraceHead(void);
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceFirst
+**
+** Description      Returns the sequence number of the oldest record still
+**                  held by the ring and not cleared by phNxpUciHal_TraceClear.
+**
+** Returns          Oldest readable sequence number
+**
+*******************************************************************************/
+uint32_t phNxpUciHal_TraceFirst(void);
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceClear
+**
+** Description      Hides every record written so far from later dumps.
+**
+** Returns          None
+**
+*******************************************************************************/
+void phNxpUciHal_TraceClear(void);
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceRead
+**
+** Description      Copies record dwSeq out of the ring.
+**
+** Returns          true if the record was read, false if it has not been
+**                  written yet, was overwritten or changed while copying
+**
+*******************************************************************************/
+bool phNxpUciHal_TraceRead(uint32_t dwSeq, phNxpUciHal_TraceRec_t* pRec);
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TracePrint
+**
+** Description      Formats one record as a single hexdump line on sh.
+**
+** Returns          None
+**
+*******************************************************************************/
+void phNxpUciHal_TracePrint(const struct shell* sh,
+                            const phNxpUciHal_TraceRec_t* pRec);
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceStream
+**
+** Description      Starts streaming new records to sh from the drain thread,
+**                  or stops streaming when sh is NULL.
+**
+** Returns          None
+**
+*******************************************************************************/
+void phNxpUciHal_TraceStream(const struct shell* sh);
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceGetStats
+**
+** Description      Returns the trace ring counters.
+**
+** Returns          None
+**
+*******************************************************************************/
+void phNxpUciHal_TraceGetStats(phNxpUciHal_TraceStats_t* pStats);
+
+#endif /* _PHNXPUCIHAL_TRACE_H_ */
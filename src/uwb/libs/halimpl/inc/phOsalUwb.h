@@ -169,6 +169,7 @@ typedef void* (*pphOsalUwb_ThreadFunction_t)(void*);
 #ifndef PHOSALUWB_THREAD_H
 #include "phOsalUwb_Thread.h"
 #endif  // PHOSALUWB_THREAD_H
+#include "phOsalUwb_Latency.h"
 #include "phOsalUwb_Queue.h"
 #include "phOsalUwb_Timer.h"
 
@@ -209,6 +210,37 @@ void* phOsalUwb_GetMemory(uint32_t dwSize);
  */
 void phOsalUwb_FreeMemory(void* pMem);
 
+/**
+ * Usage of one allocator pool. The system heap fallback is reported as an
+ * entry with \a dwBlockSize and \a wBlocks set to 0.
+ */
+typedef struct phOsalUwb_MemStats {
+  uint32_t dwBlockSize; /**< Block size of the size class, 0 for the heap */
+  uint16_t wBlocks;     /**< Blocks in the pool, 0 for the heap */
+  uint16_t wInUse;      /**< Blocks currently allocated */
+  uint16_t wMaxInUse;   /**< High water mark of \a wInUse */
+  uint32_t dwAllocs;    /**< Successful allocations */
+  uint32_t dwFailures;  /**< Pool exhausted / heap allocation failed */
+} phOsalUwb_MemStats_t;
+
+/**
+ * Returns the usage of the allocator behind phOsalUwb_GetMemory().
+ *
+ * \param[out] pStats       Array receiving one entry per size class, followed
+ *                          by the heap fallback entry
+ * \param[in]  bMaxEntries  Number of entries in \a pStats
+ *
+ * \retval Number of entries written.
+ */
+uint8_t phOsalUwb_GetMemStats(phOsalUwb_MemStats_t* pStats,
+                              uint8_t bMaxEntries);
+
+/**
+ * Clears the allocation and failure counters, high water marks restart from
+ * the current usage.
+ */
+void phOsalUwb_ResetMemStats(void);
+
 /**
  * This API allows to delay the current thread execution.
  * \note This function executes successfully without OSAL module Initialization.
@@ -218,6 +250,30 @@ void phOsalUwb_FreeMemory(void* pMem);
  */
 void phOsalUwb_Delay(uint32_t dwDelay);
 
+/**
+ * Returns a free running CPU cycle stamp for latency measurements.
+ *
+ * Backed by timing_counter_get() (DWT CYCCNT on Cortex-M), not by
+ * k_cycle_get_32(), which on nRF52 is the 32.768 kHz RTC and cannot resolve
+ * intervals below ~30 us. The stamp wraps after 2^32 CPU cycles (67 s at
+ * 64 MHz), so it is only meaningful for shorter intervals.
+ * \note This function executes successfully without OSAL module
+ * Initialization and may be called from an ISR.
+ *
+ * \retval Current cycle stamp.
+ */
+uint32_t phOsalUwb_GetCycles(void);
+
+/**
+ * Converts the time elapsed since a phOsalUwb_GetCycles() stamp.
+ * \note This function may be called from an ISR.
+ *
+ * \param[in] dwStartCycles  Stamp returned by phOsalUwb_GetCycles()
+ *
+ * \retval Microseconds elapsed since \a dwStartCycles.
+ */
+uint32_t phOsalUwb_CyclesElapsedUs(uint32_t dwStartCycles);
+
 /**
  * Compares the values stored in the source memory with the
  * values stored in the destination memory.
@@ -418,6 +474,50 @@ UWBSTATUS phOsalUwb_UnlockMutex(void* hMutex);
  */
 UWBSTATUS phOsalUwb_DeleteMutex(void** hMutex);
 
+#ifndef CONFIG_UWB_OSAL_SYNC_OBJECTS
+#define CONFIG_UWB_OSAL_SYNC_OBJECTS 40
+#endif
+/** Capacity of the static semaphore/mutex table */
+#define PH_OSALUWB_SYNC_OBJECTS CONFIG_UWB_OSAL_SYNC_OBJECTS
+
+/** Kind of a semaphore/mutex table entry */
+typedef enum phOsalUwb_SyncObjType {
+  kOsalUwb_SyncObj_Free = 0,
+  kOsalUwb_SyncObj_Semaphore,
+  kOsalUwb_SyncObj_BinSem,
+  kOsalUwb_SyncObj_Mutex,
+} phOsalUwb_SyncObjType_t;
+
+/** Snapshot of one live semaphore/mutex */
+typedef struct phOsalUwb_SyncObjInfo {
+  const void* pHandle; /**< Handle returned by the create call */
+  const void* pOwner;  /**< Return address of the create call */
+  char acThread[12];   /**< Name of the creating thread, empty if unknown */
+  uint8_t bType;       /**< #phOsalUwb_SyncObjType_t */
+} phOsalUwb_SyncObjInfo_t;
+
+/** Usage of the semaphore/mutex table */
+typedef struct phOsalUwb_SyncObjStats {
+  uint16_t wCapacity;  /**< Entries in the table */
+  uint16_t wInUse;     /**< Live objects */
+  uint16_t wMaxInUse;  /**< High water mark of \a wInUse */
+  uint32_t dwFailures; /**< Create calls rejected because the table was full */
+} phOsalUwb_SyncObjStats_t;
+
+/**
+ * Copies the live semaphores/mutexes, e.g. to find objects leaked across
+ * UwbApi_ShutDown.
+ *
+ * \param[out] pInfo    Array receiving one entry per live object
+ * \param[in]  wMax     Number of entries in \a pInfo
+ * \param[out] pStats   Table usage, may be NULL
+ *
+ * \retval Number of entries written.
+ */
+uint16_t phOsalUwb_GetSyncObjects(phOsalUwb_SyncObjInfo_t* pInfo,
+                                  uint16_t wMax,
+                                  phOsalUwb_SyncObjStats_t* pStats);
+
 /**
  * Get tick count since scheduler has started.
  *
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2012-2020,2023 NXP.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * OSAL latency histogram, shared by the TML and message queue statistics.
+ */
+
+#ifndef PHOSALUWB_LATENCY_H
+#define PHOSALUWB_LATENCY_H
+
+#include <stdint.h>
+
+/**
+ * Upper bounds (us) of the latency histogram buckets. The last bucket counts
+ * everything above the last bound.
+ */
+#define PH_OSALUWB_LAT_BUCKETS_US {100, 250, 500, 1000, 2000, 5000}
+#define PH_OSALUWB_LAT_BUCKETS (6 + 1)
+
+/**
+ * Latency histogram shared by the TML IRQ and message dispatch statistics.
+ * Samples are measured with phOsalUwb_CyclesElapsedUs().
+ */
+typedef struct phOsalUwb_LatencyStats {
+  uint32_t dwSamples; /**< Samples accounted */
+  uint32_t dwMinUs;   /**< Shortest latency */
+  uint32_t dwMaxUs;   /**< Longest latency */
+  uint64_t qwTotalUs; /**< Sum of all latencies, for the average */
+  uint32_t adwHistogram[PH_OSALUWB_LAT_BUCKETS];
+} phOsalUwb_LatencyStats_t;
+
+/**
+ * Accounts one latency sample.
+ * \note The caller serializes updates of \a pStats.
+ *
+ * \param[in] pStats  Histogram to update
+ * \param[in] dwUs    Latency in microseconds
+ */
+void phOsalUwb_LatencyStatsAdd(phOsalUwb_LatencyStats_t* pStats,
+                               uint32_t dwUs);
+
+/**
+ * Clears a latency histogram.
+ *
+ * \param[in] pStats  Histogram to clear
+ */
+void phOsalUwb_LatencyStatsReset(phOsalUwb_LatencyStats_t* pStats);
+
+#endif /* PHOSALUWB_LATENCY_H */
@@ -4,6 +4,7 @@
 #include <zephyr/kernel.h>
 
 #include "phUwbTypes.h"
+#include "phOsalUwb_Latency.h"
 
 #ifndef NO_DELAY
 #define NO_DELAY 0
@@ -85,4 +86,42 @@ void phOsalUwb_msgrelease(intptr_t msqid);
  */
 intptr_t phOsalUwb_msgget(uint32_t queueLength);
 
+/*
+ * Time from phOsalUwb_msgsnd() to the receiving thread dispatching the
+ * message, plus how many messages each wakeup drained.
+ */
+typedef struct phOsalUwb_DispatchStats {
+  uint32_t dwBatches;  /* Wakeups that dispatched at least one message */
+  uint32_t dwMaxBatch; /* Most messages dispatched in one wakeup */
+  phOsalUwb_LatencyStats_t stLatency; /* Queueing latency, one per message */
+} phOsalUwb_DispatchStats_t;
+
+/**
+ * Accounts one dispatched message
+ *
+ * \param[in] pStats  counters of the receiving thread
+ * \param[in] pMsg    message returned by phOsalUwb_msgrcv
+ *
+ */
+void phOsalUwb_DispatchStatsMessage(phOsalUwb_DispatchStats_t* pStats,
+                                    const phLibUwb_Message_t* pMsg);
+
+/**
+ * Accounts the end of a batch drained in one wakeup
+ *
+ * \param[in] pStats  counters of the receiving thread
+ * \param[in] dwCount number of messages in the batch
+ *
+ */
+void phOsalUwb_DispatchStatsBatch(phOsalUwb_DispatchStats_t* pStats,
+                                  uint32_t dwCount);
+
+/**
+ * Clears dispatch counters
+ *
+ * \param[in] pStats  counters to clear
+ *
+ */
+void phOsalUwb_DispatchStatsReset(phOsalUwb_DispatchStats_t* pStats);
+
 #endif
\ No newline at end of file
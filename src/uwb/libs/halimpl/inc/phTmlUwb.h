@@ -20,6 +20,7 @@
 #include <uwb_uwbs_tml_interface.h>
 
 #include "phNxpUciHal_utils.h"
+#include "phOsalUwb_Latency.h"
 #include "phUwbCommon.h"
 #include "phUwb_BuildConfig.h"
 
@@ -54,6 +55,19 @@
  * Writer Thread max wait timeout.
  */
 #define PH_TML_UWB_MAX_WRITER_WAIT (100)
+
+/*
+ * Number of receive slots the Reader thread can have in flight to the upper
+ * layer, and how long it waits for one of them to be released.
+ */
+#ifndef CONFIG_UWB_TML_RX_RING_SLOTS
+#define CONFIG_UWB_TML_RX_RING_SLOTS 3
+#endif
+#ifndef CONFIG_UWB_TML_RX_RING_FULL_WAIT_MS
+#define CONFIG_UWB_TML_RX_RING_FULL_WAIT_MS 100
+#endif
+#define PH_TML_UWB_RX_RING_SLOTS CONFIG_UWB_TML_RX_RING_SLOTS
+#define PH_TML_UWB_RX_RING_FULL_WAIT CONFIG_UWB_TML_RX_RING_FULL_WAIT_MS
 /*
 ***************************Globals,Structure and Enumeration ******************
 */
@@ -176,6 +190,24 @@ typedef struct {
   void* pParams;
 } phTmlUwb_DeferMsg_t; /* DeferMsg structure passed to User Thread */
 
+/*
+ * Receive ring counters of the Reader thread.
+ */
+typedef struct phTmlUwb_RxRingStats {
+  uint8_t bSlots;           /* Number of slots in the ring */
+  uint8_t bInUse;           /* Slots currently owned by the upper layer */
+  uint8_t bMaxInUse;        /* High water mark of bInUse */
+  uint32_t dwDelivered;     /* Packets handed to the upper layer */
+  uint32_t dwRingFullDrops; /* Packets dropped because no slot was free */
+  uint32_t dwPostFailures;  /* Packets dropped because posting failed */
+} phTmlUwb_RxRingStats_t;
+
+/*
+ * Time from the UWBS IRQ to the read completion callback being invoked on the
+ * callback thread. dwSamples counts the packets measured.
+ */
+typedef phOsalUwb_LatencyStats_t phTmlUwb_IrqLatencyStats_t;
+
 /* Function declarations */
 UWBSTATUS phTmlUwb_Init(pphTmlUwb_Config_t pConfig);
 UWBSTATUS phTmlUwb_Shutdown(void);
@@ -185,8 +217,12 @@ UWBSTATUS phTmlUwb_Read(uint8_t* pBuffer, uint16_t wLength,
                         void* pContext);
 void phTmlUwb_WriteAbort(void);
 void phTmlUwb_ReadAbort(void);
-void phTmlUwb_DeferredCall(uintptr_t dwThreadId,
-                           phLibUwb_Message_t* ptWorkerMsg);
+UWBSTATUS phTmlUwb_DeferredCall(uintptr_t dwThreadId,
+                                phLibUwb_Message_t* ptWorkerMsg);
+void phTmlUwb_GetRxRingStats(phTmlUwb_RxRingStats_t* pStats);
+void phTmlUwb_ResetRxRingStats(void);
+void phTmlUwb_GetIrqLatencyStats(phTmlUwb_IrqLatencyStats_t* pStats);
+void phTmlUwb_ResetIrqLatencyStats(void);
 #if UWBIOT_UWBD_SR2XXT
 void phTmlUwb_Chip_Reset(void);
 #endif
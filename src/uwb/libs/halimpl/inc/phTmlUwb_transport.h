@@ -391,6 +391,26 @@ bool phTmlUwb_helios_interupt_status(void);
 *******************************************************************************/
 void phTmlUwb_helios_irq_enable(void);
 
+/*******************************************************************************
+**
+** Function         phTmlUwb_helios_irq_semaphore
+**
+** Description      get the semaphore released on every uwbs irq
+**
+** Returns          OSAL semaphore handle, NULL if the bus is not initialized
+**
+*******************************************************************************/
+void* phTmlUwb_helios_irq_semaphore(void);
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_helios_irq_cycles
+**
+** Description      get the cycle counter captured by the last uwbs irq
+**
+*******************************************************************************/
+uint32_t phTmlUwb_helios_irq_cycles(void);
+
 /*******************************************************************************
 **
 ** Function         phTmlUwb_rdy_read
@@ -450,6 +470,71 @@ UWBSTATUS phTmlUwb_hbci_transcive(uint8_t *pWriteBuf, size_t writeBufLen, uint8_
 *******************************************************************************/
 UWBSTATUS phTmlUwb_hbci_transcive_with_len(uint8_t *pWriteBuf, size_t writeBufLen, uint8_t *pRespBuf, size_t rspBufLen);
 
+/*******************************************************************************
+**
+** Function         phTmlUwb_hbci_write_start
+**
+** Description      Starts writing an HBCI data segment followed by a tail
+**                  (LRC) in one transaction. With the asynchronous SPI
+**                  transport this returns while the data is still on the
+**                  wire; complete it with phTmlUwb_hbci_write_wait.
+**
+** Parameters       pData        - data to write, untouched until the wait
+**                  dataLen      - number of data bytes
+**                  pTail        - bytes written right after pData
+**                  tailLen      - number of tail bytes
+**
+** Returns          UWB status:
+**                  UWBSTATUS_SUCCESS - write started
+**                  UWBSTATUS_FAILED - write could not be started
+**
+*******************************************************************************/
+UWBSTATUS phTmlUwb_hbci_write_start(const uint8_t *pData, size_t dataLen, uint8_t *pTail, size_t tailLen);
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_hbci_write_wait
+**
+** Description      Waits for the write started by phTmlUwb_hbci_write_start
+**
+** Returns          UWB status:
+**                  UWBSTATUS_SUCCESS - data written
+**                  UWBSTATUS_FAILED - write failed
+**
+*******************************************************************************/
+UWBSTATUS phTmlUwb_hbci_write_wait(void);
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_hbci_read
+**
+** Description      Reads one HBCI response frame
+**
+** Parameters       pRespBuf     - response buffer
+**                  pRspBufLen   - response bufferLen
+**
+** Returns          UWB status:
+**                  UWBSTATUS_SUCCESS - frame read
+**                  UWBSTATUS_FAILED - read failed
+**
+*******************************************************************************/
+UWBSTATUS phTmlUwb_hbci_read(uint8_t *pRespBuf, size_t *pRspBufLen);
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_hbci_dma_readable
+**
+** Description      Checks whether the bus can transmit a buffer in place,
+**                  without the caller staging it in RAM first
+**
+** Parameters       pBuf         - buffer to check
+**
+** Returns          TRUE if pBuf can be passed to phTmlUwb_hbci_write_start
+**                  directly
+**
+*******************************************************************************/
+bool phTmlUwb_hbci_dma_readable(const void *pBuf);
+
 /*******************************************************************************
 **
 ** Function         phTmlUwb_set_uci_mode
@@ -134,6 +134,7 @@ typedef struct phLibUwb_Message
     uint16_t eMsgType; /* Type of the message to be posted*/
     void *pMsgData;    /* Pointer to message specific data block in case any*/
     uint16_t Size;     /* Size of the datablock*/
+    uint32_t dwEnqueueCycles; /* phOsalUwb_GetCycles() stamped by phOsalUwb_msgsnd */
 } phLibUwb_Message_t, *pphLibUwb_Message_t;
 
 /**
@@ -246,6 +246,22 @@ uwb_bus_status_t uwb_bus_io_uwbs_irq_disable(uwb_bus_board_ctx_t* pCtx);
 uwb_bus_status_t uwb_bus_io_irq_wait(uwb_bus_board_ctx_t* pCtx,
                                      uint32_t timeout_ms);
 
+/**
+ * @brief      Wait until the UWBS is ready to accept a write
+ *
+ * The UWBS keeps its IRQ line asserted while it has data pending for the
+ * host.  A write must not be started until the line is released again.
+ *
+ * @param      pCtx        The context
+ * @param[in]  timeout_ms  The timeout milliseconds
+ *
+ * @retval kUWB_bus_Status_OK UWBS IRQ is inactive, write can start
+ * @retval kUWB_bus_Status_FAILED IRQ stayed asserted, and we timed out.
+ *
+ */
+uwb_bus_status_t uwb_bus_io_ready_wait(uwb_bus_board_ctx_t* pCtx,
+                                       uint32_t timeout_ms);
+
 /**
  * @brief      Enable the Host IRQ
  *
@@ -291,6 +307,114 @@ uwb_bus_status_t uwb_bus_io_irq_dis(uwb_bus_board_ctx_t* pCtx,
 uwb_bus_status_t uwb_bus_data_tx(uwb_bus_board_ctx_t* pCtx, uint8_t* pBuf,
                                  size_t bufLen);
 
+/**
+ * @brief Run one SPI transaction on the UWB bus
+ *
+ * Blocking with CONFIG_UWB_TML_SPI_SYNC.  With CONFIG_UWB_TML_SPI_ASYNC the
+ * transfer is started with spi_transceive_cb() and the calling thread sleeps
+ * until the completion callback fires.
+ *
+ * @param      pCtx  The context
+ * @param[in]  tx    Buffers to transmit, may be NULL
+ * @param[in]  rx    Buffers to receive into, may be NULL
+ *
+ * @retval kUWB_bus_Status_OK
+ * @retval kUWB_bus_Status_FAILED
+ */
+uwb_bus_status_t uwb_bus_spi_transceive(uwb_bus_board_ctx_t* pCtx,
+                                        const struct spi_buf_set* tx,
+                                        const struct spi_buf_set* rx);
+
+/**
+ * @brief Start one SPI transaction on the UWB bus
+ *
+ * With CONFIG_UWB_TML_SPI_ASYNC this returns as soon as the transfer has been
+ * handed to the bus driver; with CONFIG_UWB_TML_SPI_SYNC the transfer has
+ * already completed.  Either way the result is collected with
+ * @ref uwb_bus_spi_transceive_wait, and tx/rx (including the buffers they
+ * describe) must stay valid until then.
+ *
+ * @param      pCtx  The context
+ * @param[in]  tx    Buffers to transmit, may be NULL
+ * @param[in]  rx    Buffers to receive into, may be NULL
+ *
+ * @retval kUWB_bus_Status_OK      Transfer started
+ * @retval kUWB_bus_Status_FAILED  Transfer could not be started
+ */
+uwb_bus_status_t uwb_bus_spi_transceive_start(uwb_bus_board_ctx_t* pCtx,
+                                              const struct spi_buf_set* tx,
+                                              const struct spi_buf_set* rx);
+
+/**
+ * @brief Wait for the transaction started by @ref uwb_bus_spi_transceive_start
+ *
+ * If the transfer does not complete within MAX_UWBS_SPI_TRANSFER_TIMEOUT, this
+ * keeps waiting for the driver callback for up to the same time again before
+ * it fails, so the buffers are normally no longer in use when it returns. If
+ * the callback still has not come, later transfers fail until it does.
+ *
+ * @param      pCtx  The context
+ *
+ * @retval kUWB_bus_Status_OK
+ * @retval kUWB_bus_Status_FAILED
+ */
+uwb_bus_status_t uwb_bus_spi_transceive_wait(uwb_bus_board_ctx_t* pCtx);
+
+/**
+ * @brief Check whether the bus DMA can read a buffer in place
+ *
+ * Buffers outside of DMA reachable memory (e.g. const data in internal
+ * flash) must be copied to RAM by the caller before they are transmitted;
+ * the HBCI download stages each chunk in a RAM buffer.
+ *
+ * @param[in]  pBuf  Buffer to check
+ *
+ * @return     true when pBuf can be transmitted without staging
+ */
+bool uwb_bus_dma_readable(const void* pBuf);
+
+/**
+ * @brief Transmit a header and payload in a single bus transaction
+ *
+ * Both buffers are handed to the bus driver as one scatter-gather list,
+ * so chip select stays asserted and no inter-segment gap is inserted.
+ *
+ * @param      pCtx        The context
+ * @param[in]  pHdr        The header to transmit
+ * @param[in]  hdrLen      The header length
+ * @param[in]  pPayload    The payload to transmit, may be NULL if payloadLen
+ *                         is 0
+ * @param[in]  payloadLen  The payload length
+ *
+ * @retval kUWB_bus_Status_OK
+ * @retval kUWB_bus_Status_FAILED
+ */
+uwb_bus_status_t uwb_bus_data_tx_sg(uwb_bus_board_ctx_t* pCtx, uint8_t* pHdr,
+                                    size_t hdrLen, uint8_t* pPayload,
+                                    size_t payloadLen);
+
+/**
+ * @brief Start transmitting a header and payload in a single transaction
+ *
+ * Same as @ref uwb_bus_data_tx_sg, but returns once the transfer has been
+ * started.  Complete it with @ref uwb_bus_spi_transceive_wait; both buffers
+ * must stay untouched until then.
+ *
+ * @param      pCtx        The context
+ * @param[in]  pHdr        The header to transmit
+ * @param[in]  hdrLen      The header length
+ * @param[in]  pPayload    The payload to transmit, may be NULL if payloadLen
+ *                         is 0
+ * @param[in]  payloadLen  The payload length
+ *
+ * @retval kUWB_bus_Status_OK
+ * @retval kUWB_bus_Status_FAILED
+ */
+uwb_bus_status_t uwb_bus_data_tx_sg_start(uwb_bus_board_ctx_t* pCtx,
+                                          uint8_t* pHdr, size_t hdrLen,
+                                          uint8_t* pPayload,
+                                          size_t payloadLen);
+
 #if UWBIOT_UWBD_SR040
 /**
  * @brief Transmit a data frame without assert config Flags for SPI.
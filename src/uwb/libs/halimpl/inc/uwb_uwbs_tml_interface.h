@@ -87,8 +87,39 @@ typedef struct {
   uint8_t boardVersion;
 #endif
   int noOfBytesWritten;
+  /** phOsalUwb_GetCycles() at the end of the last bus transfer (TX or RX) */
+  uint32_t lastXferCycles;
+  /** lastXferCycles holds a valid value */
+  bool lastXferValid;
 } uwb_uwbs_tml_ctx_t;
 
+/**
+ * @brief UCI write path latency counters
+ *
+ * Accumulated across init/deinit of the TML layer, cleared with
+ * @ref uwb_uwbs_tml_reset_tx_stats.
+ */
+typedef struct {
+  /** Number of UCI commands written successfully */
+  uint32_t commands;
+  /** Number of UCI commands that failed on the bus */
+  uint32_t failures;
+  /** Sum of per-command latencies (entry to end of SPI transfer) */
+  uint64_t totalLatencyUs;
+  /** Smallest per-command latency */
+  uint32_t minLatencyUs;
+  /** Largest per-command latency */
+  uint32_t maxLatencyUs;
+  /** Time spent honouring the recovery guard after the last transfer */
+  uint64_t guardWaitUs;
+  /** Time spent waiting for the UWBS to release its IRQ line */
+  uint64_t readyWaitUs;
+  /** Largest single ready wait */
+  uint32_t maxReadyWaitUs;
+  /** Number of ready waits that timed out */
+  uint32_t readyTimeouts;
+} uwb_uwbs_tml_tx_stats_t;
+
 /** @} */
 
 /** Initailize it with some sane values
@@ -189,6 +220,45 @@ UWBStatus_t uwb_uwbs_tml_data_trx(uwb_uwbs_tml_ctx_t* pCtx, uint8_t* pTxBuf,
                                   size_t txBufLen, uint8_t* pRxBuf,
                                   size_t* pRxBufLen);
 
+/** Start writing an HBCI data segment followed by a short tail.
+ *
+ * Used by the pipelined FW download: the data (typically a firmware chunk)
+ * and its tail (the LRC byte) go out in one transaction, and the caller may
+ * prepare the next chunk before calling @ref uwb_uwbs_tml_hbci_tx_wait.
+ * Neither buffer may be modified until then.
+ *
+ * @param          pCtx     The context
+ * @param[in]      pData    Data to be transmitted
+ * @param[in]      dataLen  Data length
+ * @param[in]      pTail    Bytes transmitted right after pData
+ * @param[in]      tailLen  Tail length
+ *
+ * @return     Status of the transfer start
+ */
+UWBStatus_t uwb_uwbs_tml_hbci_tx_start(uwb_uwbs_tml_ctx_t* pCtx,
+                                       const uint8_t* pData, size_t dataLen,
+                                       uint8_t* pTail, size_t tailLen);
+
+/** Complete the write started with @ref uwb_uwbs_tml_hbci_tx_start.
+ *
+ * @param          pCtx     The context
+ *
+ * @return     Status of the transfer
+ */
+UWBStatus_t uwb_uwbs_tml_hbci_tx_wait(uwb_uwbs_tml_ctx_t* pCtx);
+
+/** Read one HBCI response frame.
+ *
+ * @param          pCtx     The context
+ * @param[out]     pRxBuf   The pointer where we copy received data
+ * @param[in,out]  pRxBufLen Input: The max length that we can copy.  Output:
+ * actual length read.
+ *
+ * @return     Status of Rx
+ */
+UWBStatus_t uwb_uwbs_tml_hbci_rx(uwb_uwbs_tml_ctx_t* pCtx, uint8_t* pRxBuf,
+                                 size_t* pRxBufLen);
+
 /** Trans-Receive a data frame with known receive length.
  *
  * Transmit and receive happens at the same time for this frame.
@@ -253,6 +323,15 @@ void uwb_uwbs_tml_flush_read_buffer(uwb_uwbs_tml_ctx_t* pCtx);
 
 #endif  // UWBIOT_UWBD_SR040
 
+/** Get a snapshot of the UCI write path latency counters
+ *
+ * @param[out]  pStats  Filled with the current counters
+ */
+void uwb_uwbs_tml_get_tx_stats(uwb_uwbs_tml_tx_stats_t* pStats);
+
+/** Clear the UCI write path latency counters */
+void uwb_uwbs_tml_reset_tx_stats(void);
+
 /** @} */  // uwb_uwbs_tml_data
 
 #endif
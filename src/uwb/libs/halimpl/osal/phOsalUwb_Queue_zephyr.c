@@ -1,4 +1,5 @@
 #include "phOsalUwb_Queue.h"
+#include "phOsalUwb.h"
 #include "phUwbStatus.h"
 
 /*******************************************************************************
@@ -77,6 +78,9 @@ UWBSTATUS phOsalUwb_msgsnd(intptr_t msqid, phLibUwb_Message_t* msg,
   struct k_msgq* q = (struct k_msgq*)msqid;
   k_timeout_t wait_time;
 
+  /* 接收端用來計算排隊延遲 */
+  msg->dwEnqueueCycles = phOsalUwb_GetCycles();
+
   /* 2. 轉換時間參數 (NXP -> Zephyr) */
   if (waittimeout == NO_DELAY) {
     wait_time = K_NO_WAIT;
@@ -121,11 +125,11 @@ void phOsalUwb_msgrelease(intptr_t msqid) {
     /* 1. 釋放 Ring Buffer */
     /* Zephyr 的 k_msgq 結構中有保存 buffer_start 指標 */
     if (q->buffer_start != NULL) {
-      k_free(q->buffer_start);
+      phOsalUwb_FreeMemory(q->buffer_start);
     }
 
     /* 2. 釋放 Queue 結構體本身 */
-    k_free(q);
+    phOsalUwb_FreeMemory(q);
   }
 }
 
@@ -151,7 +155,8 @@ intptr_t phOsalUwb_msgget(uint32_t queueLength) {
   size_t msg_size = sizeof(phLibUwb_Message_t);
 
   /* 2. 分配 Zephyr k_msgq 結構體本身的記憶體 */
-  struct k_msgq* pQueue = (struct k_msgq*)k_malloc(sizeof(struct k_msgq));
+  struct k_msgq* pQueue =
+      (struct k_msgq*)phOsalUwb_GetMemory(sizeof(struct k_msgq));
   if (pQueue == NULL) {
     // LOG_ERR("Failed to allocate queue struct");
     return -1;  // 或回傳 0/NULL，視 NXP 定義而定，通常 -1 代表錯誤
@@ -159,10 +164,10 @@ intptr_t phOsalUwb_msgget(uint32_t queueLength) {
 
   /* 3. 分配 Queue 實際存放資料的 Ring Buffer 記憶體 */
   /* 大小 = 訊息數量 * 單一訊息大小 */
-  char* buffer = (char*)k_malloc(queueLength * msg_size);
+  char* buffer = (char*)phOsalUwb_GetMemory(queueLength * msg_size);
   if (buffer == NULL) {
     // LOG_ERR("Failed to allocate queue buffer");
-    k_free(pQueue);  // 記得釋放剛剛分配的 struct
+    phOsalUwb_FreeMemory(pQueue);  // 記得釋放剛剛分配的 struct
     return -1;
   }
 
@@ -172,4 +177,60 @@ intptr_t phOsalUwb_msgget(uint32_t queueLength) {
 
   /* 5. 回傳指標轉型為 intptr_t */
   return (intptr_t)pQueue;
-}
\ No newline at end of file
+}
+
+/*******************************************************************************
+**
+** Function         phOsalUwb_DispatchStatsMessage
+**
+** Description      Accounts the queueing latency of a dispatched message
+**
+** Parameters       pStats - counters of the receiving thread
+**                  pMsg   - message returned by phOsalUwb_msgrcv
+**
+** Returns          None
+**
+*******************************************************************************/
+void phOsalUwb_DispatchStatsMessage(phOsalUwb_DispatchStats_t* pStats,
+                                    const phLibUwb_Message_t* pMsg) {
+  phOsalUwb_LatencyStatsAdd(&pStats->stLatency,
+                            phOsalUwb_CyclesElapsedUs(pMsg->dwEnqueueCycles));
+}
+
+/*******************************************************************************
+**
+** Function         phOsalUwb_DispatchStatsBatch
+**
+** Description      Accounts the end of a batch drained in one wakeup
+**
+** Parameters       pStats  - counters of the receiving thread
+**                  dwCount - number of messages in the batch
+**
+** Returns          None
+**
+*******************************************************************************/
+void phOsalUwb_DispatchStatsBatch(phOsalUwb_DispatchStats_t* pStats,
+                                  uint32_t dwCount) {
+  if (dwCount == 0) {
+    return;
+  }
+  pStats->dwBatches++;
+  if (dwCount > pStats->dwMaxBatch) {
+    pStats->dwMaxBatch = dwCount;
+  }
+}
+
+/*******************************************************************************
+**
+** Function         phOsalUwb_DispatchStatsReset
+**
+** Description      Clears dispatch counters
+**
+** Parameters       pStats - counters to clear
+**
+** Returns          None
+**
+*******************************************************************************/
+void phOsalUwb_DispatchStatsReset(phOsalUwb_DispatchStats_t* pStats) {
+  phOsalUwb_SetMemory(pStats, 0, sizeof(*pStats));
+}
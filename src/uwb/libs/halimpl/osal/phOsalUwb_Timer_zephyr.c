@@ -105,8 +105,8 @@ uint32_t phOsalUwb_Timer_Create(uint8_t bAutoReload) {
     dwTimerId += PH_UWB_TIMER_BASE_ADDRESS;
 
     /* [Zephyr Porting] 分配 Wrapper 記憶體 */
-    pWrapper =
-        (zephyr_timer_wrapper_t*)k_malloc(sizeof(zephyr_timer_wrapper_t));
+    pWrapper = (zephyr_timer_wrapper_t*)phOsalUwb_GetMemory(
+        sizeof(zephyr_timer_wrapper_t));
 
     if (pWrapper != NULL) {
       memset(pWrapper, 0, sizeof(zephyr_timer_wrapper_t));
@@ -296,7 +296,7 @@ UWBSTATUS phOsalUwb_Timer_Delete(uint32_t dwTimerId) {
       k_work_cancel(&pWrapper->work);
 
       /* 釋放 Wrapper */
-      k_free(pWrapper);
+      phOsalUwb_FreeMemory(pWrapper);
       pTimerHandle->hTimerHandle = NULL;
     }
 
@@ -85,7 +85,8 @@ UWBSTATUS phOsalUwb_Thread_Create(void** hThread,
   prio = K_PRIO_PREEMPT(threadparams->priority);
 
   /* 2. 動態分配管理結構 */
-  pThreadObj = (osal_thread_obj_t*)k_malloc(sizeof(osal_thread_obj_t));
+  pThreadObj =
+      (osal_thread_obj_t*)phOsalUwb_GetMemory(sizeof(osal_thread_obj_t));
   if (pThreadObj == NULL) {
     LOG_ERR("Failed to allocate thread object");
     return PHUWBSTVAL(CID_UWB_OSAL, PH_OSALUWB_THREAD_CREATION_ERROR);
@@ -102,7 +103,7 @@ UWBSTATUS phOsalUwb_Thread_Create(void** hThread,
 
   if (pThreadObj->stack_mem == NULL) {
     LOG_ERR("Failed to allocate thread stack");
-    k_free(pThreadObj);
+    phOsalUwb_FreeMemory(pThreadObj);
     return PHUWBSTVAL(CID_UWB_OSAL, PH_OSALUWB_THREAD_CREATION_ERROR);
   }
 
@@ -156,7 +157,7 @@ UWBSTATUS phOsalUwb_Thread_Delete(UWBOSAL_TASK_HANDLE hThread) {
   if (pThreadObj->stack_mem) {
     k_free(pThreadObj->stack_mem);
   }
-  k_free(pThreadObj);
+  phOsalUwb_FreeMemory(pThreadObj);
 
   LOG_DBG("Terminated thread %p", hThread);
 
@@ -4,26 +4,140 @@
 #include <stdlib.h>
 #include <string.h>
 #include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
 
 #include "phNxpLogApis_UwbApi.h"
 #include "phOsalUwb_Internal.h"
 
+/*
+ * 固定大小區塊的記憶體池 (取代 k_malloc，避免 UwbApi_Init/ShutDown 反覆
+ * 執行後 heap 碎片化)。Size class 依 UWB stack 實際的配置情況設定：
+ *   32  : OSAL semaphore/mutex/timer wrapper、list node、UWA API 訊息
+ *   64  : k_msgq 結構、TML context、HAL event 訊息
+ *   128 : 短的 UCI 指令/通知訊息
+ *   320 : UCI 封包訊息 (UWB_HDR + UCI_MAX_DATA_LEN)、thread object
+ *   800 : message queue buffer (configTML_QUEUE_LENGTH 筆訊息)
+ * 更大的需求 (FW download buffer、raw command) 走 heap fallback。
+ */
+typedef struct phOsalUwb_MemPool {
+  struct k_mem_slab slab;
+  uint8_t* pBuffer;
+  phOsalUwb_MemStats_t stats;
+} phOsalUwb_MemPool_t;
+
+#if IS_ENABLED(CONFIG_UWB_OSAL_MEM_POOL)
+#define PH_OSALUWB_MEM_POOL(buf, size, count) \
+  { .pBuffer = (buf), .stats = {.dwBlockSize = (size), .wBlocks = (count)} }
+
+static uint8_t __aligned(8) gMemPool32[32 * 48];
+static uint8_t __aligned(8) gMemPool64[64 * 24];
+static uint8_t __aligned(8) gMemPool128[128 * 16];
+static uint8_t __aligned(8) gMemPool320[320 * 12];
+static uint8_t __aligned(8) gMemPool800[800 * 4];
+
+/* 由小到大排列，配置時取第一個放得下且還有空位的 class */
+static phOsalUwb_MemPool_t gMemPools[] = {
+    PH_OSALUWB_MEM_POOL(gMemPool32, 32, 48),
+    PH_OSALUWB_MEM_POOL(gMemPool64, 64, 24),
+    PH_OSALUWB_MEM_POOL(gMemPool128, 128, 16),
+    PH_OSALUWB_MEM_POOL(gMemPool320, 320, 12),
+    PH_OSALUWB_MEM_POOL(gMemPool800, 800, 4),
+};
+
+static int phOsalUwb_MemPoolInit(void) {
+  for (size_t i = 0; i < ARRAY_SIZE(gMemPools); i++) {
+    k_mem_slab_init(&gMemPools[i].slab, gMemPools[i].pBuffer,
+                    gMemPools[i].stats.dwBlockSize,
+                    gMemPools[i].stats.wBlocks);
+  }
+  return 0;
+}
+/* phOsalUwb_GetMemory 不需要 OSAL 初始化即可使用，因此在開機時建立 pool */
+SYS_INIT(phOsalUwb_MemPoolInit, PRE_KERNEL_1,
+         CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+static phOsalUwb_MemPool_t* phOsalUwb_MemPoolOf(const void* pMem) {
+  for (size_t i = 0; i < ARRAY_SIZE(gMemPools); i++) {
+    const uint8_t* pStart = gMemPools[i].pBuffer;
+    const uint8_t* pEnd =
+        pStart + gMemPools[i].stats.dwBlockSize * gMemPools[i].stats.wBlocks;
+    if (((const uint8_t*)pMem >= pStart) && ((const uint8_t*)pMem < pEnd)) {
+      return &gMemPools[i];
+    }
+  }
+  return NULL;
+}
+#endif  // CONFIG_UWB_OSAL_MEM_POOL
+
+/* Heap fallback 的使用狀況 (dwBlockSize/wBlocks 固定為 0) */
+static phOsalUwb_MemStats_t gMemHeapStats;
+static struct k_spinlock gMemStatsLock;
+
+static void phOsalUwb_MemStatsAlloc(phOsalUwb_MemStats_t* pStats) {
+  k_spinlock_key_t key = k_spin_lock(&gMemStatsLock);
+  pStats->dwAllocs++;
+  pStats->wInUse++;
+  if (pStats->wInUse > pStats->wMaxInUse) {
+    pStats->wMaxInUse = pStats->wInUse;
+  }
+  k_spin_unlock(&gMemStatsLock, key);
+}
+
+static void phOsalUwb_MemStatsFree(phOsalUwb_MemStats_t* pStats) {
+  k_spinlock_key_t key = k_spin_lock(&gMemStatsLock);
+  if (pStats->wInUse > 0) {
+    pStats->wInUse--;
+  }
+  k_spin_unlock(&gMemStatsLock, key);
+}
+
+static void phOsalUwb_MemStatsFail(phOsalUwb_MemStats_t* pStats) {
+  k_spinlock_key_t key = k_spin_lock(&gMemStatsLock);
+  pStats->dwFailures++;
+  k_spin_unlock(&gMemStatsLock, key);
+}
+
 /*
 *************************** Function Definitions ******************************
 */
 
 /*!
  * \brief Allocates memory.
- *        This function attempts to allocate \a size bytes on the heap and
+ *        This function attempts to allocate \a size bytes from the smallest
+ *        fitting block pool, falling back to the heap when enabled, and
  *        returns a pointer to the allocated block.
  *
- * \param size size of the memory block to be allocated on the heap.
+ * \param size size of the memory block to be allocated.
  *
  * \return pointer to allocated memory block or NULL in case of error.
  */
 void* phOsalUwb_GetMemory(uint32_t dwSize) {
+  void* pMem = NULL;
   // printk("%s: size = %d\n", __FUNCTION__, dwSize);
-  return k_malloc(dwSize);
+#if IS_ENABLED(CONFIG_UWB_OSAL_MEM_POOL)
+  for (size_t i = 0; i < ARRAY_SIZE(gMemPools); i++) {
+    if (dwSize > gMemPools[i].stats.dwBlockSize) {
+      continue;
+    }
+    if (k_mem_slab_alloc(&gMemPools[i].slab, &pMem, K_NO_WAIT) == 0) {
+      phOsalUwb_MemStatsAlloc(&gMemPools[i].stats);
+      return pMem;
+    }
+    /* Class exhausted, try the next bigger one */
+    phOsalUwb_MemStatsFail(&gMemPools[i].stats);
+  }
+#if !IS_ENABLED(CONFIG_UWB_OSAL_MEM_POOL_HEAP_FALLBACK)
+  phOsalUwb_MemStatsFail(&gMemHeapStats);
+  return NULL;
+#endif
+#endif  // CONFIG_UWB_OSAL_MEM_POOL
+  pMem = k_malloc(dwSize);
+  if (pMem != NULL) {
+    phOsalUwb_MemStatsAlloc(&gMemHeapStats);
+  } else {
+    phOsalUwb_MemStatsFail(&gMemHeapStats);
+  }
+  return pMem;
 }
 
 /*!
@@ -34,9 +148,56 @@ void* phOsalUwb_GetMemory(uint32_t dwSize) {
  */
 void phOsalUwb_FreeMemory(void* pMem) {
   /* Check whether a null pointer is passed */
-  if (NULL != pMem) {
-    k_free(pMem);
+  if (NULL == pMem) {
+    return;
+  }
+#if IS_ENABLED(CONFIG_UWB_OSAL_MEM_POOL)
+  phOsalUwb_MemPool_t* pPool = phOsalUwb_MemPoolOf(pMem);
+  if (pPool != NULL) {
+    k_mem_slab_free(&pPool->slab, pMem);
+    phOsalUwb_MemStatsFree(&pPool->stats);
+    return;
+  }
+#endif  // CONFIG_UWB_OSAL_MEM_POOL
+  k_free(pMem);
+  phOsalUwb_MemStatsFree(&gMemHeapStats);
+}
+
+uint8_t phOsalUwb_GetMemStats(phOsalUwb_MemStats_t* pStats,
+                              uint8_t bMaxEntries) {
+  uint8_t bCount = 0;
+  k_spinlock_key_t key;
+
+  if (pStats == NULL) {
+    return 0;
+  }
+  key = k_spin_lock(&gMemStatsLock);
+#if IS_ENABLED(CONFIG_UWB_OSAL_MEM_POOL)
+  for (size_t i = 0; (i < ARRAY_SIZE(gMemPools)) && (bCount < bMaxEntries);
+       i++) {
+    pStats[bCount++] = gMemPools[i].stats;
+  }
+#endif  // CONFIG_UWB_OSAL_MEM_POOL
+  if (bCount < bMaxEntries) {
+    pStats[bCount++] = gMemHeapStats;
+  }
+  k_spin_unlock(&gMemStatsLock, key);
+  return bCount;
+}
+
+void phOsalUwb_ResetMemStats(void) {
+  k_spinlock_key_t key = k_spin_lock(&gMemStatsLock);
+#if IS_ENABLED(CONFIG_UWB_OSAL_MEM_POOL)
+  for (size_t i = 0; i < ARRAY_SIZE(gMemPools); i++) {
+    gMemPools[i].stats.dwAllocs = 0;
+    gMemPools[i].stats.dwFailures = 0;
+    gMemPools[i].stats.wMaxInUse = gMemPools[i].stats.wInUse;
   }
+#endif  // CONFIG_UWB_OSAL_MEM_POOL
+  gMemHeapStats.dwAllocs = 0;
+  gMemHeapStats.dwFailures = 0;
+  gMemHeapStats.wMaxInUse = gMemHeapStats.wInUse;
+  k_spin_unlock(&gMemStatsLock, key);
 }
 
 void phOsalUwb_SetMemory(void* pMem, uint8_t bVal, uint32_t dwSize) {
@@ -52,6 +213,49 @@ int32_t phOsalUwb_MemCompare(const void* pDest, const void* pSrc,
   return memcmp(pDest, pSrc, dwSize);
 }
 
+/* phOsalUwb_GetCycles 在 IRQ 裡也會用到，開機時就把 DWT cycle counter 打開 */
+static int phOsalUwb_TimingInit(void) {
+  timing_init();
+  timing_start();
+  return 0;
+}
+SYS_INIT(phOsalUwb_TimingInit, APPLICATION,
+         CONFIG_APPLICATION_INIT_PRIORITY);
+
+uint32_t phOsalUwb_GetCycles(void) { return (uint32_t)timing_counter_get(); }
+
+uint32_t phOsalUwb_CyclesElapsedUs(uint32_t dwStartCycles) {
+  /* 32-bit 相減，counter 繞回一次也算得對 */
+  uint32_t dwCycles = phOsalUwb_GetCycles() - dwStartCycles;
+
+  return (uint32_t)(timing_cycles_to_ns(dwCycles) / NSEC_PER_USEC);
+}
+
+static const uint32_t gLatBoundsUs[] = PH_OSALUWB_LAT_BUCKETS_US;
+
+void phOsalUwb_LatencyStatsAdd(phOsalUwb_LatencyStats_t* pStats,
+                               uint32_t dwUs) {
+  uint8_t bBucket = 0;
+
+  while ((bBucket < ARRAY_SIZE(gLatBoundsUs)) &&
+         (dwUs > gLatBoundsUs[bBucket])) {
+    bBucket++;
+  }
+  pStats->adwHistogram[bBucket]++;
+  if ((pStats->dwSamples == 0) || (dwUs < pStats->dwMinUs)) {
+    pStats->dwMinUs = dwUs;
+  }
+  if (dwUs > pStats->dwMaxUs) {
+    pStats->dwMaxUs = dwUs;
+  }
+  pStats->qwTotalUs += dwUs;
+  pStats->dwSamples++;
+}
+
+void phOsalUwb_LatencyStatsReset(phOsalUwb_LatencyStats_t* pStats) {
+  memset(pStats, 0, sizeof(*pStats));
+}
+
 void phOsalUwb_Delay(uint32_t dwDelay) {
   if (k_is_in_isr()) {
     /* 如果在中斷中，使用忙碌等待 (單位是微秒，所以 * 1000) */
@@ -62,6 +266,127 @@ void phOsalUwb_Delay(uint32_t dwDelay) {
   }
 }
 
+/*
+ * Semaphore/Mutex 物件表：建立時從 free list 取出，不向 heap 配置，也不會因
+ * 碎片化而失敗；刪除時放回 free list。Handle 指向 union 開頭，與原本的
+ * phOsalUwb_sOsalSemaphore_t / phOsalUwb_sOsalMutex_t 指標相容。
+ */
+typedef struct phOsalUwb_SyncObj {
+  union {
+    phOsalUwb_sOsalSemaphore_t tSem;
+    phOsalUwb_sOsalMutex_t tMutex;
+  } u;
+  struct phOsalUwb_SyncObj* pNextFree;
+  const void* pOwner; /* 建立者的 return address，可用 addr2line 查詢 */
+  char acThread[12];  /* 建立時所在的 thread 名稱 */
+  uint8_t bType;      /* phOsalUwb_SyncObjType_t */
+} phOsalUwb_SyncObj_t;
+
+static phOsalUwb_SyncObj_t gSyncObjs[PH_OSALUWB_SYNC_OBJECTS];
+static phOsalUwb_SyncObj_t* gpSyncObjFree;
+static phOsalUwb_SyncObjStats_t gSyncObjStats;
+static struct k_spinlock gSyncObjLock;
+
+static int phOsalUwb_SyncObjInit(void) {
+  for (size_t i = ARRAY_SIZE(gSyncObjs); i > 0; i--) {
+    gSyncObjs[i - 1].pNextFree = gpSyncObjFree;
+    gpSyncObjFree = &gSyncObjs[i - 1];
+  }
+  gSyncObjStats.wCapacity = ARRAY_SIZE(gSyncObjs);
+  return 0;
+}
+/* 與記憶體池相同，OSAL 物件在開機時就可使用 */
+SYS_INIT(phOsalUwb_SyncObjInit, PRE_KERNEL_1,
+         CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+static phOsalUwb_SyncObj_t* phOsalUwb_SyncObjAlloc(uint8_t bType,
+                                                   const void* pOwner) {
+  phOsalUwb_SyncObj_t* pObj;
+  const char* pThreadName = NULL;
+  k_spinlock_key_t key = k_spin_lock(&gSyncObjLock);
+
+  pObj = gpSyncObjFree;
+  if (pObj != NULL) {
+    gpSyncObjFree = pObj->pNextFree;
+    pObj->pNextFree = NULL;
+    pObj->bType = bType;
+    pObj->pOwner = pOwner;
+    gSyncObjStats.wInUse++;
+    if (gSyncObjStats.wInUse > gSyncObjStats.wMaxInUse) {
+      gSyncObjStats.wMaxInUse = gSyncObjStats.wInUse;
+    }
+  } else {
+    gSyncObjStats.dwFailures++;
+  }
+  k_spin_unlock(&gSyncObjLock, key);
+
+  if (pObj != NULL) {
+    if (!k_is_in_isr()) {
+      pThreadName = k_thread_name_get(k_current_get());
+    }
+    strncpy(pObj->acThread, (pThreadName != NULL) ? pThreadName : "",
+            sizeof(pObj->acThread) - 1);
+    pObj->acThread[sizeof(pObj->acThread) - 1] = '\0';
+  } else {
+    LOG_E("OSAL sync object table full (%d), created by %p",
+          PH_OSALUWB_SYNC_OBJECTS, pOwner);
+  }
+  return pObj;
+}
+
+/* 檢查 handle 是否為物件表中、且種類相符的 live 物件 */
+static phOsalUwb_SyncObj_t* phOsalUwb_SyncObjOf(void* hObj, bool bMutex) {
+  phOsalUwb_SyncObj_t* pObj = (phOsalUwb_SyncObj_t*)hObj;
+  uintptr_t offset = (uintptr_t)hObj - (uintptr_t)&gSyncObjs[0];
+
+  if (((uintptr_t)hObj < (uintptr_t)&gSyncObjs[0]) ||
+      (offset >= sizeof(gSyncObjs)) ||
+      ((offset % sizeof(gSyncObjs[0])) != 0)) {
+    return NULL;
+  }
+  if (bMutex ? (pObj->bType != kOsalUwb_SyncObj_Mutex)
+             : ((pObj->bType != kOsalUwb_SyncObj_Semaphore) &&
+                (pObj->bType != kOsalUwb_SyncObj_BinSem))) {
+    return NULL;
+  }
+  return pObj;
+}
+
+static void phOsalUwb_SyncObjFree(phOsalUwb_SyncObj_t* pObj) {
+  k_spinlock_key_t key = k_spin_lock(&gSyncObjLock);
+  pObj->bType = kOsalUwb_SyncObj_Free;
+  pObj->pNextFree = gpSyncObjFree;
+  gpSyncObjFree = pObj;
+  gSyncObjStats.wInUse--;
+  k_spin_unlock(&gSyncObjLock, key);
+}
+
+uint16_t phOsalUwb_GetSyncObjects(phOsalUwb_SyncObjInfo_t* pInfo,
+                                  uint16_t wMax,
+                                  phOsalUwb_SyncObjStats_t* pStats) {
+  uint16_t wCount = 0;
+  k_spinlock_key_t key = k_spin_lock(&gSyncObjLock);
+
+  for (size_t i = 0; (i < ARRAY_SIZE(gSyncObjs)) && (pInfo != NULL) &&
+                     (wCount < wMax);
+       i++) {
+    if (gSyncObjs[i].bType == kOsalUwb_SyncObj_Free) {
+      continue;
+    }
+    pInfo[wCount].pHandle = &gSyncObjs[i];
+    pInfo[wCount].pOwner = gSyncObjs[i].pOwner;
+    memcpy(pInfo[wCount].acThread, gSyncObjs[i].acThread,
+           sizeof(pInfo[wCount].acThread));
+    pInfo[wCount].bType = gSyncObjs[i].bType;
+    wCount++;
+  }
+  if (pStats != NULL) {
+    *pStats = gSyncObjStats;
+  }
+  k_spin_unlock(&gSyncObjLock, key);
+  return wCount;
+}
+
 /*******************************************************************************
 **
 ** Function         phOsalUwb_CreateSemaphore
@@ -71,17 +396,16 @@ void phOsalUwb_Delay(uint32_t dwDelay) {
 *******************************************************************************/
 UWBSTATUS phOsalUwb_CreateSemaphore(void** hSemaphore, uint8_t bInitialValue) {
   UWBSTATUS wCreateStatus = UWBSTATUS_SUCCESS;
-  phOsalUwb_sOsalSemaphore_t* pSemaphoreHandle = NULL;
+  phOsalUwb_SyncObj_t* pObj = NULL;
 
   /* Check input parameters */
   if (NULL == hSemaphore) {
     wCreateStatus = PHUWBSTVAL(CID_UWB_OSAL, UWBSTATUS_INVALID_PARAMETER);
   } else {
-    pSemaphoreHandle = (phOsalUwb_sOsalSemaphore_t*)phOsalUwb_GetMemory(
-        sizeof(phOsalUwb_sOsalSemaphore_t));
+    pObj = phOsalUwb_SyncObjAlloc(kOsalUwb_SyncObj_Semaphore,
+                                  __builtin_return_address(0));
 
-    if (pSemaphoreHandle == NULL) {
-      printk("Error: phOsalUwb_GetMemory failed!\n");
+    if (pObj == NULL) {
       wCreateStatus =
           PHUWBSTVAL(CID_UWB_OSAL, PH_OSALUWB_SEMAPHORE_CREATION_ERROR);
       return wCreateStatus;
@@ -92,17 +416,17 @@ UWBSTATUS phOsalUwb_CreateSemaphore(void** hSemaphore, uint8_t bInitialValue) {
      * NXP 原始碼 xSemaphoreCreateCounting(1, bInitialValue) 暗示這是 Binary
      * Semaphore (Limit=1)
      */
-    int ret = k_sem_init(&pSemaphoreHandle->ObjectHandle,
+    int ret = k_sem_init(&pObj->u.tSem.ObjectHandle,
                          (unsigned int)bInitialValue, 1);
 
     if (ret != 0) {
       wCreateStatus =
           PHUWBSTVAL(CID_UWB_OSAL, PH_OSALUWB_SEMAPHORE_CREATION_ERROR);
-      k_free(pSemaphoreHandle);
+      phOsalUwb_SyncObjFree(pObj);
       *hSemaphore = NULL;
     } else {
       /* Return the handle (pointer to our wrapper struct) */
-      *hSemaphore = (void*)pSemaphoreHandle;
+      *hSemaphore = (void*)&pObj->u.tSem;
     }
   }
   return wCreateStatus;
@@ -117,15 +441,15 @@ UWBSTATUS phOsalUwb_CreateSemaphore(void** hSemaphore, uint8_t bInitialValue) {
 *******************************************************************************/
 UWBSTATUS phOsalUwb_CreateBinSem(void** hBinSem) {
   UWBSTATUS wCreateStatus = UWBSTATUS_SUCCESS;
-  phOsalUwb_sOsalSemaphore_t* pBinSemHandle = NULL;
+  phOsalUwb_SyncObj_t* pObj = NULL;
 
   /* Check input parameters */
   if (NULL != hBinSem) {
-    /* 1. Allocate memory for the wrapper struct */
-    pBinSemHandle = (phOsalUwb_sOsalSemaphore_t*)k_malloc(
-        sizeof(phOsalUwb_sOsalSemaphore_t));
+    /* 1. Take an entry from the object table */
+    pObj = phOsalUwb_SyncObjAlloc(kOsalUwb_SyncObj_BinSem,
+                                  __builtin_return_address(0));
 
-    if (pBinSemHandle == NULL) {
+    if (pObj == NULL) {
       wCreateStatus =
           PHUWBSTVAL(CID_UWB_OSAL, PH_OSALUWB_SEMAPHORE_CREATION_ERROR);
       return wCreateStatus;
@@ -137,17 +461,17 @@ UWBSTATUS phOsalUwb_CreateBinSem(void** hBinSem) {
      * FreeRTOS xSemaphoreCreateBinary() creates a semaphore that is "Empty" (0)
      * initially. Therefore, we set initial_count = 0, limit = 1.
      */
-    int ret = k_sem_init(&pBinSemHandle->ObjectHandle, 0, 1);
+    int ret = k_sem_init(&pObj->u.tSem.ObjectHandle, 0, 1);
 
     if (ret != 0) {
       /* Initialization failed */
       wCreateStatus =
           PHUWBSTVAL(CID_UWB_OSAL, PH_OSALUWB_SEMAPHORE_CREATION_ERROR);
-      k_free(pBinSemHandle);
+      phOsalUwb_SyncObjFree(pObj);
       *hBinSem = NULL;
     } else {
       /* Success */
-      *hBinSem = (void*)pBinSemHandle;
+      *hBinSem = (void*)&pObj->u.tSem;
     }
   } else {
     wCreateStatus = PHUWBSTVAL(CID_UWB_OSAL, UWBSTATUS_INVALID_PARAMETER);
@@ -239,19 +563,18 @@ UWBSTATUS phOsalUwb_ConsumeSemaphore_WithTimeout(void* hSemaphore,
 UWBSTATUS phOsalUwb_DeleteSemaphore(void** hSemaphore) {
   UWBSTATUS wDeletionStatus = UWBSTATUS_SUCCESS;
 
-  /* 檢查 hSemaphore 指標本身是否有效 */
-  if (hSemaphore != NULL && *hSemaphore != NULL) {
-    phOsalUwb_sOsalSemaphore_t* pSemaphoreHandle =
-        (phOsalUwb_sOsalSemaphore_t*)*hSemaphore;
+  /* 檢查 hSemaphore 指標本身是否有效，且確實是物件表中的 semaphore */
+  if (hSemaphore != NULL && *hSemaphore != NULL &&
+      phOsalUwb_SyncObjOf(*hSemaphore, false) != NULL) {
+    phOsalUwb_SyncObj_t* pObj = phOsalUwb_SyncObjOf(*hSemaphore, false);
 
     /*
      * Zephyr Porting Note:
      * Zephyr 沒有 k_sem_delete()。
-     * 對於動態分配的物件，直接釋放記憶體即可。
-     * (為了安全，可選用 k_sem_reset 重置狀態，但 k_free 已足夠)
+     * 先 k_sem_reset 喚醒仍在等待的 thread，再把物件放回 free list。
      */
-
-    k_free(pSemaphoreHandle);
+    k_sem_reset(&pObj->u.tSem.ObjectHandle);
+    phOsalUwb_SyncObjFree(pObj);
     *hSemaphore = NULL;
   } else {
     wDeletionStatus = PHUWBSTVAL(CID_UWB_OSAL, UWBSTATUS_INVALID_PARAMETER);
@@ -269,28 +592,28 @@ UWBSTATUS phOsalUwb_DeleteSemaphore(void** hSemaphore) {
 *******************************************************************************/
 UWBSTATUS phOsalUwb_CreateMutex(void** hMutex) {
   UWBSTATUS wCreateStatus = UWBSTATUS_SUCCESS;
-  phOsalUwb_sOsalMutex_t* pMutexHandle = NULL;
+  phOsalUwb_SyncObj_t* pObj = NULL;
 
   if (NULL != hMutex) {
-    /* 1. 動態分配 Wrapper 記憶體 */
-    pMutexHandle =
-        (phOsalUwb_sOsalMutex_t*)k_malloc(sizeof(phOsalUwb_sOsalMutex_t));
+    /* 1. 從物件表取出 Wrapper */
+    pObj = phOsalUwb_SyncObjAlloc(kOsalUwb_SyncObj_Mutex,
+                                  __builtin_return_address(0));
 
-    if (pMutexHandle == NULL) {
+    if (pObj == NULL) {
       wCreateStatus = PHUWBSTVAL(CID_UWB_OSAL, PH_OSALUWB_MUTEX_CREATION_ERROR);
       return wCreateStatus;
     }
 
     /* 2. 初始化 Zephyr Mutex  */
-    int ret = k_mutex_init(&pMutexHandle->ObjectHandle);
+    int ret = k_mutex_init(&pObj->u.tMutex.ObjectHandle);
 
     if (ret != 0) {
       wCreateStatus = PHUWBSTVAL(CID_UWB_OSAL, PH_OSALUWB_MUTEX_CREATION_ERROR);
-      k_free(pMutexHandle);
+      phOsalUwb_SyncObjFree(pObj);
       *hMutex = NULL;
     } else {
       /* 3. 回傳 Handle (指標轉型) */
-      *hMutex = (void*)pMutexHandle;
+      *hMutex = (void*)&pObj->u.tMutex;
     }
   } else {
     wCreateStatus = PHUWBSTVAL(CID_UWB_OSAL, UWBSTATUS_INVALID_PARAMETER);
@@ -382,15 +705,13 @@ UWBSTATUS phOsalUwb_UnlockMutex(void* hMutex) {
 UWBSTATUS phOsalUwb_DeleteMutex(void** hMutex) {
   UWBSTATUS wDeletionStatus = UWBSTATUS_SUCCESS;
 
-  if (hMutex != NULL && *hMutex != NULL) {
-    phOsalUwb_sOsalMutex_t* pMutexHandle = (phOsalUwb_sOsalMutex_t*)*hMutex;
-
+  if (hMutex != NULL && *hMutex != NULL &&
+      phOsalUwb_SyncObjOf(*hMutex, true) != NULL) {
     /* * Zephyr Porting Note:
      * k_mutex 不需要像 FreeRTOS 那樣呼叫 explicit delete 函式，
-     * 只要它沒被鎖定，直接釋放記憶體即可。
+     * 只要它沒被鎖定，直接放回 free list 即可。
      */
-
-    k_free(pMutexHandle);
+    phOsalUwb_SyncObjFree(phOsalUwb_SyncObjOf(*hMutex, true));
     *hMutex = NULL;
   } else {
     wDeletionStatus = PHUWBSTVAL(CID_UWB_OSAL, UWBSTATUS_INVALID_PARAMETER);
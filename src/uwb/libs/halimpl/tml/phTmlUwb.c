@@ -23,6 +23,7 @@
 #include "phNxpUciHal.h"
 #include "phNxpUciHal_utils.h"
 #include "phOsalUwb.h"
+#include "phOsalUwb_Internal.h"
 #include "phTmlUwb_transport.h"
 #include "phUwbTypes.h"
 #include "phUwb_BuildConfig.h"
@@ -45,10 +46,37 @@ K_THREAD_STACK_DEFINE(g_tml_reader_stack, TMLREADER_STACK_SIZE);
 /* 2. 定義執行緒控制結構 */
 struct k_thread g_tml_reader_thread;
 
+/* 3. 接收環形緩衝區 (Rx ring)
+ * SPI transport 直接把 UCI 封包讀進空閒的 slot，slot 以指標方式交給
+ * callback thread，待 phNxpUciHal_read_complete 處理完畢後才歸還。
+ */
+typedef struct phTmlUwb_RxSlot {
+  uint8_t abBuffer[UCI_MAX_DATA_LEN];
+  phTmlUwb_TransactInfo_t tTransactionInfo;
+  phLibUwb_DeferredCall_t tDeferredInfo;
+  uint32_t dwIrqCycles; /* UWBS IRQ 時間戳，用於量測 IRQ 到 callback 的延遲 */
+  volatile uint8_t bInUse;
+} phTmlUwb_RxSlot_t;
+
+static phTmlUwb_RxSlot_t g_tml_rx_ring[PH_TML_UWB_RX_RING_SLOTS];
+/* Ring 滿載時用來讀出並丟棄封包，避免 SR1xx 卡住 */
+static uint8_t g_tml_rx_drop_buf[UCI_MAX_DATA_LEN];
+/* 計數型 semaphore：目前可用的 slot 數量 */
+static struct k_sem g_tml_rx_slot_sem;
+static uint8_t g_tml_rx_next_slot;
+static atomic_t g_tml_rx_in_use;
+static phTmlUwb_RxRingStats_t g_tml_rx_stats;
+/* 只在 callback thread 更新 */
+static phTmlUwb_IrqLatencyStats_t g_tml_irq_lat;
+
 /* Local Function prototypes */
 static UWBSTATUS phTmlUwb_StartThread(void);
 static void phTmlUwb_CleanUp(void);
 static void phTmlUwb_ReadDeferredCb(void* pParams);
+static void phTmlUwb_InitRxRing(void);
+static phTmlUwb_RxSlot_t* phTmlUwb_AcquireRxSlot(void);
+static void phTmlUwb_ReleaseRxSlot(phTmlUwb_RxSlot_t* pSlot);
+static void phTmlUwb_UpdateIrqLatency(uint32_t dwIrqCycles);
 
 static OSAL_TASK_RETURN_TYPE phTmlUwb_TmlReaderThread(void* pParam);
 
@@ -128,6 +156,7 @@ UWBSTATUS phTmlUwb_Init(pphTmlUwb_Config_t pConfig) {
           wInitStatus = UWBSTATUS_FAILED;
         } else {
           phOsalUwb_ProduceSemaphore(gpphTmlUwb_Context->postMsgSemaphore);
+          phTmlUwb_InitRxRing();
           /* Start TML thread (to handle write and read operations) */
           if (UWBSTATUS_SUCCESS != phTmlUwb_StartThread()) {
             wInitStatus = PHUWBSTVAL(CID_UWB_TML, UWBSTATUS_FAILED);
@@ -224,56 +253,157 @@ static UWBSTATUS phTmlUwb_StartThread(void) {
   return wStartStatus;
 }
 
+/*******************************************************************************
+**
+** Function         phTmlUwb_InitRxRing
+**
+** Description      Marks every receive ring slot as free
+**
+** Parameters       None
+**
+** Returns          None
+**
+*******************************************************************************/
+static void phTmlUwb_InitRxRing(void) {
+  for (uint8_t i = 0; i < PH_TML_UWB_RX_RING_SLOTS; i++) {
+    g_tml_rx_ring[i].bInUse = FALSE;
+  }
+  g_tml_rx_next_slot = 0;
+  atomic_set(&g_tml_rx_in_use, 0);
+  k_sem_init(&g_tml_rx_slot_sem, PH_TML_UWB_RX_RING_SLOTS,
+             PH_TML_UWB_RX_RING_SLOTS);
+}
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_AcquireRxSlot
+**
+** Description      Takes the next free receive ring slot. Waits up to
+**                  PH_TML_UWB_RX_RING_FULL_WAIT ms when every slot is still
+**                  owned by the upper layer.
+**
+** Parameters       None
+**
+** Returns          Pointer to the slot, NULL if the ring stayed full
+**
+*******************************************************************************/
+static phTmlUwb_RxSlot_t* phTmlUwb_AcquireRxSlot(void) {
+  atomic_val_t inUse;
+
+  if (k_sem_take(&g_tml_rx_slot_sem, K_MSEC(PH_TML_UWB_RX_RING_FULL_WAIT)) !=
+      0) {
+    return NULL;
+  }
+  /* Only the Reader thread takes slots, release order does not matter */
+  for (uint8_t i = 0; i < PH_TML_UWB_RX_RING_SLOTS; i++) {
+    uint8_t idx =
+        (uint8_t)((g_tml_rx_next_slot + i) % PH_TML_UWB_RX_RING_SLOTS);
+    if (!g_tml_rx_ring[idx].bInUse) {
+      g_tml_rx_ring[idx].bInUse = TRUE;
+      g_tml_rx_next_slot = (uint8_t)((idx + 1) % PH_TML_UWB_RX_RING_SLOTS);
+      inUse = atomic_inc(&g_tml_rx_in_use) + 1;
+      if (inUse > g_tml_rx_stats.bMaxInUse) {
+        g_tml_rx_stats.bMaxInUse = (uint8_t)inUse;
+      }
+      return &g_tml_rx_ring[idx];
+    }
+  }
+  /* Semaphore and flags out of sync, should not happen */
+  k_sem_give(&g_tml_rx_slot_sem);
+  return NULL;
+}
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_ReleaseRxSlot
+**
+** Description      Gives a receive ring slot back to the Reader thread
+**
+** Parameters       pSlot - slot taken with phTmlUwb_AcquireRxSlot
+**
+** Returns          None
+**
+*******************************************************************************/
+static void phTmlUwb_ReleaseRxSlot(phTmlUwb_RxSlot_t* pSlot) {
+  if ((pSlot == NULL) || !pSlot->bInUse) {
+    return;
+  }
+  pSlot->bInUse = FALSE;
+  atomic_dec(&g_tml_rx_in_use);
+  k_sem_give(&g_tml_rx_slot_sem);
+}
+
 static OSAL_TASK_RETURN_TYPE phTmlUwb_TmlReaderThread(void* pParam) {
   UWBSTATUS wStatus = UWBSTATUS_SUCCESS;
   int32_t dwNoBytesWrRd = PH_TMLUWB_RESET_VALUE;
-  static uint8_t temp[UCI_MAX_DATA_LEN];
-  static uint8_t* temp_payload = &temp[4];
+  phTmlUwb_RxSlot_t* pSlot;
+  uint8_t* pRxBuffer;
+  uint32_t dwIrqCycles;
+  struct k_sem* pRxSem;
+  void* pIrqSemHandle;
+  struct k_poll_event tEvents[2];
+  int nEvents;
   // Fira Test mode is enabled
   static uint8_t chain_packet_counter = 0;
   uint8_t pbf;
-  /* Transaction info 2060 to be passed to Callback Thread */
-  static phTmlUwb_TransactInfo_t tTransactionInfo;
-  /* Structure containing Tml callback function and parameters to be invoked
-   by the callback thread */
-  static phLibUwb_DeferredCall_t tDeferredInfo;
   /* Initialize Message structure to post message onto Callback Thread */
-  static phLibUwb_Message_t tMsg;
+  phLibUwb_Message_t tMsg;
   PHUWB_UNUSED(pParam);
   NXPLOG_UWB_TML_D("Tml Reader Thread Started...");
   /* Writer thread loop shall be running till shutdown is invoked */
   while (gpphTmlUwb_Context->bThreadDone) {
-    /* If Tml write is requested */
     /* Set the variable to success initially */
     wStatus = UWBSTATUS_SUCCESS;
-    /* Reader is always enabled by upper layer wait for 100 ms */
-    if (phOsalUwb_ConsumeSemaphore_WithTimeout(gpphTmlUwb_Context->rxSemaphore,
-                                               PH_TML_UWB_MAX_READER_WAIT) !=
-        UWBSTATUS_SUCCESS) {
-      NXPLOG_UWB_TML_D("Tml Reader Thread : Fail to acquire rx semaphore");
+    /* Sleep until the upper layer changes the read request (read, abort or
+     * shutdown) or, while a read is enabled, until the UWBS raises its IRQ.
+     * The IRQ semaphore is only peeked here, the transport consumes it. */
+    pRxSem = &((phOsalUwb_sOsalSemaphore_t*)gpphTmlUwb_Context->rxSemaphore)
+                  ->ObjectHandle;
+    k_poll_event_init(&tEvents[0], K_POLL_TYPE_SEM_AVAILABLE,
+                      K_POLL_MODE_NOTIFY_ONLY, pRxSem);
+    nEvents = 1;
+    pIrqSemHandle = phTmlUwb_helios_irq_semaphore();
+    if ((1 == gpphTmlUwb_Context->tReadInfo.bEnable) &&
+        (pIrqSemHandle != NULL)) {
+      k_poll_event_init(
+          &tEvents[1], K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY,
+          &((phOsalUwb_sOsalSemaphore_t*)pIrqSemHandle)->ObjectHandle);
+      nEvents = 2;
+    }
+    (void)k_poll(tEvents, nEvents, K_FOREVER);
+    if (tEvents[0].state == K_POLL_STATE_SEM_AVAILABLE) {
+      /* Read request changed, re-evaluate bThreadDone and bEnable */
+      (void)k_sem_take(pRxSem, K_NO_WAIT);
       continue;
     }
+    dwIrqCycles = phTmlUwb_helios_irq_cycles();
     /* If Tml read is requested */
     if (1 == gpphTmlUwb_Context->tReadInfo.bEnable) {
       NXPLOG_UWB_TML_D("Read requested...");
-      /* Set the variable to success initially */
-      wStatus = UWBSTATUS_SUCCESS;
 
       /* Variable to fetch the actual number of bytes read */
       dwNoBytesWrRd = PH_TMLUWB_RESET_VALUE;
 
       /* Read the data from the file onto the buffer */
       if (NULL != gpphTmlUwb_Context->pDevHandle) {
+        /* Ring full: still drain the UWBS, the packet is dropped */
+        pSlot = phTmlUwb_AcquireRxSlot();
+        pRxBuffer = (pSlot != NULL) ? pSlot->abBuffer : g_tml_rx_drop_buf;
+        if (pSlot != NULL) {
+          pSlot->dwIrqCycles = dwIrqCycles;
+        }
+
         NXPLOG_UWB_TML_D("Invoking Read...");
-        dwNoBytesWrRd = phTmlUwb_uci_read(temp_payload, UCI_MAX_DATA_LEN);
+        dwNoBytesWrRd = phTmlUwb_uci_read(pRxBuffer, UCI_MAX_DATA_LEN);
 
         if (gpphTmlUwb_Context->bThreadDone == 0) {
+          phTmlUwb_ReleaseRxSlot(pSlot);
           break;
         }
 
         if (dwNoBytesWrRd > UCI_MAX_DATA_LEN) {
           NXPLOG_UWB_TML_E("Number of bytes read exceeds the limit ...");
-          phOsalUwb_ProduceSemaphore(gpphTmlUwb_Context->rxSemaphore);
+          phTmlUwb_ReleaseRxSlot(pSlot);
         } else if (0 == dwNoBytesWrRd) {
 #if UWBIOT_TML_S32UART || UWBIOT_TML_PNP || UWBIOT_TML_SOCKET
           /* Dont' warn */
@@ -281,113 +411,95 @@ static OSAL_TASK_RETURN_TYPE phTmlUwb_TmlReaderThread(void* pParam) {
           NXPLOG_UWB_TML_D(
               "Empty packet Read, Ignore read and try new read...");
 #endif
-          phOsalUwb_ProduceSemaphore(gpphTmlUwb_Context->rxSemaphore);
+          phTmlUwb_ReleaseRxSlot(pSlot);
+        } else if (pSlot == NULL) {
+          g_tml_rx_stats.dwRingFullDrops++;
+          NXPLOG_UWB_TML_W("Rx ring full, packet dropped");
+          LOG_RX("DROP ", pRxBuffer, (uint16_t)MIN(dwNoBytesWrRd, 20));
         } else {
           // Fira Test mode is enabled
           if (nxpucihal_ctrl.operationMode == kOPERATION_MODE_mctt) {
             // print whole log
-            LOG_RX("RECV ", temp_payload, (uint16_t)dwNoBytesWrRd);
-            if (UCI_MT_RSP ==
-                ((temp_payload[0] & UCI_MT_MASK) >> UCI_MT_SHIFT)) {
+            LOG_RX("RECV ", pRxBuffer, (uint16_t)dwNoBytesWrRd);
+            if (UCI_MT_RSP == ((pRxBuffer[0] & UCI_MT_MASK) >> UCI_MT_SHIFT)) {
               // Response packet received
-              pbf = (temp_payload[0] & UCI_PBF_MASK) >> UCI_PBF_SHIFT;
+              pbf = (pRxBuffer[0] & UCI_PBF_MASK) >> UCI_PBF_SHIFT;
               if ((pbf == TRUE) && (chain_packet_counter == 0)) {
-                // Chained packet start. Copy to pBuffer and continue normal
-                // flow
-                phOsalUwb_MemCopy(gpphTmlUwb_Context->tReadInfo.pBuffer,
-                                  temp_payload, (uint32_t)dwNoBytesWrRd);
+                // Chained packet start. Continue normal flow
                 chain_packet_counter++;
-              } else if (chain_packet_counter > 0) {
-                if (gpphTmlUwb_Context->appDataCallback != NULL) {
-                  // Chained packet continue. Send to appDataCallback
-                  gpphTmlUwb_Context->appDataCallback(
-                      temp_payload, (uint16_t)(dwNoBytesWrRd));
-                  // End of chained packet?
-                  if (pbf == TRUE) {
-                    chain_packet_counter++;
-                  } else {
-                    chain_packet_counter = 0;  // last packet
-                  }
-                  // Produce semaphore as data has already been sent to
-                  // appDataCallback
-                  phOsalUwb_ProduceSemaphore(gpphTmlUwb_Context->rxSemaphore);
-                  continue;
+              } else if ((chain_packet_counter > 0) &&
+                         (gpphTmlUwb_Context->appDataCallback != NULL)) {
+                // Chained packet continue. Send to appDataCallback
+                gpphTmlUwb_Context->appDataCallback(pRxBuffer,
+                                                    (uint16_t)(dwNoBytesWrRd));
+                // End of chained packet?
+                if (pbf == TRUE) {
+                  chain_packet_counter++;
                 } else {
-                  // appDataCallback not registered. Continue normal flow
-                  phOsalUwb_MemCopy(gpphTmlUwb_Context->tReadInfo.pBuffer,
-                                    temp_payload, (uint32_t)dwNoBytesWrRd);
+                  chain_packet_counter = 0;  // last packet
                 }
-              } else if ((pbf == FALSE) && (chain_packet_counter == 0)) {
-                // Normal packet. Continue normal flow
-                phOsalUwb_MemCopy(gpphTmlUwb_Context->tReadInfo.pBuffer,
-                                  temp_payload, (uint32_t)dwNoBytesWrRd);
-              }
-            } else {
-              // NTF packet received
-              if (gpphTmlUwb_Context->appDataCallback != NULL) {
-                // Send to appDataCallback
-                gpphTmlUwb_Context->appDataCallback(temp_payload,
-                                                    (uint16_t)(dwNoBytesWrRd));
-                phOsalUwb_ProduceSemaphore(gpphTmlUwb_Context->rxSemaphore);
+                // Data has already been sent to appDataCallback
+                phTmlUwb_ReleaseRxSlot(pSlot);
                 continue;
-              } else {
-                // appDataCallback not registered. Continue normal flow
-                phOsalUwb_MemCopy(gpphTmlUwb_Context->tReadInfo.pBuffer,
-                                  temp_payload, (uint32_t)dwNoBytesWrRd);
               }
+            } else if (gpphTmlUwb_Context->appDataCallback != NULL) {
+              // NTF packet received. Send to appDataCallback
+              gpphTmlUwb_Context->appDataCallback(pRxBuffer,
+                                                  (uint16_t)(dwNoBytesWrRd));
+              phTmlUwb_ReleaseRxSlot(pSlot);
+              continue;
             }
-          } else {
-            phOsalUwb_MemCopy(gpphTmlUwb_Context->tReadInfo.pBuffer,
-                              temp_payload, (uint32_t)dwNoBytesWrRd);
           }
           NXPLOG_UWB_TML_D("Read successful...");
-          /* This has to be reset only after a successful read */
-          gpphTmlUwb_Context->tReadInfo.bEnable = 0;
 
           /* Update the actual number of bytes read including header */
           gpphTmlUwb_Context->tReadInfo.wLength = (uint16_t)(dwNoBytesWrRd);
 
           dwNoBytesWrRd = PH_TMLUWB_RESET_VALUE;
 
-          /* Fill the Transaction info structure to be passed to Callback
-           * Function */
-          tTransactionInfo.wStatus = wStatus;
-          tTransactionInfo.pBuff = gpphTmlUwb_Context->tReadInfo.pBuffer;
+          /* Fill the Transaction info structure of the slot, the slot itself
+           * is passed to the Callback Function */
+          pSlot->tTransactionInfo.wStatus = wStatus;
+          pSlot->tTransactionInfo.pBuff = pSlot->abBuffer;
           /* Actual number of bytes read is filled in the structure */
-          tTransactionInfo.wLength = gpphTmlUwb_Context->tReadInfo.wLength;
+          pSlot->tTransactionInfo.wLength =
+              gpphTmlUwb_Context->tReadInfo.wLength;
 
           /* Read operation completed successfully. Post a Message onto Callback
            * Thread*/
           /* Prepare the message to be posted on User thread */
-          tDeferredInfo.pCallback = &phTmlUwb_ReadDeferredCb;
-          tDeferredInfo.pParameter = &tTransactionInfo;
+          pSlot->tDeferredInfo.pCallback = &phTmlUwb_ReadDeferredCb;
+          pSlot->tDeferredInfo.pParameter = &pSlot->tTransactionInfo;
           tMsg.eMsgType = PH_LIBUWB_DEFERREDCALL_MSG;
-          tMsg.pMsgData = &tDeferredInfo;
-          tMsg.Size = sizeof(tDeferredInfo);
+          tMsg.pMsgData = &pSlot->tDeferredInfo;
+          tMsg.Size = sizeof(pSlot->tDeferredInfo);
 #if UWBIOT_UWBD_SR040
-          phTmlUwb_PrintRecevedMessage(temp_payload,
+          phTmlUwb_PrintRecevedMessage(pRxBuffer,
                                        gpphTmlUwb_Context->tReadInfo.wLength);
 #else
           if (nxpucihal_ctrl.operationMode != kOPERATION_MODE_mctt) {
             if (gpphTmlUwb_Context->tReadInfo.wLength > 200) {
-              LOG_RX("RECV ", temp_payload, 20);
+              LOG_RX("RECV ", pRxBuffer, 20);
             } else {
-              LOG_RX("RECV ", temp_payload,
-                     gpphTmlUwb_Context->tReadInfo.wLength);
+              LOG_RX("RECV ", pRxBuffer, gpphTmlUwb_Context->tReadInfo.wLength);
             }
           }
 #endif
           NXPLOG_UWB_TML_D("Posting read message...");
-          phTmlUwb_DeferredCall(gpphTmlUwb_Context->dwCallbackThreadId, &tMsg);
+          if (phTmlUwb_DeferredCall(gpphTmlUwb_Context->dwCallbackThreadId,
+                                    &tMsg) != UWBSTATUS_SUCCESS) {
+            g_tml_rx_stats.dwPostFailures++;
+            phTmlUwb_ReleaseRxSlot(pSlot);
+          } else {
+            g_tml_rx_stats.dwDelivered++;
+          }
         }
       } else {
         NXPLOG_UWB_TML_D("SR100 -gpphTmlUwb_Context->pDevHandle is NULL");
       }
     } else {
       NXPLOG_UWB_TML_D("read request NOT enabled");
-      phOsalUwb_Delay(10);
     }
-    k_usleep(100);
   } /* End of While loop */
 
   /* Suspend task here so that it does not return in FreeRTOS
@@ -564,13 +676,14 @@ UWBSTATUS phTmlUwb_Write(uint8_t* p_data, uint16_t data_len) {
 ** Function         phTmlUwb_Read
 **
 ** Description      Asynchronously reads data from the driver
-**                  Number of bytes to be read and buffer are passed by upper
-**                  layer.
 **                  Enables reader thread if there are no read requests pending
-**                  Returns successfully once read operation is completed
+**                  The reader then stays enabled and delivers every packet
+**                  through the callback, in a receive ring slot that is
+**                  released when the callback returns. Calling it again with
+**                  the same callback while enabled is a no-op.
 **                  Notifies upper layer using callback mechanism
 **
-** Parameters       pBuffer - location to send read data to the upper layer via
+** Parameters       pBuffer - unused, data is delivered in pInfo->pBuff of the
 **                            callback
 **                  wLength - length of read data buffer passed by upper layer
 **                  pTmlReadComplete - pointer to the function to be invoked
@@ -591,7 +704,7 @@ UWBSTATUS phTmlUwb_Read(uint8_t* pBuffer, uint16_t wLength,
 
   /* Check whether TML is Initialized */
   if (NULL != gpphTmlUwb_Context) {
-    if ((gpphTmlUwb_Context->pDevHandle != NULL) && (NULL != pBuffer) &&
+    if ((gpphTmlUwb_Context->pDevHandle != NULL) &&
         (PH_TMLUWB_RESET_VALUE != wLength) && (NULL != pTmlReadComplete)) {
       if (!gpphTmlUwb_Context->tReadInfo.bThreadBusy) {
         /* Setting the flag marks beginning of a Read Operation */
@@ -610,6 +723,12 @@ UWBSTATUS phTmlUwb_Read(uint8_t* pBuffer, uint16_t wLength,
         phOsalUwb_ProduceSemaphore(
             gpphTmlUwb_Context->rxSemaphore);  // To be enabled later
         // NXPLOG_UWB_TML_I("UWB context not null phTmlUwb_Read \n ");
+      } else if ((1 == gpphTmlUwb_Context->tReadInfo.bEnable) &&
+                 (gpphTmlUwb_Context->tReadInfo.pThread_Callback ==
+                  pTmlReadComplete)) {
+        /* Reader is already listening for this caller */
+        gpphTmlUwb_Context->tReadInfo.pContext = pContext;
+        wReadStatus = UWBSTATUS_PENDING;
       } else {
         wReadStatus = PHUWBSTVAL(CID_UWB_TML, UWBSTATUS_BUSY);
       }
@@ -640,6 +759,8 @@ void phTmlUwb_ReadAbort(void) {
 
   /*Reset the flag to accept another Read Request */
   gpphTmlUwb_Context->tReadInfo.bThreadBusy = FALSE;
+  /* Let the Reader thread stop waiting for the UWBS IRQ */
+  phOsalUwb_ProduceSemaphore(gpphTmlUwb_Context->rxSemaphore);
 }
 /*******************************************************************************
 **
@@ -651,11 +772,13 @@ void phTmlUwb_ReadAbort(void) {
 ** Parameters       dwThreadId  - id of the thread posting message
 **                  ptWorkerMsg - message to be posted
 **
-** Returns          None
+** Returns          UWBSTATUS_SUCCESS - message posted
+**                  UWBSTATUS_FAILED - message could not be posted
 **
 *******************************************************************************/
-void phTmlUwb_DeferredCall(uintptr_t dwThreadId,
-                           phLibUwb_Message_t* ptWorkerMsg) {
+UWBSTATUS phTmlUwb_DeferredCall(uintptr_t dwThreadId,
+                                phLibUwb_Message_t* ptWorkerMsg) {
+  UWBSTATUS wStatus;
   PHUWB_UNUSED(dwThreadId);
   /* Post message on the user thread to invoke the callback function */
   if (phOsalUwb_ConsumeSemaphore_WithTimeout(
@@ -663,11 +786,15 @@ void phTmlUwb_DeferredCall(uintptr_t dwThreadId,
           PH_TML_UWB_MAX_MESSAGE_POST_WAIT) != UWBSTATUS_SUCCESS) {
     NXPLOG_UWB_TML_E("phTmlUwb_DeferredCall: consume semaphore error");
     (void)phOsalUwb_ProduceSemaphore(gpphTmlUwb_Context->postMsgSemaphore);
-    return;
+    return UWBSTATUS_FAILED;
   }
-  (void)phOsalUwb_msgsnd(gpphTmlUwb_Context->dwCallbackThreadId, ptWorkerMsg,
-                         NO_DELAY);
+  wStatus = phOsalUwb_msgsnd(gpphTmlUwb_Context->dwCallbackThreadId,
+                             ptWorkerMsg, NO_DELAY);
   (void)phOsalUwb_ProduceSemaphore(gpphTmlUwb_Context->postMsgSemaphore);
+  if (wStatus != UWBSTATUS_SUCCESS) {
+    NXPLOG_UWB_TML_E("phTmlUwb_DeferredCall: message queue full");
+  }
+  return wStatus;
 }
 
 /*******************************************************************************
@@ -684,15 +811,107 @@ void phTmlUwb_DeferredCall(uintptr_t dwThreadId,
 static void phTmlUwb_ReadDeferredCb(void* pParams) {
   /* Transaction info buffer to be passed to Callback Function */
   phTmlUwb_TransactInfo_t* pTransactionInfo = (phTmlUwb_TransactInfo_t*)pParams;
+  phTmlUwb_RxSlot_t* pSlot =
+      CONTAINER_OF(pTransactionInfo, phTmlUwb_RxSlot_t, tTransactionInfo);
 
-  /* Reset the flag to accept another Read Request */
-  gpphTmlUwb_Context->tReadInfo.bThreadBusy = FALSE;
-  gpphTmlUwb_Context->tReadInfo.pThread_Callback(
-      gpphTmlUwb_Context->tReadInfo.pContext, pTransactionInfo);
+  phTmlUwb_UpdateIrqLatency(pSlot->dwIrqCycles);
+  if (gpphTmlUwb_Context->tReadInfo.pThread_Callback != NULL) {
+    gpphTmlUwb_Context->tReadInfo.pThread_Callback(
+        gpphTmlUwb_Context->tReadInfo.pContext, pTransactionInfo);
+  }
+  /* Upper layer is done with the packet, hand the slot back to the reader */
+  phTmlUwb_ReleaseRxSlot(pSlot);
 
   return;
 }
 
+/*******************************************************************************
+**
+** Function         phTmlUwb_UpdateIrqLatency
+**
+** Description      Accounts the time from the UWBS IRQ of a packet to its
+**                  read completion callback
+**
+** Parameters       dwIrqCycles - phOsalUwb_GetCycles() stamp taken by the
+**                                UWBS IRQ
+**
+** Returns          None
+**
+*******************************************************************************/
+static void phTmlUwb_UpdateIrqLatency(uint32_t dwIrqCycles) {
+  phOsalUwb_LatencyStatsAdd(&g_tml_irq_lat,
+                            phOsalUwb_CyclesElapsedUs(dwIrqCycles));
+}
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_GetIrqLatencyStats
+**
+** Description      Returns the IRQ-to-callback latency of received packets
+**
+** Parameters       pStats - filled with the current counters
+**
+** Returns          None
+**
+*******************************************************************************/
+void phTmlUwb_GetIrqLatencyStats(phTmlUwb_IrqLatencyStats_t* pStats) {
+  if (pStats == NULL) {
+    return;
+  }
+  *pStats = g_tml_irq_lat;
+}
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_ResetIrqLatencyStats
+**
+** Description      Clears the IRQ-to-callback latency counters
+**
+** Parameters       None
+**
+** Returns          None
+**
+*******************************************************************************/
+void phTmlUwb_ResetIrqLatencyStats(void) {
+  phOsalUwb_LatencyStatsReset(&g_tml_irq_lat);
+}
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_GetRxRingStats
+**
+** Description      Returns the receive ring counters of the Reader thread
+**
+** Parameters       pStats - filled with the current counters
+**
+** Returns          None
+**
+*******************************************************************************/
+void phTmlUwb_GetRxRingStats(phTmlUwb_RxRingStats_t* pStats) {
+  if (pStats == NULL) {
+    return;
+  }
+  *pStats = g_tml_rx_stats;
+  pStats->bSlots = PH_TML_UWB_RX_RING_SLOTS;
+  pStats->bInUse = (uint8_t)atomic_get(&g_tml_rx_in_use);
+}
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_ResetRxRingStats
+**
+** Description      Clears the receive ring counters of the Reader thread
+**
+** Parameters       None
+**
+** Returns          None
+**
+*******************************************************************************/
+void phTmlUwb_ResetRxRingStats(void) {
+  phOsalUwb_SetMemory(&g_tml_rx_stats, 0, sizeof(g_tml_rx_stats));
+  g_tml_rx_stats.bMaxInUse = (uint8_t)atomic_get(&g_tml_rx_in_use);
+}
+
 #if UWBIOT_UWBD_SR2XXT
 /*******************************************************************************
 **
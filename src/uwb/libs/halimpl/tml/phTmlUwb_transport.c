@@ -388,6 +388,90 @@ UWBSTATUS phTmlUwb_hbci_transcive_with_len(uint8_t* pWriteBuf,
   return status;
 }
 #endif
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_hbci_write_start
+**
+** Description      Starts writing an HBCI data segment and its tail (LRC)
+**                  for the pipelined FW download
+**
+** Parameters       pData        - data to write
+**                  dataLen      - number of data bytes
+**                  pTail        - bytes written right after pData
+**                  tailLen      - number of tail bytes
+**
+** Returns          UWB status:
+**                  UWBSTATUS_SUCCESS - write started
+**                  UWBSTATUS_FAILED - write could not be started
+**
+*******************************************************************************/
+UWBSTATUS phTmlUwb_hbci_write_start(const uint8_t* pData, size_t dataLen,
+                                    uint8_t* pTail, size_t tailLen) {
+  UWBSTATUS status = UWBSTATUS_FAILED;
+  if (uwb_uwbs_tml_hbci_tx_start(&gUwbsTmlCtx, pData, dataLen, pTail,
+                                 tailLen) == kUWBSTATUS_SUCCESS) {
+    status = UWBSTATUS_SUCCESS;
+  }
+  return status;
+}
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_hbci_write_wait
+**
+** Description      Waits for the write started by phTmlUwb_hbci_write_start
+**
+** Returns          UWB status:
+**                  UWBSTATUS_SUCCESS - data written
+**                  UWBSTATUS_FAILED - write failed
+**
+*******************************************************************************/
+UWBSTATUS phTmlUwb_hbci_write_wait(void) {
+  UWBSTATUS status = UWBSTATUS_FAILED;
+  if (uwb_uwbs_tml_hbci_tx_wait(&gUwbsTmlCtx) == kUWBSTATUS_SUCCESS) {
+    status = UWBSTATUS_SUCCESS;
+  }
+  return status;
+}
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_hbci_read
+**
+** Description      Reads one HBCI response frame
+**
+** Parameters       pRespBuf     - response buffer
+**                  pRspBufLen   - response bufferLen
+**
+** Returns          UWB status:
+**                  UWBSTATUS_SUCCESS - frame read
+**                  UWBSTATUS_FAILED - read failed
+**
+*******************************************************************************/
+UWBSTATUS phTmlUwb_hbci_read(uint8_t* pRespBuf, size_t* pRspBufLen) {
+  UWBSTATUS status = UWBSTATUS_FAILED;
+  if (uwb_uwbs_tml_hbci_rx(&gUwbsTmlCtx, pRespBuf, pRspBufLen) ==
+      kUWBSTATUS_SUCCESS) {
+    status = UWBSTATUS_SUCCESS;
+  }
+  return status;
+}
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_hbci_dma_readable
+**
+** Description      Checks whether the bus can transmit a buffer in place
+**
+** Parameters       pBuf         - buffer to check
+**
+** Returns          TRUE if no RAM staging is needed
+**
+*******************************************************************************/
+bool phTmlUwb_hbci_dma_readable(const void* pBuf) {
+  return uwb_bus_dma_readable(pBuf);
+}
 #endif  // UWBIOT_UWBD_SR1XXT
 
 #if UWBIOT_UWBD_SR2XXT
@@ -669,6 +753,30 @@ void phTmlUwb_helios_irq_enable() {
   }
 }
 
+/*******************************************************************************
+**
+** Function         phTmlUwb_helios_irq_semaphore
+**
+** Description      get the semaphore released on every uwbs irq
+**
+** Returns          OSAL semaphore handle, NULL if the bus is not initialized
+**
+*******************************************************************************/
+void* phTmlUwb_helios_irq_semaphore(void) {
+  return gUwbsTmlCtx.busCtx.mIrqWaitSem;
+}
+
+/*******************************************************************************
+**
+** Function         phTmlUwb_helios_irq_cycles
+**
+** Description      get the phOsalUwb_GetCycles() stamp of the last uwbs irq
+**
+*******************************************************************************/
+uint32_t phTmlUwb_helios_irq_cycles(void) {
+  return gUwbsTmlCtx.busCtx.mIrqCycles;
+}
+
 /*******************************************************************************
 **
 ** Function         phTmlUwb_helios_interupt_status
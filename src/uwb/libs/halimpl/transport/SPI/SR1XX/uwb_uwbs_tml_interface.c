@@ -48,6 +48,101 @@
 
 #define MAX_RETRY_COUNT 0x02
 
+#ifndef CONFIG_UWB_TML_TX_GUARD_US
+#define CONFIG_UWB_TML_TX_GUARD_US 500
+#endif
+
+#ifndef CONFIG_UWB_TML_TX_READY_TIMEOUT_MS
+#define CONFIG_UWB_TML_TX_READY_TIMEOUT_MS 10
+#endif
+
+/* UCI TX latency counters, kept outside of the tml context so that they
+ * survive UwbApi_Init / UwbApi_ShutDown cycles. Updated by the writer and
+ * read or cleared from the shell, always under gTmlTxStatsLock. */
+static uwb_uwbs_tml_tx_stats_t gTmlTxStats = {.minLatencyUs = UINT32_MAX};
+static struct k_spinlock gTmlTxStatsLock;
+
+static void uwb_uwbs_tml_mark_xfer_end(uwb_uwbs_tml_ctx_t* pCtx) {
+  pCtx->lastXferCycles = phOsalUwb_GetCycles();
+  pCtx->lastXferValid = true;
+}
+
+/* Replaces the fixed 2 ms pre-write spin: only the part of the recovery
+ * guard that has not yet elapsed since the last bus transfer is slept, and
+ * the write is then gated on the UWBS releasing its IRQ line. */
+static uwb_bus_status_t uwb_uwbs_tml_wait_tx_ready(uwb_uwbs_tml_ctx_t* pCtx) {
+  uint32_t start = phOsalUwb_GetCycles();
+  uint32_t elapsedUs;
+  uint32_t guardUs;
+  uint32_t waitUs;
+  uwb_bus_status_t bus_status;
+  k_spinlock_key_t key;
+
+  /* The cycle stamp wraps after ~67 s; a wrapped stamp at worst costs one
+   * extra guard sleep. */
+  if (pCtx->lastXferValid) {
+    elapsedUs = phOsalUwb_CyclesElapsedUs(pCtx->lastXferCycles);
+    if (elapsedUs < CONFIG_UWB_TML_TX_GUARD_US) {
+      k_usleep((int32_t)(CONFIG_UWB_TML_TX_GUARD_US - elapsedUs));
+    }
+  }
+  guardUs = phOsalUwb_CyclesElapsedUs(start);
+
+  start = phOsalUwb_GetCycles();
+  bus_status =
+      uwb_bus_io_ready_wait(&pCtx->busCtx, CONFIG_UWB_TML_TX_READY_TIMEOUT_MS);
+  waitUs = phOsalUwb_CyclesElapsedUs(start);
+
+  key = k_spin_lock(&gTmlTxStatsLock);
+  gTmlTxStats.guardWaitUs += guardUs;
+  gTmlTxStats.readyWaitUs += waitUs;
+  if (waitUs > gTmlTxStats.maxReadyWaitUs) {
+    gTmlTxStats.maxReadyWaitUs = waitUs;
+  }
+  if (bus_status != kUWB_bus_Status_OK) {
+    gTmlTxStats.readyTimeouts++;
+  }
+  k_spin_unlock(&gTmlTxStatsLock, key);
+  return bus_status;
+}
+
+static void uwb_uwbs_tml_update_tx_stats(uint32_t startCycles, bool success) {
+  uint32_t latencyUs = phOsalUwb_CyclesElapsedUs(startCycles);
+  k_spinlock_key_t key = k_spin_lock(&gTmlTxStatsLock);
+
+  if (!success) {
+    gTmlTxStats.failures++;
+    k_spin_unlock(&gTmlTxStatsLock, key);
+    return;
+  }
+  gTmlTxStats.commands++;
+  gTmlTxStats.totalLatencyUs += latencyUs;
+  if (latencyUs < gTmlTxStats.minLatencyUs) {
+    gTmlTxStats.minLatencyUs = latencyUs;
+  }
+  if (latencyUs > gTmlTxStats.maxLatencyUs) {
+    gTmlTxStats.maxLatencyUs = latencyUs;
+  }
+  k_spin_unlock(&gTmlTxStatsLock, key);
+}
+
+void uwb_uwbs_tml_get_tx_stats(uwb_uwbs_tml_tx_stats_t* pStats) {
+  if (pStats != NULL) {
+    k_spinlock_key_t key = k_spin_lock(&gTmlTxStatsLock);
+
+    phOsalUwb_MemCopy(pStats, &gTmlTxStats, sizeof(gTmlTxStats));
+    k_spin_unlock(&gTmlTxStatsLock, key);
+  }
+}
+
+void uwb_uwbs_tml_reset_tx_stats(void) {
+  k_spinlock_key_t key = k_spin_lock(&gTmlTxStatsLock);
+
+  phOsalUwb_SetMemory(&gTmlTxStats, 0, sizeof(gTmlTxStats));
+  gTmlTxStats.minLatencyUs = UINT32_MAX;
+  k_spin_unlock(&gTmlTxStatsLock, key);
+}
+
 UWBStatus_t uwb_uwbs_tml_init(uwb_uwbs_tml_ctx_t* pCtx) {
   UWBStatus_t status;
   uwb_bus_status_t bus_status;
@@ -118,19 +213,63 @@ uwb_bus_status_t uwb_bus_data_tx(uwb_bus_board_ctx_t* pCtx, uint8_t* pBuf,
 
   struct spi_buf_set tx = {.buffers = &tx_b, .count = 1};
 
-  /* 3. 執行同步傳輸 (Blocking)
-   * 這一行執行完畢時，資料已經透過 DMA 發送完成。
-   * 不需要 Semaphore，不需要 Loop。
+  /* 3. 執行傳輸
+   * 同步或非同步 (DMA + Callback) 由 CONFIG_UWB_TML_SPI_SYNC/ASYNC 決定，
+   * 返回時資料都已經發送完成。
    */
   LOG_TX("SPI TX", pBuf, bufLen);
-  int ret = spi_write_dt(&pCtx->spi, &tx);
+  return uwb_bus_spi_transceive(pCtx, &tx, NULL);
+}
+
+uwb_bus_status_t uwb_bus_data_tx_sg(uwb_bus_board_ctx_t* pCtx, uint8_t* pHdr,
+                                    size_t hdrLen, uint8_t* pPayload,
+                                    size_t payloadLen) {
+  if (pCtx == NULL) {
+    LOG_ERR("uwbs bus context is NULL");
+    return kUWB_bus_Status_FAILED;
+  }
 
-  if (ret < 0) {
-    LOG_ERR("SPI TX failed: %d", ret);
+  if (pHdr == NULL || hdrLen == 0 || (pPayload == NULL && payloadLen != 0)) {
     return kUWB_bus_Status_FAILED;
   }
 
-  return kUWB_bus_Status_OK;
+  /* Header 與 Payload 在同一次 CS 週期內送出 (Scatter-Gather) */
+  struct spi_buf tx_b[2] = {
+      {.buf = pHdr, .len = hdrLen},
+      {.buf = pPayload, .len = payloadLen},
+  };
+
+  struct spi_buf_set tx = {.buffers = tx_b, .count = (payloadLen != 0) ? 2 : 1};
+
+  LOG_TX("SPI TX Header", pHdr, hdrLen);
+  if (payloadLen != 0) {
+    LOG_TX("SPI TX Payload", pPayload, payloadLen);
+  }
+  return uwb_bus_spi_transceive(pCtx, &tx, NULL);
+}
+
+uwb_bus_status_t uwb_bus_data_tx_sg_start(uwb_bus_board_ctx_t* pCtx,
+                                          uint8_t* pHdr, size_t hdrLen,
+                                          uint8_t* pPayload,
+                                          size_t payloadLen) {
+  if (pCtx == NULL) {
+    LOG_ERR("uwbs bus context is NULL");
+    return kUWB_bus_Status_FAILED;
+  }
+
+  if (pHdr == NULL || hdrLen == 0 || (pPayload == NULL && payloadLen != 0)) {
+    return kUWB_bus_Status_FAILED;
+  }
+
+  /* 非同步傳輸期間 Driver 仍會讀取 Buffer 描述，所以放在 context 內 */
+  pCtx->mTxBufs[0].buf = pHdr;
+  pCtx->mTxBufs[0].len = hdrLen;
+  pCtx->mTxBufs[1].buf = pPayload;
+  pCtx->mTxBufs[1].len = payloadLen;
+  pCtx->mTxSet.buffers = pCtx->mTxBufs;
+  pCtx->mTxSet.count = (payloadLen != 0) ? 2 : 1;
+
+  return uwb_bus_spi_transceive_start(pCtx, &pCtx->mTxSet, NULL);
 }
 
 uwb_bus_status_t uwb_bus_data_rx(uwb_bus_board_ctx_t* pCtx, uint8_t* pBuf,
@@ -154,24 +293,19 @@ uwb_bus_status_t uwb_bus_data_rx(uwb_bus_board_ctx_t* pCtx, uint8_t* pBuf,
 
   struct spi_buf_set rx = {.buffers = &rx_b, .count = 1};
 
-  /* 3. 執行同步讀取 (Blocking Read)
-   * 這一行執行完畢時，資料已經填入 pBuf 中。
-   * 不需要 Semaphore，也不需要手動處理 DMA 分塊。
+  /* 3. 執行讀取
+   * 返回時資料已經填入 pBuf 中。非同步模式下，讀取期間執行緒睡眠等待
+   * 傳輸完成 Callback，不佔用 CPU。
    */
-  int ret = spi_read_dt(&pCtx->spi, &rx);
-
-  if (ret < 0) {
-    LOG_ERR("SPI RX failed: %d", ret);
-    return kUWB_bus_Status_FAILED;
-  }
-
-  return kUWB_bus_Status_OK;
+  return uwb_bus_spi_transceive(pCtx, NULL, &rx);
 }
 
 UWBStatus_t uwb_uwbs_tml_data_tx(uwb_uwbs_tml_ctx_t* pCtx, uint8_t* pBuf,
                                  size_t bufLen) {
   uwb_bus_status_t bus_status;
   UWBStatus_t status = kUWBSTATUS_FAILED;
+  uint32_t startCycles;
+  uint8_t retryCount;
 
   if (pCtx == NULL) {
     LOG_E("uwbs tml context is NULL");
@@ -186,6 +320,23 @@ UWBStatus_t uwb_uwbs_tml_data_tx(uwb_uwbs_tml_ctx_t* pCtx, uint8_t* pBuf,
     status = kUWBSTATUS_INVALID_PARAMETER;
     return status;
   }
+
+  startCycles = phOsalUwb_GetCycles();
+  if (pCtx->mode == kUWB_UWBS_TML_MODE_UCI) {
+    /* Wait for the UWBS to be ready instead of a fixed pre-write delay.
+     * Done before taking mSyncMutex so that a pending read can drain the
+     * UWBS (and release its IRQ line) in the meantime. A UWBS that stays
+     * busy would drop a command clocked in now, so the write fails. */
+    retryCount = 0;
+    while (uwb_uwbs_tml_wait_tx_ready(pCtx) != kUWB_bus_Status_OK) {
+      if (++retryCount > MAX_RETRY_COUNT) {
+        LOG_E("uwb_uwbs_tml_data_tx : UWBS not ready");
+        uwb_uwbs_tml_update_tx_stats(startCycles, false);
+        return kUWBSTATUS_FAILED;
+      }
+      LOG_W("uwb_uwbs_tml_data_tx : UWBS not ready, retry %d", retryCount);
+    }
+  }
   phOsalUwb_LockMutex(pCtx->mSyncMutex);
 
   if (pCtx->mode == kUWB_UWBS_TML_MODE_HBCI) {
@@ -196,32 +347,19 @@ UWBStatus_t uwb_uwbs_tml_data_tx(uwb_uwbs_tml_ctx_t* pCtx, uint8_t* pBuf,
       goto end;
     }
   } else if (pCtx->mode == kUWB_UWBS_TML_MODE_UCI) {
-    /*pre write delay to allow the device to recover from the last batch of data
-     */
-    k_busy_wait(2000);
-    LOG_TX("TML UCI TX Header", pBuf, UCI_HDR_LEN);
-    bus_status = uwb_bus_data_tx(&pCtx->busCtx, pBuf, UCI_HDR_LEN);
+    bus_status = uwb_bus_data_tx_sg(
+        &pCtx->busCtx, pBuf, UCI_HDR_LEN,
+        (bufLen > UCI_HDR_LEN) ? &pBuf[UCI_HDR_LEN] : NULL,
+        (bufLen > UCI_HDR_LEN) ? (size_t)(bufLen - UCI_HDR_LEN) : 0);
+    uwb_uwbs_tml_mark_xfer_end(pCtx);
+    uwb_uwbs_tml_update_tx_stats(startCycles,
+                                 bus_status == kUWB_bus_Status_OK);
     if (bus_status == kUWB_bus_Status_FAILED) {
-      LOG_E("uwb_uwbs_tml_data_tx writing UCI header failed");
+      LOG_E("uwb_uwbs_tml_data_tx writing UCI command failed");
+      pCtx->noOfBytesWritten = -1;
       goto end;
     }
-
-    uwb_port_DelayinMicroSec(80);
-    pCtx->noOfBytesWritten = (uint16_t)(UCI_HDR_LEN);
-
-    /* Send payload */
-    if (bufLen > UCI_HDR_LEN) {
-      LOG_TX("TML UCI TX Payload", &pBuf[UCI_HDR_LEN], (size_t)(bufLen - UCI_HDR_LEN));
-      bus_status = uwb_bus_data_tx(&pCtx->busCtx, &pBuf[UCI_HDR_LEN],
-                                   (size_t)(bufLen - UCI_HDR_LEN));
-      if (bus_status == kUWB_bus_Status_FAILED) {
-        LOG_E("uwb_uwbs_tml_data_tx writing UCI command failed");
-        pCtx->noOfBytesWritten = -1;
-        goto end;
-      } else {
-        pCtx->noOfBytesWritten = bufLen;
-      }
-    }
+    pCtx->noOfBytesWritten = bufLen;
   } else {
     LOG_E("uwb_uwbs_tml_data_tx : tml mode not supported");
     goto end;
@@ -388,6 +526,7 @@ start:
     }
     status = kUWBSTATUS_SUCCESS;
   end:
+    uwb_uwbs_tml_mark_xfer_end(pCtx);
     if ((uwb_bus_io_val_set(&pCtx->busCtx, kUWBS_IO_O_HELIOS_SYNC,
                             kUWBS_IO_State_Low)) == kUWB_bus_Status_FAILED) {
       LOG_E("uwb_uwbs_tml_data_rx : uwb_bus_io_val_set failed");
@@ -427,6 +566,52 @@ UWBStatus_t uwb_uwbs_tml_data_trx(uwb_uwbs_tml_ctx_t* pCtx, uint8_t* pTxBuf,
   return status;
 }
 
+UWBStatus_t uwb_uwbs_tml_hbci_tx_start(uwb_uwbs_tml_ctx_t* pCtx,
+                                       const uint8_t* pData, size_t dataLen,
+                                       uint8_t* pTail, size_t tailLen) {
+  if (pCtx == NULL) {
+    LOG_E("uwbs tml context is NULL");
+    return kUWBSTATUS_INVALID_PARAMETER;
+  }
+  if (pCtx->mode != kUWB_UWBS_TML_MODE_HBCI) {
+    LOG_E("uwb_uwbs_tml_hbci_tx_start : tml mode not supported");
+    return kUWBSTATUS_FAILED;
+  }
+
+  /* mSyncMutex 保持到 uwb_uwbs_tml_hbci_tx_wait() 才釋放 */
+  phOsalUwb_LockMutex(pCtx->mSyncMutex);
+  if (uwb_bus_data_tx_sg_start(&pCtx->busCtx, (uint8_t*)pData, dataLen, pTail,
+                               tailLen) != kUWB_bus_Status_OK) {
+    LOG_E("uwb_uwbs_tml_hbci_tx_start writing HBCI data failed");
+    phOsalUwb_UnlockMutex(pCtx->mSyncMutex);
+    return kUWBSTATUS_FAILED;
+  }
+  return kUWBSTATUS_SUCCESS;
+}
+
+UWBStatus_t uwb_uwbs_tml_hbci_tx_wait(uwb_uwbs_tml_ctx_t* pCtx) {
+  UWBStatus_t status = kUWBSTATUS_SUCCESS;
+
+  if (uwb_bus_spi_transceive_wait(&pCtx->busCtx) != kUWB_bus_Status_OK) {
+    LOG_E("uwb_uwbs_tml_hbci_tx_wait writing HBCI data failed");
+    status = kUWBSTATUS_FAILED;
+  }
+  phOsalUwb_UnlockMutex(pCtx->mSyncMutex);
+  return status;
+}
+
+UWBStatus_t uwb_uwbs_tml_hbci_rx(uwb_uwbs_tml_ctx_t* pCtx, uint8_t* pRxBuf,
+                                 size_t* pRxBufLen) {
+  UWBStatus_t status = uwb_uwbs_tml_data_rx(pCtx, pRxBuf, pRxBufLen);
+
+  if (status != kUWBSTATUS_SUCCESS) {
+    LOG_E("uwb_uwbs_tml_hbci_rx read data failed");
+  }
+  /* 與 uwb_uwbs_tml_data_trx() 相同的 HBCI 交易間隔 */
+  uwb_port_DelayinMicroSec(50);
+  return status;
+}
+
 UWBStatus_t uwb_uwbs_tml_data_trx_with_Len(uwb_uwbs_tml_ctx_t* pCtx,
                                            uint8_t* pTxBuf, size_t txBufLen,
                                            uint8_t* pRxBuf, size_t rxBufLen) {
@@ -0,0 +1,248 @@
+/*
+ * UCI TX/RX 二進位 trace ring，見 phNxpUciHal_Trace.h。
+ *
+ * 每個 slot 帶一個 commit 序號：寫入端先用 atomic_inc 搶到序號，把 slot
+ * 標成 0 (寫入中)，填完資料後再寫入 seq + 1。讀取端在複製前後各讀一次
+ * 序號，兩次都等於 seq + 1 才算讀到完整的紀錄，所以寫入端完全不需要 lock，
+ * 被覆蓋或讀到一半被改寫的紀錄只會被略過。
+ */
+#include "phNxpUciHal_Trace.h"
+
+#if defined(CONFIG_UWB_TRACE)
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#define PH_NXPUCIHAL_TRACE_MASK (CONFIG_UWB_TRACE_RECORDS - 1U)
+#define PH_NXPUCIHAL_TRACE_STACK_SIZE 1024
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_UWB_TRACE_RECORDS),
+             "CONFIG_UWB_TRACE_RECORDS must be a power of two");
+
+typedef struct phNxpUciHal_TraceSlot {
+  atomic_t commit; /* 0: 寫入中/空，否則為 dwSeq + 1 */
+  phNxpUciHal_TraceRec_t rec;
+} phNxpUciHal_TraceSlot_t;
+
+static phNxpUciHal_TraceSlot_t gTraceRing[CONFIG_UWB_TRACE_RECORDS];
+static atomic_t gTraceHead;
+static atomic_t gTraceBase;
+
+/* drain thread 狀態；只有 shell thread 與 drain thread 會碰 */
+static atomic_ptr_t gTraceStreamShell;
+static uint32_t gTraceStreamCursor;
+static uint32_t gTraceStreamed;
+static uint32_t gTraceStreamLost;
+static K_SEM_DEFINE(gTraceStreamSem, 0, 1);
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceWrite
+**
+** Description      Appends one UCI packet to the trace ring. Lock-free and
+**                  safe from any thread; the oldest record is overwritten
+**                  when the ring is full.
+**
+** Returns          None
+**
+*******************************************************************************/
+void phNxpUciHal_TraceWrite(uint8_t bDir, const char* pTag,
+                            const uint8_t* pData, uint16_t wLength) {
+  uint32_t dwSeq = (uint32_t)atomic_inc(&gTraceHead);
+  phNxpUciHal_TraceSlot_t* pSlot =
+      &gTraceRing[dwSeq & PH_NXPUCIHAL_TRACE_MASK];
+
+  atomic_set(&pSlot->commit, 0);
+  pSlot->rec.dwSeq = dwSeq;
+  pSlot->rec.dwCycles = k_cycle_get_32();
+  pSlot->rec.pTag = pTag;
+  pSlot->rec.wLength = wLength;
+  pSlot->rec.bDir = bDir;
+  if (pData != NULL) {
+    memcpy(pSlot->rec.aData, pData, MIN(wLength, CONFIG_UWB_TRACE_BYTES));
+  }
+  atomic_set(&pSlot->commit, (atomic_val_t)(dwSeq + 1U));
+}
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceHead
+**
+** Description      Returns the sequence number the next record will get.
+**
+** Returns          Number of records written since boot
+**
+*******************************************************************************/
+uint32_t phNxpUciHal_TraceHead(void) {
+  return (uint32_t)atomic_get(&gTraceHead);
+}
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceFirst
+**
+** Description      Returns the sequence number of the oldest record still
+**                  held by the ring and not cleared by phNxpUciHal_TraceClear.
+**
+** Returns          Oldest readable sequence number
+**
+*******************************************************************************/
+uint32_t phNxpUciHal_TraceFirst(void) {
+  uint32_t dwHead = phNxpUciHal_TraceHead();
+  uint32_t dwBase = (uint32_t)atomic_get(&gTraceBase);
+
+  if ((dwHead - dwBase) > CONFIG_UWB_TRACE_RECORDS) {
+    return dwHead - CONFIG_UWB_TRACE_RECORDS;
+  }
+  return dwBase;
+}
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceClear
+**
+** Description      Hides every record written so far from later dumps.
+**
+** Returns          None
+**
+*******************************************************************************/
+void phNxpUciHal_TraceClear(void) {
+  atomic_set(&gTraceBase, atomic_get(&gTraceHead));
+}
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceRead
+**
+** Description      Copies record dwSeq out of the ring.
+**
+** Returns          true if the record was read, false if it has not been
+**                  written yet, was overwritten or changed while copying
+**
+*******************************************************************************/
+bool phNxpUciHal_TraceRead(uint32_t dwSeq, phNxpUciHal_TraceRec_t* pRec) {
+  const phNxpUciHal_TraceSlot_t* pSlot =
+      &gTraceRing[dwSeq & PH_NXPUCIHAL_TRACE_MASK];
+  atomic_val_t commit = (atomic_val_t)(dwSeq + 1U);
+
+  if (atomic_get(&pSlot->commit) != commit) {
+    return false;
+  }
+  *pRec = pSlot->rec;
+  return atomic_get(&pSlot->commit) == commit;
+}
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TracePrint
+**
+** Description      Formats one record as a single hexdump line on sh.
+**
+** Returns          None
+**
+*******************************************************************************/
+void phNxpUciHal_TracePrint(const struct shell* sh,
+                            const phNxpUciHal_TraceRec_t* pRec) {
+  char acHex[(CONFIG_UWB_TRACE_BYTES * 3) + 1];
+  uint16_t wShown = MIN(pRec->wLength, CONFIG_UWB_TRACE_BYTES);
+  uint64_t qwUs = k_cyc_to_us_floor64(pRec->dwCycles);
+  size_t pos = 0;
+
+  for (uint16_t i = 0; i < wShown; i++) {
+    pos += snprintk(&acHex[pos], sizeof(acHex) - pos, "%02X ",
+                    pRec->aData[i]);
+  }
+  acHex[pos] = '\0';
+  shell_print(sh, "#%u %u.%06u %s %s[%u] %s%s", pRec->dwSeq,
+              (uint32_t)(qwUs / 1000000U), (uint32_t)(qwUs % 1000000U),
+              (pRec->bDir == PH_NXPUCIHAL_TRACE_TX) ? "TX" : "RX",
+              (pRec->pTag != NULL) ? pRec->pTag : "", pRec->wLength, acHex,
+              (wShown < pRec->wLength) ? "..." : "");
+}
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceStream
+**
+** Description      Starts streaming new records to sh from the drain thread,
+**                  or stops streaming when sh is NULL.
+**
+** Returns          None
+**
+*******************************************************************************/
+void phNxpUciHal_TraceStream(const struct shell* sh) {
+  atomic_ptr_set(&gTraceStreamShell, (void*)sh);
+  if (sh != NULL) {
+    k_sem_give(&gTraceStreamSem);
+  }
+}
+
+/*******************************************************************************
+**
+** Function         phNxpUciHal_TraceGetStats
+**
+** Description      Returns the trace ring counters.
+**
+** Returns          None
+**
+*******************************************************************************/
+void phNxpUciHal_TraceGetStats(phNxpUciHal_TraceStats_t* pStats) {
+  pStats->dwWritten = phNxpUciHal_TraceHead();
+  pStats->dwStreamed = gTraceStreamed;
+  pStats->dwStreamLost = gTraceStreamLost;
+  pStats->wRecords = CONFIG_UWB_TRACE_RECORDS;
+  pStats->wBytes = CONFIG_UWB_TRACE_BYTES;
+  pStats->bStreaming = (atomic_ptr_get(&gTraceStreamShell) != NULL);
+}
+
+/*
+ * Drain thread：以最低的 application 優先權跑，串流開啟時每
+ * CONFIG_UWB_TRACE_DRAIN_PERIOD_MS 把新紀錄格式化輸出到 shell；
+ * 關閉時停在 semaphore 上，不佔 CPU。
+ */
+static void phNxpUciHal_TraceDrainThread(void* p1, void* p2, void* p3) {
+  ARG_UNUSED(p1);
+  ARG_UNUSED(p2);
+  ARG_UNUSED(p3);
+
+  for (;;) {
+    const struct shell* sh = atomic_ptr_get(&gTraceStreamShell);
+    phNxpUciHal_TraceRec_t rec;
+    uint32_t dwHead;
+
+    if (sh == NULL) {
+      k_sem_take(&gTraceStreamSem, K_FOREVER);
+      gTraceStreamCursor = phNxpUciHal_TraceHead();
+      continue;
+    }
+
+    dwHead = phNxpUciHal_TraceHead();
+    if ((dwHead - gTraceStreamCursor) > CONFIG_UWB_TRACE_RECORDS) {
+      gTraceStreamLost +=
+          dwHead - CONFIG_UWB_TRACE_RECORDS - gTraceStreamCursor;
+      gTraceStreamCursor = dwHead - CONFIG_UWB_TRACE_RECORDS;
+    }
+    while (gTraceStreamCursor != dwHead) {
+      if (phNxpUciHal_TraceRead(gTraceStreamCursor, &rec)) {
+        phNxpUciHal_TracePrint(sh, &rec);
+        gTraceStreamed++;
+      } else if ((phNxpUciHal_TraceHead() - gTraceStreamCursor) <=
+                 CONFIG_UWB_TRACE_RECORDS) {
+        /* 寫入端還沒 commit，下一輪再讀 */
+        break;
+      } else {
+        gTraceStreamLost++;
+      }
+      gTraceStreamCursor++;
+    }
+    k_sleep(K_MSEC(CONFIG_UWB_TRACE_DRAIN_PERIOD_MS));
+  }
+}
+
+K_THREAD_DEFINE(uwb_trace_drain, PH_NXPUCIHAL_TRACE_STACK_SIZE,
+                phNxpUciHal_TraceDrainThread, NULL, NULL, NULL,
+                K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
+
+#endif /* CONFIG_UWB_TRACE */
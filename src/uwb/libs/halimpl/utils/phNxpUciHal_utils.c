@@ -79,8 +79,9 @@ int phNxpUciHal_listDestroy(struct listHead* pList) {
 int phNxpUciHal_listAdd(struct listHead* pList, void* pData) {
   list_node_wrapper_t* pWrapper;
 
-  /* 使用 k_malloc 分配節點記憶體 */
-  pWrapper = (list_node_wrapper_t*)k_malloc(sizeof(list_node_wrapper_t));
+  /* 使用 OSAL 記憶體池分配節點記憶體 */
+  pWrapper =
+      (list_node_wrapper_t*)phOsalUwb_GetMemory(sizeof(list_node_wrapper_t));
   if (pWrapper == NULL) {
     NXPLOG_UCIX_E("Failed to malloc list node");
     return 0;
@@ -122,7 +123,7 @@ int phNxpUciHal_listRemove(struct listHead* pList, void* pData) {
     if (pWrapper->pData == pData) {
       /* 找到節點，移除並釋放 */
       sys_dlist_remove(&pWrapper->node);
-      k_free(pWrapper);
+      phOsalUwb_FreeMemory(pWrapper);
       result = 1;
       break; /* 找到後即可退出 */
     }
@@ -169,7 +170,7 @@ int phNxpUciHal_listGetAndRemoveNext(struct listHead* pList, void** ppData) {
     }
 
     /* 釋放節點記憶體 */
-    k_free(pWrapper);
+    phOsalUwb_FreeMemory(pWrapper);
     result = 1;
   }
 
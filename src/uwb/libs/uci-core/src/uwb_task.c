@@ -28,7 +28,17 @@
 
 phUwbtask_Control_t* gp_uwbtask_ctrl;
 
-static uint32_t TimerHandle;
+/*
+ * Command response timer. The deadline is folded into the message queue wait
+ * of uwb_task, so no OSAL timer is created per command and the task sleeps
+ * until either a message arrives or the deadline passes.
+ */
+static struct k_spinlock quickTimerLock;
+static int64_t quickTimerDeadline;
+static bool quickTimerArmed;
+
+static k_tid_t uwbTaskThread;
+static phUwbtask_Stats_t uwbTaskStats;
 
 /*******************************************************************************
 **
@@ -44,27 +54,23 @@ static uint32_t TimerHandle;
 **
 *******************************************************************************/
 
-static void quick_timer_callback(uint32_t timerid, void* pContext) {
-    static uint16_t quickEvent = UWB_TTYPE_UCI_WAIT_RSP;
-    (void)phOsalUwb_Timer_Stop(timerid);
-    phUwb_OSAL_send_msg(UWB_TASK, TIMER_1_EVT_MASK, &quickEvent);
-    (void)phOsalUwb_Timer_Delete(timerid);
-}
-
 void uwb_start_quick_timer(uint32_t timeout) {
+    phLibUwb_Message_t msg;
+    k_spinlock_key_t key;
+
     UCI_TRACE_D("uwb_start_quick_timer enter: timeout: %d", timeout);
-    // [TODO] Timer creation to be optimized
-    TimerHandle = phOsalUwb_Timer_Create(FALSE);
-
-    if (TimerHandle != PH_OSALUWB_TIMER_ID_INVALID) {
-        if (phOsalUwb_Timer_Start(TimerHandle,
-                                  (uint32_t)((GKI_SECS_TO_TICKS(timeout) /
-                                              QUICK_TIMER_TICKS_PER_SEC)),
-                                  quick_timer_callback, NULL) != 0) {
-            // BT_ERROR_TRACE_0(TRACE_LAYER_GKI, "Timer Start failed");
-        }
-    } else {
-        UCI_TRACE_E("%s : Invalid Timer ID", __FUNCTION__);
+
+    key = k_spin_lock(&quickTimerLock);
+    quickTimerDeadline =
+        k_uptime_get() +
+        (int64_t)(GKI_SECS_TO_TICKS(timeout) / QUICK_TIMER_TICKS_PER_SEC);
+    quickTimerArmed = TRUE;
+    k_spin_unlock(&quickTimerLock, key);
+
+    /* uwb_task 可能正以較晚的期限 (或無限期) 等待，送一個空訊息讓它重算 */
+    if ((gp_uwbtask_ctrl != NULL) && (k_current_get() != uwbTaskThread)) {
+        phOsalUwb_SetMemory(&msg, 0, sizeof(msg));
+        (void)phOsalUwb_msgsnd(gp_uwbtask_ctrl->pMsgQHandle, &msg, NO_DELAY);
     }
 }
 
@@ -78,10 +84,71 @@ void uwb_start_quick_timer(uint32_t timeout) {
 **
 *******************************************************************************/
 void uwb_stop_quick_timer() {
+    k_spinlock_key_t key;
+
     UCI_TRACE_D("uwb_stop_quick_timer: enter");
 
-    (void)phOsalUwb_Timer_Stop(TimerHandle);
-    (void)phOsalUwb_Timer_Delete(TimerHandle);
+    key = k_spin_lock(&quickTimerLock);
+    quickTimerArmed = FALSE;
+    k_spin_unlock(&quickTimerLock, key);
+}
+
+/*******************************************************************************
+**
+** Function         uwb_quick_timer_wait
+**
+** Description      Computes how long uwb_task may block on its message queue
+**                  and reports an expired quick timer.
+**
+** Returns          wait time in ms (MAX_DELAY when no timer is armed), or
+**                  NO_DELAY with *pExpired set when the deadline has passed
+**
+*******************************************************************************/
+static unsigned long uwb_quick_timer_wait(bool* pExpired) {
+    unsigned long waitMs = MAX_DELAY;
+    k_spinlock_key_t key = k_spin_lock(&quickTimerLock);
+
+    *pExpired = FALSE;
+    if (quickTimerArmed) {
+        int64_t remain = quickTimerDeadline - k_uptime_get();
+
+        if (remain <= 0) {
+            quickTimerArmed = FALSE;
+            *pExpired = TRUE;
+            waitMs = NO_DELAY;
+        } else {
+            waitMs = (unsigned long)remain;
+        }
+    }
+    k_spin_unlock(&quickTimerLock, key);
+    return waitMs;
+}
+
+/*******************************************************************************
+**
+** Function         uwb_task_get_stats
+**
+** Description      Copies the uwb_task activity counters
+**
+** Returns          void
+**
+*******************************************************************************/
+void uwb_task_get_stats(phUwbtask_Stats_t* pStats) {
+    *pStats = uwbTaskStats;
+    pStats->pThread = uwbTaskThread;
+}
+
+/*******************************************************************************
+**
+** Function         uwb_task_reset_stats
+**
+** Description      Clears the uwb_task activity counters
+**
+** Returns          void
+**
+*******************************************************************************/
+void uwb_task_reset_stats(void) {
+    phOsalUwb_SetMemory(&uwbTaskStats, 0, sizeof(uwbTaskStats));
 }
 
 /*******************************************************************************
@@ -144,6 +211,8 @@ void uwb_task_shutdown_uwbc(void) {
 OSAL_TASK_RETURN_TYPE uwb_task(void* p1, void* p2, void* p3) {
     uint32_t event;
     bool free_buf = FALSE;
+    bool expired;
+    unsigned long waitMs;
     UWB_HDR* p_msg = NULL;
     phLibUwb_Message_t msg;
     gp_uwbtask_ctrl = (phUwbtask_Control_t*)p1;
@@ -155,14 +224,27 @@ OSAL_TASK_RETURN_TYPE uwb_task(void* p1, void* p2, void* p3) {
     /* Initialize the message */
     phOsalUwb_SetMemory(&msg, 0, sizeof(msg));
 
+    uwbTaskThread = k_current_get();
+    uwb_stop_quick_timer();
+
     /* main loop */
     UCI_TRACE_D("UWB_TASK started.");
 
     while (1) {
-        if (phOsalUwb_msgrcv(gp_uwbtask_ctrl->pMsgQHandle, &msg, NO_DELAY) ==
+        waitMs = uwb_quick_timer_wait(&expired);
+        if (expired) {
+            uwbTaskStats.dwTimerExpiries++;
+            uwb_process_quick_timer_evt(UWB_TTYPE_UCI_WAIT_RSP);
+            continue;
+        }
+        /* 沒有訊息也沒有到期的 timer 時就睡在 Queue 上 */
+        if (phOsalUwb_msgrcv(gp_uwbtask_ctrl->pMsgQHandle, &msg, waitMs) ==
             UWBSTATUS_FAILED) {
+            uwbTaskStats.dwWakeups++;
             continue;
         }
+        uwbTaskStats.dwWakeups++;
+        uwbTaskStats.dwMessages++;
         event = msg.eMsgType;
         /* Handle UWB_TASK_EVT_TRANSPORT_READY from UWB HAL */
         if (event & UWB_TASK_EVT_TRANSPORT_READY) {
@@ -216,8 +298,6 @@ OSAL_TASK_RETURN_TYPE uwb_task(void* p1, void* p2, void* p3) {
         if (event & UWA_MBOX_EVT_MASK) {
             uwa_sys_event(&(((tUWA_DM_API_ENABLE*)msg.pMsgData)->hdr));
         }
-
-        k_usleep(100);
     }
 
     UCI_TRACE_D("uwb_task terminated");
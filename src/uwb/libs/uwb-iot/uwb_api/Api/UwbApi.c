@@ -35,7 +35,18 @@
 #include "uwb_int.h"
 
 #if UWBIOT_UWBD_SR1XXT
+/* 只 include 選定的 image，另一份不會被編進 flash (各約 200 KiB) */
+#if defined(CONFIG_UWB_FW_IMAGE_FACTORY)
+#include <Factory_Firmware.h>
+#define UWBAPI_FW_IMAGE heliosEncryptedFactoryFwImage
+#define UWBAPI_FW_IMAGE_LEN heliosEncryptedFactoryFwImageLen
+#define UWBAPI_FW_MODE FACTORY_FW
+#else
 #include <Mainline_Firmware.h>
+#define UWBAPI_FW_IMAGE heliosEncryptedMainlineFwImage
+#define UWBAPI_FW_IMAGE_LEN heliosEncryptedMainlineFwImageLen
+#define UWBAPI_FW_MODE MAINLINE_FW
+#endif
 
 #include "uwb_fwdl_provider.h"
 #endif  // UWBIOT_UWBD_SR1XXT
@@ -43,12 +54,6 @@
 /* Logging Level used by UWBAPI module */
 LOG_MODULE_REGISTER(UWBAPI);
 
-#if UWBIOT_UWBD_SR1XXT
-#include <Mainline_Firmware.h>
-
-#include "uwb_fwdl_provider.h"
-#endif  // UWBIOT_UWBD_SR1XXT
-
 #define MAX_SUPPORTED_TDOA_REPORT_FREQ 22
 #define MIN_TRNG_SIZE 0x01
 #define MAX_TRNG_SIZE 0x10
@@ -189,9 +194,9 @@ EXTERNC tUWBAPI_STATUS UwbApi_SwitchToMCTTMode(phUwbappContext_t* pAppCtx) {
 EXTERNC tUWBAPI_STATUS UwbApi_Init(tUwbApi_AppCallback* pCallback) {
 #if UWBIOT_UWBD_SR1XXT
   phUwbFWImageContext_t fwImageCtx;
-  fwImageCtx.fwImage = (uint8_t*)heliosEncryptedMainlineFwImage;
-  fwImageCtx.fwImgSize = heliosEncryptedMainlineFwImageLen;
-  fwImageCtx.fwMode = MAINLINE_FW;
+  fwImageCtx.fwImage = (uint8_t*)UWBAPI_FW_IMAGE;
+  fwImageCtx.fwImgSize = UWBAPI_FW_IMAGE_LEN;
+  fwImageCtx.fwMode = UWBAPI_FW_MODE;
   if (uwb_fwdl_getFwImage(&fwImageCtx) != kUWBSTATUS_SUCCESS) {
     NXPLOG_UWBAPI_E("uwb_fwdl_getFwImage failed");
     return UWBAPI_STATUS_FAILED;
@@ -255,9 +260,9 @@ EXTERNC tUWBAPI_STATUS UwbApi_ShutDown() {
 EXTERNC tUWBAPI_STATUS UwbApi_RecoverUWBS() {
 #if UWBIOT_UWBD_SR1XXT
   phUwbFWImageContext_t fwImageCtx;
-  fwImageCtx.fwImage = (uint8_t*)heliosEncryptedMainlineFwImage;
-  fwImageCtx.fwImgSize = heliosEncryptedMainlineFwImageLen;
-  fwImageCtx.fwMode = MAINLINE_FW;
+  fwImageCtx.fwImage = (uint8_t*)UWBAPI_FW_IMAGE;
+  fwImageCtx.fwImgSize = UWBAPI_FW_IMAGE_LEN;
+  fwImageCtx.fwMode = UWBAPI_FW_MODE;
   if (uwb_fwdl_getFwImage(&fwImageCtx) != kUWBSTATUS_SUCCESS) {
     NXPLOG_UWBAPI_E("uwb_fwdl_getFwImage failed");
     return UWBAPI_STATUS_FAILED;
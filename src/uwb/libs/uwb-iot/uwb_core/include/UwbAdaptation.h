@@ -127,6 +127,14 @@
 #define UWB_TASK 3
 #endif
 
+/* uwb_task activity counters, shown by "uwb_stats cpu" */
+typedef struct phUwbtask_Stats {
+  uint32_t dwWakeups;       /* returns from the message queue wait */
+  uint32_t dwMessages;      /* messages processed */
+  uint32_t dwTimerExpiries; /* command response timeouts */
+  void* pThread;            /* uwb_task thread, NULL before UwbApi_Init */
+} phUwbtask_Stats_t;
+
 void Initialize();
 tUCI_STATUS UwbDeviceInit(bool recovery);
 void Finalize();
@@ -135,5 +143,7 @@ void HalRegisterAppCallback(phHalAppDataCb *recvDataCb);
 bool isCmdRespPending();
 void Hal_setOperationMode(Uwb_operation_mode_t state);
 void phUwb_OSAL_send_msg(uint8_t task_id, uint16_t mbox, void *pmsg);
+void uwb_task_get_stats(phUwbtask_Stats_t *pStats);
+void uwb_task_reset_stats(void);
 
 #endif
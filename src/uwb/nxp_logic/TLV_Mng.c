@@ -87,23 +87,47 @@ bool tlvMngInit(void) {
   return TRUE;
 }
 
+/* tlvMngTask 的排隊延遲與批次統計 */
+static phOsalUwb_DispatchStats_t mTlvDispatchStats;
+
 void tlvMngTask(void* p1, void* p2, void* p3) {
   printk("%s task start", __func__);
 
   while (1) {
     uint8_t data[50] = {0};
     phLibUwb_Message_t evt = {0};
+    uint32_t count = 0;
+
     if (phOsalUwb_msgrcv(tlvMngQueue, &evt, MAX_DELAY) == UWBSTATUS_FAILED) {
       k_yield();
+      continue;
+    }
+    /* 佇列中已有的 TLV 一次處理完，佇列空了才回去睡 */
+    do {
+      phOsalUwb_DispatchStatsMessage(&mTlvDispatchStats, &evt);
+      phOsalUwb_MemCopy(data, (uint8_t*)evt.pMsgData, evt.Size);
+      LOG_AU8_D(data, evt.Size);
+      handleTLV((uint8_t)evt.eMsgType, data);
+      count++;
+    } while ((count < CONFIG_UWB_DISPATCH_BUDGET) &&
+             (phOsalUwb_msgrcv(tlvMngQueue, &evt, NO_DELAY) ==
+              UWBSTATUS_SUCCESS));
+    phOsalUwb_DispatchStatsBatch(&mTlvDispatchStats, count);
+
+    if (count == CONFIG_UWB_DISPATCH_BUDGET) {
+      k_yield();
     }
-    phOsalUwb_MemCopy(data, (uint8_t*)evt.pMsgData, evt.Size);
-    LOG_AU8_D(data, evt.Size);
-    handleTLV((uint8_t)evt.eMsgType, data);
-
-    k_usleep(100);
   }
 }
 
+void tlvMngGetDispatchStats(phOsalUwb_DispatchStats_t* pStats) {
+  *pStats = mTlvDispatchStats;
+}
+
+void tlvMngResetDispatchStats(void) {
+  phOsalUwb_DispatchStatsReset(&mTlvDispatchStats);
+}
+
 /*
  * Here is the entry point for the application
  * handleTLV() is managing the state machine to handle
@@ -17,6 +17,7 @@
 #include <stdint.h>
 
 #include "demo_device_config_i.h"
+#include "phOsalUwb_Queue.h"
 // #include "phNxpLogApis_App.h"
 typedef enum { notCreated, notStarted, Started } UwbHandlerState;
 
@@ -79,6 +80,8 @@ typedef enum {
 } UWB_Hif_t;
 
 bool tlvMngInit(void);
+void tlvMngGetDispatchStats(phOsalUwb_DispatchStats_t* pStats);
+void tlvMngResetDispatchStats(void);
 bool tlvBuilderInit(void);
 bool tlvSendRaw(uint8_t deviceId, uint8_t* buf, uint16_t size);
 void tlvSendDoneCb(void);
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""Synthesize EM4095 tick_buffer captures for the em4095 decode tests.
+
+These fixtures are NOT recorded from hardware. They model what
+demod_gpio_handler stores with toggle capture: entry 0 is the time from
+opening the window to the first edge, every following entry is the
+TIMER3 tick count (16 MHz) between two DEMOD_OUT edges.
+
+  HID Prox: FSK, '0' = fc/8 (1024 ticks), '1' = fc/10 (1280 ticks),
+            50 carrier cycles (6400 ticks) per FSK bit, 96-bit frame
+            (0x1D header + 44 Manchester bits).
+  EM4100:   Manchester at RF/64, 4096 ticks per half bit, 64-bit frame.
+
+"noisy" adds edge jitter and contact-bounce glitch pairs; "partial" is
+a card leaving the field before a full frame was received.
+
+Run from this directory to regenerate the *.inc files (seeded, so the
+output is stable).
+"""
+
+import random
+
+FSK_BIT_TICKS = 6400
+FSK_0_TICKS = 1024
+FSK_1_TICKS = 1280
+EM4100_HALF_TICKS = 4096
+TICK_BUFFER_SIZE = 2400
+
+
+def hid26_real44(facility, card):
+    """44 bits in the order em4095_hid_decode() stores real_44bits_buffer."""
+    bits = [0] * 44
+    for i in range(16):
+        bits[1 + i] = (card >> i) & 1
+    for i in range(8):
+        bits[17 + i] = (facility >> i) & 1
+    bits[0] = 1 - (sum(bits[1:13]) & 1)  # odd parity over 0..12
+    bits[25] = sum(bits[13:25]) & 1  # even parity over 13..25
+    bits[26] = 1  # 0x0801 format/sentinel bits
+    bits[37] = 1
+    return bits
+
+
+def hid_frame(real44):
+    """96 FSK bits: header 0x1D, then Manchester 0 -> 01, 1 -> 10."""
+    frame = [0, 0, 0, 1, 1, 1, 0, 1]
+    for i in range(43, -1, -1):
+        frame += [1, 0] if real44[i] else [0, 1]
+    return frame
+
+
+def hid_halves(frame, start_bit, periods, rng, jitter):
+    """Half periods of the FSK subcarrier, starting start_bit into frame."""
+    halves = []
+    t = start_bit * FSK_BIT_TICKS
+    for _ in range(periods):
+        bit = frame[(t // FSK_BIT_TICKS) % len(frame)]
+        period = FSK_1_TICKS if bit else FSK_0_TICKS
+        high = period // 2 + rng.randint(-jitter, jitter)
+        halves += [high, period - high]
+        t += period
+    return halves
+
+
+def em4100_frame(code):
+    frame = [1] * 9
+    column = [0] * 4
+    for row in range(10):
+        nibble = (code >> (4 * (9 - row))) & 0xF
+        bits = [(nibble >> (3 - c)) & 1 for c in range(4)]
+        frame += bits + [sum(bits) & 1]
+        column = [c ^ b for c, b in zip(column, bits)]
+    return frame + column + [0]
+
+
+def em4100_intervals(frame, start_bit, nbits, rng, jitter):
+    """Edge intervals of the Manchester stream (one or two half bits)."""
+    levels = []
+    for i in range(start_bit, start_bit + nbits):
+        bit = frame[i % len(frame)]
+        levels += [bit, 1 - bit]
+    intervals = []
+    run = 1
+    for i in range(1, len(levels)):
+        if levels[i] == levels[i - 1]:
+            run += 1
+            continue
+        intervals.append(run * EM4100_HALF_TICKS + rng.randint(-jitter, jitter))
+        run = 1
+    return intervals
+
+
+def add_bounce(intervals, rng, every, short_max):
+    """Split an interval into two short bounce edges plus the remainder."""
+    out = []
+    for n, value in enumerate(intervals):
+        if n % every == every - 1:
+            g1 = rng.randint(20, short_max)
+            g2 = rng.randint(20, short_max)
+            out += [g1, g2, value - g1 - g2]
+        else:
+            out.append(value)
+    return out
+
+
+def write_inc(name, ticks, description):
+    assert len(ticks) <= TICK_BUFFER_SIZE
+    with open(name + ".inc", "w") as f:
+        f.write("/* SYNTHETIC capture, not recorded from hardware.\n")
+        f.write(" * Generated by gen_fixtures.py: %s */\n" % description)
+        for i in range(0, len(ticks), 12):
+            f.write(", ".join(str(v) for v in ticks[i:i + 12]) + ",\n")
+
+
+def main():
+    rng = random.Random(4095)
+
+    hid = hid_frame(hid26_real44(123, 4567))
+    write_inc("hid26_clean",
+              [3000] + hid_halves(hid, 40, 1300, rng, 8)[:TICK_BUFFER_SIZE - 1],
+              "HID 26-bit, facility 123, card 4567")
+    noisy = add_bounce(hid_halves(hid, 71, 1300, rng, 60), rng, 97, 90)
+    write_inc("hid26_noisy", [1711] + noisy[:TICK_BUFFER_SIZE - 1],
+              "HID 26-bit, facility 123, card 4567, jitter and bounce")
+    write_inc("hid26_partial", [2500] + hid_halves(hid, 10, 500, rng, 8),
+              "HID 26-bit, card leaves after 500 subcarrier periods")
+
+    em = em4100_frame(0x1A00BC614E)
+    write_inc("em4100_clean",
+              [5000] + em4100_intervals(em, 20, 140, rng, 100),
+              "EM4100 0x1A00BC614E")
+    lead = [rng.randint(200, 12000) for _ in range(16)]
+    noisy = add_bounce(em4100_intervals(em, 45, 150, rng, 300), rng, 23, 400)
+    write_inc("em4100_noisy", [800] + lead + noisy,
+              "EM4100 0x1A00BC614E, field noise, jitter and bounce")
+    write_inc("em4100_partial",
+              [4000] + em4100_intervals(em, 30, 90, rng, 100),
+              "EM4100 0x1A00BC614E, card leaves after 90 bits")
+
+
+if __name__ == "__main__":
+    main()
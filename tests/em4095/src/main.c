@@ -0,0 +1,114 @@
+/*
+ * em4095_decode.c / em4100_decoder.c 的 host 測試
+ *
+ * fixtures 下的 .inc 是 gen_fixtures.py 合成的 tick_buffer (不是實機錄下來的)，
+ * 格式和 demod_gpio_handler 存的一樣：toggle 觸發下兩個 edge 之間的
+ * TIMER3 tick 數 (16MHz)，第 0 格是開視窗到第一個 edge 的時間。
+ */
+#include <zephyr/ztest.h>
+
+#include "em4095_decode.h"
+
+static const uint16_t hid26_clean[] = {
+#include "hid26_clean.inc"
+};
+static const uint16_t hid26_noisy[] = {
+#include "hid26_noisy.inc"
+};
+static const uint16_t hid26_partial[] = {
+#include "hid26_partial.inc"
+};
+static const uint16_t em4100_clean[] = {
+#include "em4100_clean.inc"
+};
+static const uint16_t em4100_noisy[] = {
+#include "em4100_noisy.inc"
+};
+static const uint16_t em4100_partial[] = {
+#include "em4100_partial.inc"
+};
+
+#define HID26_CARD_NUMBER 4567
+#define EM4100_CODE 0x1A00BC614EULL
+
+static void assert_hid26(const uint16_t* ticks, uint16_t count) {
+  em4095_hid_card_t card;
+
+  zassert_equal(em4095_classify(ticks, count), EM4095_MOD_FSK);
+  zassert_equal(em4095_hid_decode(ticks, count, &card), EM4095_HID_OK);
+  zassert_equal(card.bits, 26);
+  zassert_equal(card.card_number, HID26_CARD_NUMBER);
+}
+
+static void assert_em4100(const uint16_t* ticks, uint16_t count) {
+  uint64_t code = 0;
+
+  zassert_equal(em4095_classify(ticks, count), EM4095_MOD_ASK);
+  zassert_true(em4100_decode_ticks(ticks, count, &code));
+  zassert_equal(code, EM4100_CODE, "code 0x%llx",
+                (unsigned long long)code);
+}
+
+ZTEST_SUITE(em4095_decode, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(em4095_decode, test_hid26_clean) {
+  assert_hid26(hid26_clean, ARRAY_SIZE(hid26_clean));
+}
+
+ZTEST(em4095_decode, test_hid26_noisy) {
+  assert_hid26(hid26_noisy, ARRAY_SIZE(hid26_noisy));
+}
+
+ZTEST(em4095_decode, test_hid26_partial) {
+  em4095_hid_card_t card;
+
+  /* 不到一個 frame 的 FSK：不分類成 FSK，硬解也解不出卡號 */
+  zassert_equal(em4095_classify(hid26_partial, ARRAY_SIZE(hid26_partial)),
+                EM4095_MOD_NONE);
+  zassert_equal(em4095_hid_decode(hid26_partial, ARRAY_SIZE(hid26_partial),
+                                  &card),
+                EM4095_HID_NO_FRAME);
+}
+
+ZTEST(em4095_decode, test_em4100_clean) {
+  assert_em4100(em4100_clean, ARRAY_SIZE(em4100_clean));
+}
+
+ZTEST(em4095_decode, test_em4100_noisy) {
+  assert_em4100(em4100_noisy, ARRAY_SIZE(em4100_noisy));
+}
+
+ZTEST(em4095_decode, test_em4100_partial) {
+  uint64_t code;
+
+  /* 有 ASK 波形但沒有完整 frame */
+  zassert_equal(em4095_classify(em4100_partial, ARRAY_SIZE(em4100_partial)),
+                EM4095_MOD_ASK);
+  zassert_false(em4100_decode_ticks(em4100_partial,
+                                    ARRAY_SIZE(em4100_partial), &code));
+}
+
+ZTEST(em4095_decode, test_no_cross_decode) {
+  em4095_hid_card_t card;
+  uint64_t code;
+
+  /* FSK 不會被 EM4100 解碼器誤認，反之亦然 */
+  zassert_false(
+      em4100_decode_ticks(hid26_clean, ARRAY_SIZE(hid26_clean), &code));
+  zassert_not_equal(
+      em4095_hid_decode(em4100_clean, ARRAY_SIZE(em4100_clean), &card),
+      EM4095_HID_OK);
+}
+
+ZTEST(em4095_decode, test_replay_does_not_modify_ticks) {
+  static uint16_t ticks[ARRAY_SIZE(hid26_clean)];
+  em4095_hid_card_t card;
+
+  /* em4095_replay() 會對同一份 tick_buffer 重複解碼 */
+  memcpy(ticks, hid26_clean, sizeof(ticks));
+  for (int n = 0; n < 3; n++) {
+    zassert_equal(em4095_hid_decode(ticks, ARRAY_SIZE(ticks), &card),
+                  EM4095_HID_OK);
+  }
+  zassert_mem_equal(ticks, hid26_clean, sizeof(ticks));
+}